@@ -0,0 +1,163 @@
+#include "Reactor.hpp"
+#include "TcpServer.hpp"
+#include "common.hpp"
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Accept rate of a TcpServer under a connection storm on loopback: a client thread connects raw sockets back to back
+// while the server accepts them. Connections stay open until all of them are accepted: 2 file descriptors each.
+// - sleep-retry: `tryAccept()`, sleeping 100 ms whenever nothing is pending (former `waitForClient()`)
+// - one/wakeup: `waitForClient()`, poll()-based, one connection per call
+// - drain: `waitForClients()`, poll()-based, the whole accept queue per call
+// Accepted endpoints are served by a single reactor thread.
+// Usage: bm-accept [Port] [Number of Connections]
+
+static constexpr long SERVER_TIMEOUT_US = 60000000L;  // 60s
+static constexpr long RETRY_BREAK_US = 100000L;       // 100ms
+
+enum AcceptMode {
+    E_SLEEP_RETRY = 0,
+    E_ONE_PER_WAKEUP,
+    E_DRAIN
+};  // enum AcceptMode
+
+struct Result {
+    const char* pName = "";
+    size_t accepted = 0UL;
+    size_t calls = 0UL;  // Accepting calls which returned at least one connection
+    int64_t elapsedUs = 0;
+};  // struct Result
+
+static void connect_clients(const uint16_t port, const size_t numberOfConnections, std::vector<int>* const pSocketFds,
+                            std::atomic<size_t>* const pFailures) {
+    struct sockaddr_in serverAddr;
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    serverAddr.sin_port = htons(port);
+
+    for (size_t i = 0; i < numberOfConnections; i++) {
+        const int socketFd = socket(AF_INET, SOCK_STREAM, 0);
+        if ((0 > socketFd) || (0 != connect(socketFd, (const struct sockaddr*)(&serverAddr), sizeof(serverAddr)))) {
+            (*pFailures)++;
+        }
+
+        if (0 <= socketFd) {
+            pSocketFds->push_back(socketFd);
+        }
+    }
+}
+
+static bool run(const AcceptMode& mode, const uint16_t& port, const size_t& numberOfConnections, const comm::EndpointConfig& config, Result& result) {
+    std::unique_ptr<comm::TcpServer> pTcpServer = comm::TcpServer::create(port, config);
+    if (!pTcpServer) {
+        LOGE("Could not create TCP Server which listens at port %u!!!\n", port);
+        return false;
+    }
+
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pClients;
+    pClients.reserve(numberOfConnections);
+    std::vector<int> clientSocketFds;
+    clientSocketFds.reserve(numberOfConnections);
+    std::atomic<size_t> failures{0UL};
+    int errorCode = 0;
+
+    const auto t0 = monotonic_now();
+    std::thread connector(connect_clients, port, numberOfConnections, &clientSocketFds, &failures);
+
+    while ((numberOfConnections > (pClients.size() + failures.load())) && (SERVER_TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+        size_t count = 0UL;
+        if (E_SLEEP_RETRY == mode) {
+            std::unique_ptr<comm::P2P_Endpoint> pClient = pTcpServer->tryAccept(errorCode, config);
+            if (pClient) {
+                pClients.push_back(std::move(pClient));
+                count = 1UL;
+            } else if (comm::TcpServer::ACCEPT_RETRY == errorCode) {
+                errorCode = 0;
+            } else if (0 == errorCode) {
+                sleep_for(RETRY_BREAK_US);
+            }
+        } else if (E_ONE_PER_WAKEUP == mode) {
+            std::unique_ptr<comm::P2P_Endpoint> pClient = pTcpServer->waitForClient(errorCode, 100L);
+            if (pClient) {
+                pClients.push_back(std::move(pClient));
+                count = 1UL;
+            }
+        } else {
+            count = pTcpServer->waitForClients(errorCode, pClients, 100L);
+        }
+
+        if (0 != errorCode) {
+            LOGE("Failed to accept connections: %d!!!\n", errorCode);
+            break;
+        }
+
+        if (0UL < count) {
+            result.calls++;
+        }
+    }
+
+    result.elapsedUs = get_elapsed_realtime_us(t0);
+    result.accepted = pClients.size();
+
+    connector.join();
+    pClients.clear();  // Server side closes first: no client port is left in TIME_WAIT
+    for (auto& socketFd : clientSocketFds) {
+        ::close(socketFd);
+    }
+
+    if (0UL < failures.load()) {
+        LOGE("%zu connections failed!!!\n", failures.load());
+    }
+
+    return (0 == errorCode) && (numberOfConnections == result.accepted);
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = (1 < argc) ? static_cast<uint16_t>(atoi(argv[1])) : 27500U;  // Below the ephemeral port range
+    const size_t numberOfConnections = (2 < argc) ? static_cast<size_t>(atol(argv[2])) : 10000UL;
+
+    struct rlimit limit;
+    if (0 == getrlimit(RLIMIT_NOFILE, &limit)) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+        if ((2UL * numberOfConnections + 64UL) > static_cast<size_t>(limit.rlim_cur)) {
+            LOGW("%zu file descriptors at most, raise the limit (e.g. `ulimit -n`)!\n", static_cast<size_t>(limit.rlim_cur));
+        }
+    }
+
+    comm::EndpointConfig config;
+    config.pReactor = comm::Reactor::create(1UL);
+
+    const char* names[] = {"sleep-retry", "one/wakeup", "drain"};
+    const AcceptMode modes[] = {E_SLEEP_RETRY, E_ONE_PER_WAKEUP, E_DRAIN};
+
+    std::vector<Result> results;
+    for (size_t i = 0; i < (sizeof(modes) / sizeof(modes[0])); i++) {
+        Result result;
+        result.pName = names[i];
+        if (run(modes[i], port++, numberOfConnections, config, result)) {
+            results.push_back(result);
+        } else {
+            LOGE("%s: %zu of %zu connections accepted!!!\n", names[i], result.accepted, numberOfConnections);
+        }
+    }
+
+    LOGI("%zu connections per row\n", numberOfConnections);
+    LOGI("%-12s | %10s | %12s | %12s\n", "Mode", "Elapsed", "Accepts/s", "Conns/call");
+    for (auto& result : results) {
+        LOGI("%-12s | %7lld ms | %12.1f | %12.1f\n", result.pName, static_cast<long long>(result.elapsedUs / 1000),
+             static_cast<double>(result.accepted) * 1000000.0 / static_cast<double>(result.elapsedUs),
+             static_cast<double>(result.accepted) / static_cast<double>(result.calls));
+    }
+
+    return 0;
+}
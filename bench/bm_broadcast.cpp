@@ -0,0 +1,158 @@
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+#include "PacketPool.hpp"
+#include "Reactor.hpp"
+#include "TcpServer.hpp"
+#include "common.hpp"
+
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Fan-out of one packet to all clients of a TcpServer, on loopback, per number of subscribers:
+// - copy: `send(Packet::create(payload))` for each client (one payload copy per client)
+// - broadcast: `comm::broadcast()` (payload shared by all clients, only headers are encoded per client)
+// Reports the time spent by the sender per broadcast & pool allocations made meanwhile (receivers of the same process
+// may add a few), then waits until every subscriber got the packet before the next round.
+// Usage: bm-broadcast [Port] [Number of Rounds]
+
+static constexpr size_t PAYLOAD_SIZE = 1000UL;
+static constexpr long DELIVERY_TIMEOUT_US = 10000000L;  // 10s
+
+struct Result {
+    size_t subscribers = 0UL;
+    const char* pName = "";
+    double fanOutUs = 0.0;      // Per broadcast
+    double allocations = 0.0;   // Per broadcast
+    size_t delivered = 0UL;
+};  // struct Result
+
+static bool wait_for_delivery(std::vector<std::unique_ptr<comm::P2P_Endpoint>>& pSubscribers, const size_t& expected,
+                              size_t& delivered) {
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+    std::vector<size_t> counts(pSubscribers.size(), 0UL);
+    const auto t0 = monotonic_now();
+    size_t done = 0UL;
+    while ((pSubscribers.size() > done) && (DELIVERY_TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+        done = 0UL;
+        for (size_t i = 0; i < pSubscribers.size(); i++) {
+            if (expected > counts[i]) {
+                pPackets.clear();
+                pSubscribers[i]->recvAll(pPackets, false);
+                counts[i] += pPackets.size();
+                delivered += pPackets.size();
+            }
+
+            if (expected <= counts[i]) {
+                done++;
+            }
+        }
+
+        if (pSubscribers.size() > done) {
+            sleep_for(100L);
+        }
+    }
+
+    return pSubscribers.size() == done;
+}
+
+static bool run(const uint16_t& port, const size_t& numberOfSubscribers, const size_t& numberOfRounds,
+                const comm::EndpointConfig& config, std::vector<Result>& results) {
+    std::unique_ptr<comm::TcpServer> pTcpServer = comm::TcpServer::create(port, config);
+    if (!pTcpServer) {
+        LOGE("Could not create TCP Server which listens at port %u!!!\n", port);
+        return false;
+    }
+
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pSubscribers;
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pClients;
+    int errorCode = 0;
+    for (size_t i = 0; i < numberOfSubscribers; i++) {
+        std::unique_ptr<comm::P2P_Endpoint> pSubscriber = comm::IP_Endpoint::createTcpClient("127.0.0.1", port, config);
+        if (!pSubscriber) {
+            LOGE("Could not connect subscriber %zu!!!\n", i);
+            return false;
+        }
+        pSubscribers.push_back(std::move(pSubscriber));
+        pTcpServer->waitForClients(errorCode, pClients, 0L);
+    }
+
+    const auto t0 = monotonic_now();
+    while ((numberOfSubscribers > pClients.size()) && (DELIVERY_TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+        pTcpServer->waitForClients(errorCode, pClients, 100L);
+    }
+
+    if (numberOfSubscribers != pClients.size()) {
+        LOGE("%zu/%zu subscribers accepted!!!\n", pClients.size(), numberOfSubscribers);
+        return false;
+    }
+
+    std::vector<comm::P2P_Endpoint*> pEndpoints;
+    for (auto& pClient : pClients) {
+        pEndpoints.push_back(pClient.get());
+    }
+
+    uint8_t payload[PAYLOAD_SIZE] = {0};
+    const char* names[] = {"copy", "broadcast"};
+    for (size_t mode = 0; mode < (sizeof(names) / sizeof(names[0])); mode++) {
+        Result result;
+        result.subscribers = numberOfSubscribers;
+        result.pName = names[mode];
+        int64_t fanOutUs = 0;
+        uint64_t allocations = 0ULL;
+
+        for (size_t round = 0; round < numberOfRounds; round++) {
+            const comm::PoolStats stats0 = comm::PacketPool::getStats();
+            const auto t1 = monotonic_now();
+            if (0UL == mode) {
+                for (auto& pEndpoint : pEndpoints) {
+                    pEndpoint->send(comm::Packet::create(payload, sizeof(payload)));
+                }
+            } else {
+                comm::broadcast(pEndpoints, comm::Packet::create(payload, sizeof(payload)));
+            }
+            fanOutUs += get_elapsed_realtime_us(t1);
+            const comm::PoolStats stats1 = comm::PacketPool::getStats();
+            allocations += (stats1.hits + stats1.misses) - (stats0.hits + stats0.misses);
+
+            if (!wait_for_delivery(pSubscribers, 1UL, result.delivered)) {
+                LOGE("%s: round %zu was not delivered to all of %zu subscribers!!!\n", names[mode], round, numberOfSubscribers);
+                return false;
+            }
+        }
+
+        result.fanOutUs = static_cast<double>(fanOutUs) / static_cast<double>(numberOfRounds);
+        result.allocations = static_cast<double>(allocations) / static_cast<double>(numberOfRounds);
+        results.push_back(result);
+    }
+
+    // Server side closes first: no client port is left in TIME_WAIT
+    pClients.clear();
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = (1 < argc) ? static_cast<uint16_t>(atoi(argv[1])) : 27900U;  // Below the ephemeral port range
+    const size_t numberOfRounds = (2 < argc) ? static_cast<size_t>(atol(argv[2])) : 100UL;
+
+    comm::EndpointConfig config;
+    config.pReactor = comm::Reactor::create(1UL);
+
+    std::vector<Result> results;
+    for (auto& subscribers : {10UL, 100UL, 1000UL}) {
+        if (!run(port++, subscribers, numberOfRounds, config, results)) {
+            LOGE("Could not benchmark %zu subscribers!!!\n", subscribers);
+        }
+    }
+
+    LOGI("%zu rounds of %zu-byte packets\n", numberOfRounds, PAYLOAD_SIZE);
+    LOGI("%-11s | %-9s | %14s | %14s | %12s\n", "Subscribers", "Mode", "Fan-out (us)", "Allocations", "Delivered");
+    for (auto& result : results) {
+        LOGI("%-11zu | %-9s | %14.1f | %14.1f | %12zu\n", result.subscribers, result.pName, result.fanOutUs,
+             result.allocations, result.delivered);
+    }
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include "IP_Endpoint.hpp"
+#include "Reactor.hpp"
+#include "TcpConnectionPool.hpp"
+#include "TcpConnector.hpp"
+#include "TcpServer.hpp"
+#include "common.hpp"
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Time to open outbound TCP connections to a local server (e.g. links opened by a service at startup):
+// - sleep-retry: non-blocking `connect()` retried every 100 ms while in progress (former `createTcpClient()`)
+// - sequential: `createTcpClient()`, waiting for writability, one connection after the other
+// - parallel: TcpConnector, all connections in flight at once
+// - pool: `acquire()` from a warm TcpConnectionPool (connected beforehand)
+// All endpoints are served by a single reactor thread.
+// Usage: bm-connect [Port] [Number of Connections]
+
+static constexpr long RETRY_BREAK_US = 100000L;       // 100ms
+static constexpr long SETUP_TIMEOUT_US = 60000000L;  // 60s
+
+enum ConnectMode {
+    E_SLEEP_RETRY = 0,
+    E_SEQUENTIAL,
+    E_PARALLEL,
+    E_POOL
+};  // enum ConnectMode
+
+struct Result {
+    const char* pName = "";
+    size_t connected = 0UL;
+    int64_t elapsedUs = 0;
+};  // struct Result
+
+static void accept_clients(comm::TcpServer* const pServer, std::atomic<bool>* const pExitFlag,
+                           std::vector<std::unique_ptr<comm::P2P_Endpoint>>* const pClients) {
+    int errorCode = 0;
+    while (!(*pExitFlag)) {
+        pServer->waitForClients(errorCode, *pClients, 10L);
+    }
+}
+
+static std::unique_ptr<comm::P2P_Endpoint> connect_with_retries(const uint16_t& port, const comm::EndpointConfig& config) {
+    struct sockaddr_in serverAddr;
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    serverAddr.sin_port = htons(port);
+
+    const int socketFd = socket(AF_INET, SOCK_STREAM, 0);
+    if ((0 > socketFd) || (0 > comm::IP_Endpoint::configureSocket(socketFd))) {
+        return nullptr;
+    }
+
+    int ret;
+    const auto t0 = monotonic_now();
+    do {
+        ret = connect(socketFd, (const struct sockaddr*)(&serverAddr), sizeof(serverAddr));
+        if ((0 != ret) && ((EINPROGRESS == errno) || (EAGAIN == errno) || (EALREADY == errno))) {
+            sleep_for(RETRY_BREAK_US);
+        } else {
+            break;
+        }
+    } while ((comm::CONNECT_TIMEOUT_MS * US_PER_MS) > get_elapsed_realtime_us(t0));
+
+    if (0 != ret) {
+        ::close(socketFd);
+        return nullptr;
+    }
+
+    return std::unique_ptr<comm::P2P_Endpoint>(new comm::IP_Endpoint(socketFd, serverAddr, config));
+}
+
+static bool run(const ConnectMode& mode, const uint16_t& port, const size_t& numberOfConnections,
+                const comm::EndpointConfig& config, Result& result) {
+    std::unique_ptr<comm::TcpServer> pTcpServer = comm::TcpServer::create(port, config);
+    if (!pTcpServer) {
+        LOGE("Could not create TCP Server which listens at port %u!!!\n", port);
+        return false;
+    }
+
+    std::atomic<bool> exitFlag{false};
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pAccepted;
+    std::thread acceptor(accept_clients, pTcpServer.get(), &exitFlag, &pAccepted);
+
+    std::unique_ptr<comm::TcpConnectionPool> pPool;
+    if (E_POOL == mode) {
+        pPool = comm::TcpConnectionPool::create("127.0.0.1", port, numberOfConnections, config);
+        const auto t0 = monotonic_now();
+        while (pPool && (numberOfConnections > pPool->getNumberOfIdleConnections()) &&
+               (SETUP_TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+            sleep_for(1000L);
+        }
+    }
+
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pClients;
+    const auto t0 = monotonic_now();
+    if (E_PARALLEL == mode) {
+        comm::TcpConnector connector(config);
+        for (size_t i = 0; i < numberOfConnections; i++) {
+            connector.connect("127.0.0.1", port);
+        }
+
+        int errorCode = 0;
+        while ((0UL < connector.getNumberOfPendingConnections()) && (0 == errorCode)) {
+            connector.waitForConnections(
+                errorCode,
+                [&pClients](const size_t&, std::unique_ptr<comm::P2P_Endpoint>& pClient, const int&) {
+                    if (pClient) {
+                        pClients.push_back(std::move(pClient));
+                    }
+                },
+                100L);
+        }
+    } else {
+        for (size_t i = 0; i < numberOfConnections; i++) {
+            std::unique_ptr<comm::P2P_Endpoint> pClient;
+            if (E_SLEEP_RETRY == mode) {
+                pClient = connect_with_retries(port, config);
+            } else if (E_SEQUENTIAL == mode) {
+                pClient = comm::IP_Endpoint::createTcpClient("127.0.0.1", port, config);
+            } else if (pPool) {
+                pClient = pPool->acquire(0L);
+            }
+
+            if (pClient) {
+                pClients.push_back(std::move(pClient));
+            }
+        }
+    }
+    result.elapsedUs = get_elapsed_realtime_us(t0);
+    result.connected = pClients.size();
+
+    pPool.reset();
+    exitFlag = true;
+    acceptor.join();
+
+    return numberOfConnections == result.connected;
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = (1 < argc) ? static_cast<uint16_t>(atoi(argv[1])) : 28100U;  // Below the ephemeral port range
+    const size_t numberOfConnections = (2 < argc) ? static_cast<size_t>(atol(argv[2])) : 64UL;
+
+    comm::EndpointConfig config;
+    config.pReactor = comm::Reactor::create(1UL);
+
+    const char* names[] = {"sleep-retry", "sequential", "parallel", "pool"};
+    const ConnectMode modes[] = {E_SLEEP_RETRY, E_SEQUENTIAL, E_PARALLEL, E_POOL};
+
+    std::vector<Result> results;
+    for (size_t i = 0; i < (sizeof(modes) / sizeof(modes[0])); i++) {
+        Result result;
+        result.pName = names[i];
+        if (run(modes[i], port++, numberOfConnections, config, result)) {
+            results.push_back(result);
+        } else {
+            LOGE("%s: %zu of %zu connections opened!!!\n", names[i], result.connected, numberOfConnections);
+        }
+    }
+
+    LOGI("%zu connections per row\n", numberOfConnections);
+    LOGI("%-12s | %12s | %16s\n", "Mode", "Elapsed", "us/connection");
+    for (auto& result : results) {
+        LOGI("%-12s | %9.1f ms | %16.1f\n", result.pName, static_cast<double>(result.elapsedUs) / 1000.0,
+             static_cast<double>(result.elapsedUs) / static_cast<double>(result.connected));
+    }
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+#include "TcpServer.hpp"
+#include "common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Round-trip time of request/response traffic on loopback: queued sends (Tx thread) vs direct sends (caller's thread).
+// The responder echoes each request from its Rx handler, the requester waits for the response before the next request.
+// Both sides use the same send mode.
+// Usage: bm-direct-send [Port] [Number of Samples]
+
+static constexpr size_t PAYLOAD_SIZE = 64UL;
+static constexpr size_t WARMUP_SAMPLES = 100UL;
+static constexpr long RESPONSE_TIMEOUT_US = 1000000L;  // 1s
+
+struct Result {
+    const char* pTransport = "";
+    bool directSend = false;
+    int64_t p50Us = 0;
+    int64_t p99Us = 0;
+    double meanUs = 0.0;
+};  // struct Result
+
+/**
+ * @brief Echo responder, the endpoint is only known once it has been created.
+ */
+struct Responder {
+    std::atomic<comm::P2P_Endpoint*> pEndpoint{nullptr};
+
+    comm::PacketHandler getHandler() {
+        return [this](std::unique_ptr<comm::Packet>& pPacket) {
+            comm::P2P_Endpoint* const pResponder = pEndpoint.load();
+            if (nullptr != pResponder) {
+                pResponder->send(pPacket);
+            }
+        };
+    }
+};  // struct Responder
+
+static bool run(comm::P2P_Endpoint* const pRequester, const size_t& numberOfSamples, Result& result) {
+    uint8_t payload[PAYLOAD_SIZE];
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+    std::vector<int64_t> rttsUs;
+
+    sleep_for(100000L);
+
+    for (size_t i = 0; i < (WARMUP_SAMPLES + numberOfSamples); i++) {
+        payload[0] = static_cast<uint8_t>(i);
+        const auto t0 = monotonic_now();
+        pRequester->send(comm::Packet::create(payload, sizeof(payload)));
+        while (pPackets.empty() && (RESPONSE_TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+            pRequester->recvAll(pPackets);
+        }
+        const int64_t rttUs = get_elapsed_realtime_us(t0);
+
+        if ((1UL != pPackets.size()) || (payload[0] != pPackets.front()->getPayload()[0])) {
+            LOGE("Response %zu is missing!!!\n", i);
+            return false;
+        }
+        pPackets.clear();
+
+        if (WARMUP_SAMPLES <= i) {
+            rttsUs.push_back(rttUs);
+        }
+    }
+
+    std::sort(rttsUs.begin(), rttsUs.end());
+    int64_t sumUs = 0;
+    for (auto& rttUs : rttsUs) {
+        sumUs += rttUs;
+    }
+
+    result.p50Us = rttsUs[(rttsUs.size() - 1) / 2];
+    result.p99Us = rttsUs[((rttsUs.size() - 1) * 99) / 100];
+    result.meanUs = static_cast<double>(sumUs) / static_cast<double>(rttsUs.size());
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = (1 < argc) ? static_cast<uint16_t>(atoi(argv[1])) : 48500U;
+    const size_t numberOfSamples = (2 < argc) ? static_cast<size_t>(atol(argv[2])) : 20000UL;
+
+    std::vector<Result> results;
+    const bool modes[] = {false, true};
+    for (const bool& directSend : modes) {
+        // UDP
+        {
+            Responder responder;
+            comm::EndpointConfig config;
+            config.directSend = directSend;
+            comm::EndpointConfig responderConfig = config;
+            responderConfig.rxPacketHandler = responder.getHandler();
+
+            const uint16_t portA = port++;
+            const uint16_t portB = port++;
+            std::unique_ptr<comm::P2P_Endpoint> pRequester = comm::IP_Endpoint::createUdpPeer(portA, "127.0.0.1", portB, config);
+            std::unique_ptr<comm::P2P_Endpoint> pResponder = comm::IP_Endpoint::createUdpPeer(portB, "127.0.0.1", portA, responderConfig);
+            Result result;
+            result.pTransport = "UDP";
+            result.directSend = directSend;
+            if (pRequester && pResponder) {
+                responder.pEndpoint = pResponder.get();
+                if (run(pRequester.get(), numberOfSamples, result)) {
+                    results.push_back(result);
+                }
+                responder.pEndpoint = nullptr;
+            }
+        }
+
+        // TCP
+        {
+            Responder responder;
+            comm::EndpointConfig config;
+            config.directSend = directSend;
+            comm::EndpointConfig responderConfig = config;
+            responderConfig.rxPacketHandler = responder.getHandler();
+
+            const uint16_t serverPort = port++;
+            std::unique_ptr<comm::TcpServer> pTcpServer = comm::TcpServer::create(serverPort, responderConfig);
+            if (!pTcpServer) {
+                LOGE("Could not create TCP Server which listens at port %u!!!\n", serverPort);
+                continue;
+            }
+
+            std::unique_ptr<comm::P2P_Endpoint> pRequester = comm::IP_Endpoint::createTcpClient("127.0.0.1", serverPort, config);
+            int errorCode = 0;
+            std::unique_ptr<comm::P2P_Endpoint> pResponder = pTcpServer->waitForClient(errorCode, 5000);
+            Result result;
+            result.pTransport = "TCP";
+            result.directSend = directSend;
+            if (pRequester && pResponder) {
+                responder.pEndpoint = pResponder.get();
+                if (run(pRequester.get(), numberOfSamples, result)) {
+                    results.push_back(result);
+                }
+                responder.pEndpoint = nullptr;
+            }
+        }
+    }
+
+    LOGI("%zu requests of %zu bytes, one at a time\n", numberOfSamples, PAYLOAD_SIZE);
+    LOGI("%-9s %-6s | %10s %10s %10s\n", "Transport", "Send", "RTT p50", "RTT p99", "RTT mean");
+    for (auto& result : results) {
+        LOGI("%-9s %-6s | %7lld us %7lld us %7.1f us\n", result.pTransport, result.directSend ? "direct" : "queued",
+             static_cast<long long>(result.p50Us), static_cast<long long>(result.p99Us), result.meanUs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+#include "TcpServer.hpp"
+#include "common.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Connection churn: short sessions (create, exchange one packet each way, destroy) on loopback.
+// Teardown time is measured per endpoint (destructor), session rate over whole sessions.
+// Usage: bm-endpoint-churn [Port] [Number of Sessions]
+
+static constexpr size_t PAYLOAD_SIZE = 64UL;
+static constexpr long EXCHANGE_TIMEOUT_US = 1000000L;  // 1s
+
+struct Result {
+    const char* pTransport = "";
+    const char* pName = "";
+    size_t sessions = 0UL;
+    double sessionsPerS = 0.0;
+    int64_t teardownP50Us = 0;
+    int64_t teardownP99Us = 0;
+    int64_t teardownMaxUs = 0;
+};  // struct Result
+
+static bool exchange(comm::P2P_Endpoint* const pSender, comm::P2P_Endpoint* const pReceiver) {
+    uint8_t payload[PAYLOAD_SIZE] = {0};
+    pSender->send(comm::Packet::create(payload, sizeof(payload)));
+
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+    const auto t0 = monotonic_now();
+    while (pPackets.empty() && (EXCHANGE_TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+        pReceiver->recvAll(pPackets);
+    }
+
+    return !pPackets.empty();
+}
+
+static int64_t tear_down(std::unique_ptr<comm::P2P_Endpoint>& pEndpoint) {
+    const auto t0 = monotonic_now();
+    pEndpoint.reset();
+    return get_elapsed_realtime_us(t0);
+}
+
+static void summarize(std::vector<int64_t>& teardownsUs, const int64_t& elapsedUs, Result& result) {
+    std::sort(teardownsUs.begin(), teardownsUs.end());
+    result.sessionsPerS = static_cast<double>(result.sessions) * 1000000.0 / static_cast<double>(elapsedUs);
+    result.teardownP50Us = teardownsUs[(teardownsUs.size() - 1) / 2];
+    result.teardownP99Us = teardownsUs[((teardownsUs.size() - 1) * 99) / 100];
+    result.teardownMaxUs = teardownsUs.back();
+}
+
+static bool run_udp(const comm::EndpointConfig& config, const uint16_t& port, const size_t& numberOfSessions, Result& result) {
+    const uint16_t peerPort = static_cast<uint16_t>(port + 1);
+    std::vector<int64_t> teardownsUs;
+
+    const auto t0 = monotonic_now();
+    for (size_t i = 0; i < numberOfSessions; i++) {
+        std::unique_ptr<comm::P2P_Endpoint> pPeerA = comm::IP_Endpoint::createUdpPeer(port, "127.0.0.1", peerPort, config);
+        std::unique_ptr<comm::P2P_Endpoint> pPeerB = comm::IP_Endpoint::createUdpPeer(peerPort, "127.0.0.1", port, config);
+        if ((!pPeerA) || (!pPeerB) || !exchange(pPeerA.get(), pPeerB.get()) || !exchange(pPeerB.get(), pPeerA.get())) {
+            LOGE("Session %zu failed!!!\n", i);
+            return false;
+        }
+
+        teardownsUs.push_back(tear_down(pPeerA));
+        teardownsUs.push_back(tear_down(pPeerB));
+    }
+    const int64_t elapsedUs = get_elapsed_realtime_us(t0);
+
+    result.pTransport = "UDP";
+    result.sessions = numberOfSessions;
+    summarize(teardownsUs, elapsedUs, result);
+
+    return true;
+}
+
+static bool run_tcp(const comm::EndpointConfig& config, const uint16_t& port, const size_t& numberOfSessions, Result& result) {
+    std::unique_ptr<comm::TcpServer> pTcpServer = comm::TcpServer::create(port, config);
+    if (!pTcpServer) {
+        LOGE("Could not create TCP Server which listens at port %u!!!\n", port);
+        return false;
+    }
+
+    std::vector<int64_t> teardownsUs;
+
+    const auto t0 = monotonic_now();
+    for (size_t i = 0; i < numberOfSessions; i++) {
+        std::unique_ptr<comm::P2P_Endpoint> pClient = comm::IP_Endpoint::createTcpClient("127.0.0.1", port, config);
+        int errorCode = 0;
+        std::unique_ptr<comm::P2P_Endpoint> pServer = pTcpServer->waitForClient(errorCode, 5000);
+        if ((!pClient) || (!pServer) || !exchange(pClient.get(), pServer.get()) || !exchange(pServer.get(), pClient.get())) {
+            LOGE("Session %zu failed!!!\n", i);
+            return false;
+        }
+
+        teardownsUs.push_back(tear_down(pClient));
+        teardownsUs.push_back(tear_down(pServer));
+    }
+    const int64_t elapsedUs = get_elapsed_realtime_us(t0);
+
+    result.pTransport = "TCP";
+    result.sessions = numberOfSessions;
+    summarize(teardownsUs, elapsedUs, result);
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = (1 < argc) ? static_cast<uint16_t>(atoi(argv[1])) : 47000U;
+    const size_t numberOfSessions = (2 < argc) ? static_cast<size_t>(atol(argv[2])) : 200UL;
+
+    struct Variant {
+        const char* pName;
+        comm::EndpointConfig config;
+    };  // struct Variant
+
+    std::vector<Variant> variants(4);
+    variants[0].pName = "socket";
+    variants[1].pName = "socket+spsc";
+    variants[1].config.txQueueType = dstruct::E_SPSC_QUEUE;
+    variants[2].pName = "io_uring";
+    variants[2].config.ioBackend = comm::E_IO_URING;
+    variants[3].pName = "reactor";
+    variants[3].config.pReactor = comm::Reactor::create(1UL);
+
+    std::vector<Result> results;
+    for (auto& variant : variants) {
+        Result result;
+        result.pName = variant.pName;
+        if (run_udp(variant.config, port, numberOfSessions, result)) {
+            results.push_back(result);
+        }
+        port = static_cast<uint16_t>(port + 2);
+
+        result.pName = variant.pName;
+        if (run_tcp(variant.config, port, numberOfSessions, result)) {
+            results.push_back(result);
+        }
+        port++;
+    }
+
+    LOGI("%zu sessions per row, one %zu-byte packet each way\n", numberOfSessions, PAYLOAD_SIZE);
+    LOGI("%-9s %-12s | %12s | %14s %14s %14s\n", "Transport", "Variant", "Sessions/s", "Teardown p50", "Teardown p99", "Teardown max");
+    for (auto& result : results) {
+        LOGI("%-9s %-12s | %12.1f | %11lld us %11lld us %11lld us\n", result.pTransport, result.pName, result.sessionsPerS,
+             static_cast<long long>(result.teardownP50Us), static_cast<long long>(result.teardownP99Us),
+             static_cast<long long>(result.teardownMaxUs));
+    }
+
+    return 0;
+}
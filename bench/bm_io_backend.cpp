@@ -0,0 +1,125 @@
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+#include "TcpServer.hpp"
+#include "common.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// System calls per packet of socket vs io_uring backends (UdpPeer & TCP pairs on loopback).
+// Packets are sent in bursts, each burst is received before the next one is sent (no loss on UDP).
+// Tx system calls are counted on the sender, Rx system calls (including waits) on the receiver.
+// Usage: bm-io-backend [Port] [Number of Packets]
+
+static constexpr size_t BURST_SIZE = 256UL;
+static constexpr size_t PAYLOAD_SIZE = 64UL;
+static constexpr long BURST_TIMEOUT_US = 5000000L;  // 5s
+
+struct Result {
+    const char* pTransport = "";
+    comm::IO_BACKEND backend = comm::E_IO_SOCKET;
+    size_t packets = 0UL;
+    double packetsPerS = 0.0;
+    double txSyscallsPerPacket = 0.0;
+    double rxSyscallsPerPacket = 0.0;
+};  // struct Result
+
+static bool run(comm::P2P_Endpoint* const pSender, comm::P2P_Endpoint* const pReceiver, const size_t& numberOfPackets, Result& result) {
+    uint8_t payload[PAYLOAD_SIZE];
+    memset(payload, 0xA5, sizeof(payload));
+
+    sleep_for(100000L);
+    const comm::IoStats tx0 = pSender->getIoStats();
+    const comm::IoStats rx0 = pReceiver->getIoStats();
+
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+    size_t received = 0UL;
+    const auto t0 = monotonic_now();
+    for (size_t sent = 0UL; sent < numberOfPackets;) {
+        const size_t burst = ((numberOfPackets - sent) < BURST_SIZE) ? (numberOfPackets - sent) : BURST_SIZE;
+        for (size_t i = 0; i < burst; i++) {
+            pSender->send(comm::Packet::create(payload, sizeof(payload)));
+        }
+        sent += burst;
+
+        const auto ts = monotonic_now();
+        while ((sent > received) && (BURST_TIMEOUT_US > get_elapsed_realtime_us(ts))) {
+            pReceiver->recvAll(pPackets);
+            received += pPackets.size();
+            pPackets.clear();
+        }
+
+        if (sent != received) {
+            LOGE("Received %zu/%zu packets!!!\n", received, sent);
+            return false;
+        }
+    }
+    const int64_t elapsedUs = get_elapsed_realtime_us(t0);
+
+    const comm::IoStats tx1 = pSender->getIoStats();
+    const comm::IoStats rx1 = pReceiver->getIoStats();
+
+    result.backend = pSender->getIoBackend();
+    result.packets = numberOfPackets;
+    result.packetsPerS = static_cast<double>(numberOfPackets) * 1000000.0 / static_cast<double>(elapsedUs);
+    result.txSyscallsPerPacket = static_cast<double>(tx1.txSyscalls - tx0.txSyscalls) / static_cast<double>(numberOfPackets);
+    result.rxSyscallsPerPacket = static_cast<double>(rx1.rxSyscalls - rx0.rxSyscalls) / static_cast<double>(numberOfPackets);
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = (1 < argc) ? static_cast<uint16_t>(atoi(argv[1])) : 46000U;
+    const size_t numberOfPackets = (2 < argc) ? static_cast<size_t>(atol(argv[2])) : 200000UL;
+
+    std::vector<Result> results;
+    const comm::IO_BACKEND backends[] = {comm::E_IO_SOCKET, comm::E_IO_URING};
+    for (const comm::IO_BACKEND& backend : backends) {
+        comm::EndpointConfig config;
+        config.ioBackend = backend;
+
+        // UDP
+        {
+            const uint16_t portA = port++;
+            const uint16_t portB = port++;
+            std::unique_ptr<comm::P2P_Endpoint> pSender = comm::IP_Endpoint::createUdpPeer(portA, "127.0.0.1", portB, config);
+            std::unique_ptr<comm::P2P_Endpoint> pReceiver = comm::IP_Endpoint::createUdpPeer(portB, "127.0.0.1", portA, config);
+            Result result;
+            result.pTransport = "UDP";
+            if (pSender && pReceiver && run(pSender.get(), pReceiver.get(), numberOfPackets, result)) {
+                results.push_back(result);
+            }
+        }
+
+        // TCP
+        {
+            const uint16_t serverPort = port++;
+            std::unique_ptr<comm::TcpServer> pTcpServer = comm::TcpServer::create(serverPort, config);
+            if (!pTcpServer) {
+                LOGE("Could not create TCP Server which listens at port %u!!!\n", serverPort);
+                continue;
+            }
+
+            std::unique_ptr<comm::P2P_Endpoint> pSender = comm::IP_Endpoint::createTcpClient("127.0.0.1", serverPort, config);
+            int errorCode = 0;
+            std::unique_ptr<comm::P2P_Endpoint> pReceiver = pTcpServer->waitForClient(errorCode, 5000);
+            Result result;
+            result.pTransport = "TCP";
+            if (pSender && pReceiver && run(pSender.get(), pReceiver.get(), numberOfPackets, result)) {
+                results.push_back(result);
+            }
+        }
+    }
+
+    LOGI("%zu x %zu-byte packets, bursts of %zu\n", numberOfPackets, PAYLOAD_SIZE, BURST_SIZE);
+    LOGI("%-9s %-8s | %12s | %16s %16s\n", "Transport", "Backend", "Packets/s", "Tx syscalls/pkt", "Rx syscalls/pkt");
+    for (auto& result : results) {
+        LOGI("%-9s %-8s | %12.0f | %16.4f %16.4f\n", result.pTransport, (comm::E_IO_URING == result.backend) ? "io_uring" : "socket",
+             result.packetsPerS, result.txSyscallsPerPacket, result.rxSyscallsPerPacket);
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "Packet.hpp"
+#include "common.hpp"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// Packet life cycle (create, move, destroy) at several payload sizes:
+//  - Packet: pooled object, payloads up to `Packet::SMALL_PAYLOAD_SIZE` stored inline, larger ones pooled
+//  - Baseline: heap-allocated object & payload (former implementation)
+
+static constexpr size_t NUMBER_OF_PACKETS = 100000UL;
+static constexpr int NUMBER_OF_ROUNDS = 10;
+
+class BaselinePacket {
+   public:
+    BaselinePacket(const uint8_t* const pPayload, const size_t& payloadSize) : mpPayload(new uint8_t[payloadSize]), mPayloadSize(payloadSize) {
+        mTimestampUs = get_elapsed_realtime_us();
+        memcpy(mpPayload.get(), pPayload, payloadSize);
+    }
+
+    BaselinePacket(BaselinePacket&& other) : mpPayload(std::move(other.mpPayload)), mPayloadSize(other.mPayloadSize) {
+        other.mPayloadSize = 0;
+        mTimestampUs = other.mTimestampUs;
+        other.mTimestampUs = -1L;
+    }
+
+    BaselinePacket& operator=(BaselinePacket&& other) {
+        mpPayload = std::move(other.mpPayload);
+        mPayloadSize = other.mPayloadSize;
+        other.mPayloadSize = 0;
+        mTimestampUs = other.mTimestampUs;
+        other.mTimestampUs = -1L;
+        return *this;
+    }
+
+    virtual ~BaselinePacket() {}
+
+    static std::unique_ptr<BaselinePacket> create(const uint8_t* const pPayload, const size_t& payloadSize) {
+        return std::unique_ptr<BaselinePacket>(new BaselinePacket(pPayload, payloadSize));
+    }
+
+   private:
+    std::unique_ptr<uint8_t[]> mpPayload;
+    size_t mPayloadSize;
+    int64_t mTimestampUs;
+};  // class BaselinePacket
+
+struct Result {
+    double createNs = 0.0;
+    double moveNs = 0.0;
+    double destroyNs = 0.0;
+};  // struct Result
+
+template <class T>
+static Result run(const uint8_t* const pPayload, const size_t& size) {
+    Result result;
+    std::vector<std::unique_ptr<T>> pPackets;
+    pPackets.reserve(NUMBER_OF_PACKETS);
+
+    for (int round = 0; round < NUMBER_OF_ROUNDS; round++) {
+        auto t0 = monotonic_now();
+        for (size_t i = 0; i < NUMBER_OF_PACKETS; i++) {
+            pPackets.push_back(T::create(pPayload, size));
+        }
+        result.createNs += static_cast<double>(get_elapsed_realtime_us(t0));
+
+        t0 = monotonic_now();
+        for (size_t i = 0; i < NUMBER_OF_PACKETS; i++) {
+            T tmp(std::move(*pPackets[i]));
+            *pPackets[i] = std::move(tmp);
+            asm volatile("" : : "r"(pPackets[i].get()) : "memory");  // Keeps the compiler from eliding the moves
+        }
+        result.moveNs += static_cast<double>(get_elapsed_realtime_us(t0));
+
+        t0 = monotonic_now();
+        pPackets.clear();
+        result.destroyNs += static_cast<double>(get_elapsed_realtime_us(t0));
+    }
+
+    const double count = static_cast<double>(NUMBER_OF_PACKETS * NUMBER_OF_ROUNDS);
+    result.createNs = result.createNs * NS_PER_US / count;
+    result.moveNs = result.moveNs * NS_PER_US / count / 2.0;
+    result.destroyNs = result.destroyNs * NS_PER_US / count;
+
+    return result;
+}
+
+int main() {
+    const size_t sizes[] = {6UL, 32UL, comm::Packet::SMALL_PAYLOAD_SIZE, 128UL, 512UL, comm::MAX_PAYLOAD_SIZE};
+    std::unique_ptr<uint8_t[]> pPayload(new uint8_t[comm::MAX_PAYLOAD_SIZE]);
+    memset(pPayload.get(), 0x5A, comm::MAX_PAYLOAD_SIZE);
+
+    LOGI("%zu packets x %d rounds, ns per operation\n", NUMBER_OF_PACKETS, NUMBER_OF_ROUNDS);
+    LOGI("%-8s | %-26s | %-26s\n", "Payload", "Packet", "Baseline");
+    LOGI("%-8s | %8s %8s %8s | %8s %8s %8s\n", "(bytes)", "create", "move", "destroy", "create", "move", "destroy");
+
+    for (const size_t& size : sizes) {
+        // Warm up the pool
+        run<comm::Packet>(pPayload.get(), size);
+
+        const Result packet = run<comm::Packet>(pPayload.get(), size);
+        const Result baseline = run<BaselinePacket>(pPayload.get(), size);
+        LOGI("%-8zu | %8.1f %8.1f %8.1f | %8.1f %8.1f %8.1f\n", size,
+             packet.createNs, packet.moveNs, packet.destroyNs,
+             baseline.createNs, baseline.moveNs, baseline.destroyNs);
+    }
+
+    return 0;
+}
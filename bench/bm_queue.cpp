@@ -0,0 +1,92 @@
+#include "Queue.hpp"
+#include "SpscQueue.hpp"
+#include "SyncQueue.hpp"
+#include "common.hpp"
+
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Producer / consumer contention: `SyncQueue` vs `SpscQueue`, one producer thread & one consumer thread.
+// Items are allocated before the measurement, so that only queue operations are timed.
+// The consumer either waits for items (`dequeue(items, true)`) or polls (`dequeue(items, false)`).
+
+static constexpr size_t NUMBER_OF_ITEMS = 1000000UL;
+static constexpr int NUMBER_OF_ROUNDS = 5;
+
+struct Result {
+    double nsPerItem = 0.0;
+    double itemsPerDequeue = 0.0;
+    double fullRatio = 0.0;  // Failed enqueues per item
+};  // struct Result
+
+static Result run(const dstruct::QUEUE_TYPE& type, const bool wait) {
+    Result result;
+
+    for (int round = 0; round < NUMBER_OF_ROUNDS; round++) {
+        std::unique_ptr<dstruct::Queue<size_t>> pQueue = dstruct::Queue<size_t>::create(
+            type, dstruct::SyncQueue<size_t>::DEFAULT_TIMEOUT_MS, dstruct::SyncQueue<size_t>::DEFAULT_CAP_LIMIT);
+
+        std::vector<std::unique_ptr<size_t>> pItems;
+        pItems.reserve(NUMBER_OF_ITEMS);
+        for (size_t i = 0; i < NUMBER_OF_ITEMS; i++) {
+            pItems.push_back(std::unique_ptr<size_t>(new size_t(i)));
+        }
+
+        size_t fullCount = 0UL;
+        const auto t0 = monotonic_now();
+        std::thread producer([&pQueue, &pItems, &fullCount]() {
+            for (size_t i = 0; i < NUMBER_OF_ITEMS;) {
+                if (pQueue->enqueue(pItems[i])) {
+                    i++;
+                } else {
+                    fullCount++;
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        std::deque<std::unique_ptr<size_t>> items;
+        size_t count = 0UL;
+        size_t dequeueCount = 0UL;
+        while (NUMBER_OF_ITEMS > count) {
+            if (pQueue->dequeue(items, wait)) {
+                dequeueCount++;
+                count += items.size();
+                items.clear();
+            } else if (!wait) {
+                std::this_thread::yield();
+            }
+        }
+        const int64_t elapsedUs = get_elapsed_realtime_us(t0);
+        producer.join();
+
+        result.nsPerItem += static_cast<double>(elapsedUs) * 1000.0 / static_cast<double>(NUMBER_OF_ITEMS);
+        result.itemsPerDequeue += static_cast<double>(NUMBER_OF_ITEMS) / static_cast<double>(dequeueCount);
+        result.fullRatio += static_cast<double>(fullCount) / static_cast<double>(NUMBER_OF_ITEMS);
+    }
+
+    result.nsPerItem /= NUMBER_OF_ROUNDS;
+    result.itemsPerDequeue /= NUMBER_OF_ROUNDS;
+    result.fullRatio /= NUMBER_OF_ROUNDS;
+
+    return result;
+}
+
+int main() {
+    LOGI("%u hardware thread(s), %zu items x %d rounds\n", std::thread::hardware_concurrency(), NUMBER_OF_ITEMS, NUMBER_OF_ROUNDS);
+    LOGI("%-10s %-8s | %10s %12s %10s\n", "Queue", "Consumer", "ns/item", "items/dequeue", "full/item");
+
+    const dstruct::QUEUE_TYPE types[] = {dstruct::E_SYNC_QUEUE, dstruct::E_SPSC_QUEUE};
+    const char* const names[] = {"SyncQueue", "SpscQueue"};
+    for (size_t i = 0; i < 2; i++) {
+        for (const bool wait : {true, false}) {
+            const Result result = run(types[i], wait);
+            LOGI("%-10s %-8s | %10.1f %12.1f %10.3f\n", names[i], wait ? "wait" : "poll",
+                 result.nsPerItem, result.itemsPerDequeue, result.fullRatio);
+        }
+    }
+
+    return 0;
+}
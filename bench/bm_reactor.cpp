@@ -0,0 +1,179 @@
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+#include "Reactor.hpp"
+#include "TcpServer.hpp"
+#include "common.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+// Scaling of TCP connections (loopback): dedicated Rx/Tx threads per endpoint vs a shared reactor.
+// For each number of connections: threads & memory in use, idle CPU, time to deliver a burst of packets
+// from every client to the server. Connections are limited by the number of file descriptors (2 per connection).
+// Usage: bm-reactor [Port] [Max. Connections with dedicated threads]
+
+static const size_t NUMBERS_OF_CONNECTIONS[] = {10UL, 100UL, 1000UL, 10000UL};
+static constexpr size_t PACKETS_PER_CLIENT = 10UL;
+static constexpr size_t PAYLOAD_SIZE = 64UL;
+static constexpr long IDLE_PERIOD_US = 1000000L;  // 1s
+static constexpr long DELIVERY_TIMEOUT_US = 60000000L;  // 60s
+static constexpr int CONNECT_ATTEMPTS = 10;  // A connection request may time out while the server's backlog is full
+
+struct Result {
+    size_t connections = 0UL;
+    long threads = 0L;
+    long rssKb = 0L;
+    double idleCpu = 0.0;  // % of a core
+    double deliveryMs = 0.0;
+    double packetsPerS = 0.0;
+};  // struct Result
+
+static long read_status(const std::string& key) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (0 == line.compare(0, key.size(), key)) {
+            return atol(line.c_str() + key.size());
+        }
+    }
+
+    return -1L;
+}
+
+static int64_t get_cpu_time_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000LL + ts.tv_nsec / 1000L;
+}
+
+static bool run(const uint16_t port, const size_t numberOfConnections, const bool useReactor, Result& result) {
+    comm::EndpointConfig config;
+    if (useReactor) {
+        config.pReactor = comm::Reactor::create();
+    }
+
+    std::unique_ptr<comm::TcpServer> pTcpServer = comm::TcpServer::create(port, config);
+    if (!pTcpServer) {
+        return false;
+    }
+
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pClients;
+    std::thread connector([&pClients, &port, &numberOfConnections, &config]() {
+        for (size_t i = 0; i < numberOfConnections; i++) {
+            std::unique_ptr<comm::P2P_Endpoint> pClient;
+            for (int attempt = 0; (CONNECT_ATTEMPTS > attempt) && !pClient; attempt++) {
+                pClient = comm::IP_Endpoint::createTcpClient("127.0.0.1", port, config);
+            }
+
+            if (!pClient) {
+                break;
+            }
+            pClients.push_back(std::move(pClient));
+        }
+    });
+
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pServerEndpoints;
+    int errorCode = 0;
+    for (size_t i = 0; i < numberOfConnections; i++) {
+        std::unique_ptr<comm::P2P_Endpoint> pEndpoint = pTcpServer->waitForClient(errorCode, 5000);
+        if (!pEndpoint) {
+            break;
+        }
+        pServerEndpoints.push_back(std::move(pEndpoint));
+    }
+    connector.join();
+
+    if ((numberOfConnections != pClients.size()) || (numberOfConnections != pServerEndpoints.size())) {
+        LOGE("Established %zu/%zu connections!!!\n", pServerEndpoints.size(), numberOfConnections);
+        return false;
+    }
+
+    result.connections = numberOfConnections;
+    result.threads = read_status("Threads:");
+    result.rssKb = read_status("VmRSS:");
+
+    const int64_t cpu0 = get_cpu_time_us();
+    auto t0 = monotonic_now();
+    sleep_for(IDLE_PERIOD_US);
+    result.idleCpu = 100.0 * static_cast<double>(get_cpu_time_us() - cpu0) / static_cast<double>(get_elapsed_realtime_us(t0));
+
+    uint8_t payload[PAYLOAD_SIZE];
+    memset(payload, 0xA5, sizeof(payload));
+
+    t0 = monotonic_now();
+    for (auto& pClient : pClients) {
+        for (size_t i = 0; i < PACKETS_PER_CLIENT; i++) {
+            pClient->send(comm::Packet::create(payload, sizeof(payload)));
+        }
+    }
+
+    const size_t expected = numberOfConnections * PACKETS_PER_CLIENT;
+    size_t received = 0UL;
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+    while ((expected > received) && (DELIVERY_TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+        for (auto& pEndpoint : pServerEndpoints) {
+            pEndpoint->recvAll(pPackets, false);
+            received += pPackets.size();
+            pPackets.clear();
+        }
+    }
+    const int64_t elapsedUs = get_elapsed_realtime_us(t0);
+
+    if (expected != received) {
+        LOGE("Received %zu/%zu packets!!!\n", received, expected);
+        return false;
+    }
+
+    result.deliveryMs = static_cast<double>(elapsedUs) / US_PER_MS;
+    result.packetsPerS = static_cast<double>(expected) * US_PER_S / static_cast<double>(elapsedUs);
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = (1 < argc) ? static_cast<uint16_t>(atoi(argv[1])) : 45000U;
+    const size_t maxThreadedConnections = (2 < argc) ? static_cast<size_t>(atol(argv[2])) : 100UL;
+
+    struct rlimit limit;
+    getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    const size_t maxConnections = (static_cast<size_t>(limit.rlim_cur) - 64UL) / 2UL;
+
+    std::vector<Result> results[2];
+    for (const size_t& requested : NUMBERS_OF_CONNECTIONS) {
+        const size_t numberOfConnections = (maxConnections < requested) ? maxConnections : requested;
+
+        for (int mode = 0; mode < 2; mode++) {
+            const bool useReactor = (1 == mode);
+            if (!useReactor && (maxThreadedConnections < numberOfConnections)) {
+                continue;
+            }
+
+            Result result;
+            if (run(port++, numberOfConnections, useReactor, result)) {
+                results[mode].push_back(result);
+            }
+        }
+    }
+
+    LOGI("%u hardware thread(s), file descriptor limit: %llu, %zu x %zu-byte packets per client\n",
+         std::thread::hardware_concurrency(), static_cast<unsigned long long>(limit.rlim_cur), PACKETS_PER_CLIENT, PAYLOAD_SIZE);
+    LOGI("%-8s %11s | %8s %10s %9s | %12s %12s\n", "Mode", "Connections", "Threads", "RSS (KB)", "Idle CPU", "Delivery (ms)", "Packets/s");
+    for (int mode = 0; mode < 2; mode++) {
+        for (auto& result : results[mode]) {
+            LOGI("%-8s %11zu | %8ld %10ld %8.1f%% | %12.1f %12.0f\n", (1 == mode) ? "reactor" : "threads",
+                 result.connections, result.threads, result.rssKb, result.idleCpu, result.deliveryMs, result.packetsPerS);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+#include "common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Receive latency of queued delivery vs handlers (UdpPeer pairs on loopback), with idle gaps between packets:
+//  - queued: from `send()` on one peer to `recvAll()` returning on the other
+//  - handlers: from `send()` on one peer to the handler being called on the Rx thread of the other
+// Usage: bm-rx-handler [Port] [Number of Samples]
+
+static constexpr long SAMPLE_GAP_US = 1000L;  // 1ms
+static constexpr long SAMPLE_TIMEOUT_US = 1000000L;  // 1s
+
+enum DELIVERY {
+    E_QUEUED = 0,
+    E_PACKET_HANDLER,
+    E_BATCH_HANDLER
+};
+
+static bool run(const DELIVERY& delivery, const uint16_t& port, const size_t& numberOfSamples) {
+    // Time at which the last packet was handled, -1 if none
+    std::atomic<int64_t> handledUs{-1};
+
+    comm::EndpointConfig config;
+    if (E_PACKET_HANDLER == delivery) {
+        config.rxPacketHandler = [&handledUs](std::unique_ptr<comm::Packet>& pPacket) {
+            (void)pPacket;
+            handledUs = get_elapsed_realtime_us();
+        };
+    } else if (E_BATCH_HANDLER == delivery) {
+        config.rxBatchHandler = [&handledUs](std::deque<std::unique_ptr<comm::Packet>>& pPackets) {
+            (void)pPackets;
+            handledUs = get_elapsed_realtime_us();
+        };
+    }
+
+    std::unique_ptr<comm::P2P_Endpoint> pSender = comm::IP_Endpoint::createUdpPeer(port, "127.0.0.1", static_cast<uint16_t>(port + 1));
+    std::unique_ptr<comm::P2P_Endpoint> pReceiver = comm::IP_Endpoint::createUdpPeer(static_cast<uint16_t>(port + 1), "127.0.0.1", port, config);
+    if ((!pSender) || (!pReceiver)) {
+        LOGE("Could not create UdpPeers (ports: %u, %u)!!!\n", port, port + 1);
+        return false;
+    }
+
+    sleep_for(100000L);
+
+    const uint8_t payload[8] = {0};
+    std::vector<int64_t> latenciesUs;
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+    for (size_t i = 0; i < numberOfSamples; i++) {
+        sleep_for(SAMPLE_GAP_US);
+
+        handledUs = -1;
+        const int64_t sentUs = get_elapsed_realtime_us();
+        pSender->send(comm::Packet::create(payload, sizeof(payload)));
+
+        int64_t receivedUs = -1;
+        while ((0 > receivedUs) && (SAMPLE_TIMEOUT_US > (get_elapsed_realtime_us() - sentUs))) {
+            if (E_QUEUED == delivery) {
+                if (pReceiver->recvAll(pPackets)) {
+                    receivedUs = get_elapsed_realtime_us();
+                    pPackets.clear();
+                }
+            } else {
+                // Only the handler's timestamp matters, the main thread must not compete with the Rx thread
+                sleep_for(100L);
+                receivedUs = handledUs;
+            }
+        }
+
+        if (0 > receivedUs) {
+            LOGE("Packet %zu was lost!!!\n", i);
+        } else {
+            latenciesUs.push_back(receivedUs - sentUs);
+        }
+    }
+
+    if (latenciesUs.empty()) {
+        return false;
+    }
+
+    const char* const names[] = {"Queued (recvAll)", "Packet handler", "Batch handler"};
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    LOGI("%-17s | p50 %5lld us | p90 %5lld us | p99 %5lld us | max %6lld us (%zu samples)\n", names[delivery],
+         static_cast<long long>(latenciesUs[latenciesUs.size() / 2]),
+         static_cast<long long>(latenciesUs[latenciesUs.size() * 9 / 10]),
+         static_cast<long long>(latenciesUs[latenciesUs.size() * 99 / 100]),
+         static_cast<long long>(latenciesUs.back()), latenciesUs.size());
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = (1 < argc) ? static_cast<uint16_t>(atoi(argv[1])) : 42000U;
+    const size_t numberOfSamples = (2 < argc) ? static_cast<size_t>(atol(argv[2])) : 2000UL;
+
+    const DELIVERY deliveries[] = {E_QUEUED, E_PACKET_HANDLER, E_BATCH_HANDLER};
+    for (const DELIVERY& delivery : deliveries) {
+        run(delivery, port, numberOfSamples);
+        port = static_cast<uint16_t>(port + 2);
+    }
+
+    return 0;
+}
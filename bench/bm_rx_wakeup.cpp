@@ -0,0 +1,87 @@
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+#include "common.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Idle CPU usage & wakeup latency of endpoints (UdpPeer pairs on loopback):
+//  - idle CPU: process CPU time while all endpoints are connected but no data is exchanged
+//  - wakeup latency: from `send()` on one peer to `recvAll()` returning on the other, with idle gaps in between
+
+static constexpr size_t NUMBER_OF_PAIRS = 4UL;
+static constexpr long IDLE_PERIOD_US = 2000000L;  // 2s
+static constexpr size_t NUMBER_OF_SAMPLES = 1000UL;
+static constexpr long SAMPLE_GAP_US = 2000L;  // 2ms
+
+static int64_t get_cpu_time_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000LL + ts.tv_nsec / 1000L;
+}
+
+int main(int argc, char** argv) {
+    const uint16_t basePort = (1 < argc) ? static_cast<uint16_t>(atoi(argv[1])) : 40000U;
+
+    std::vector<std::unique_ptr<comm::IP_Endpoint>> pEndpoints;
+    for (size_t i = 0; i < NUMBER_OF_PAIRS; i++) {
+        const uint16_t portA = static_cast<uint16_t>(basePort + 2 * i);
+        const uint16_t portB = static_cast<uint16_t>(portA + 1);
+        pEndpoints.push_back(comm::IP_Endpoint::createUdpPeer(portA, "127.0.0.1", portB));
+        pEndpoints.push_back(comm::IP_Endpoint::createUdpPeer(portB, "127.0.0.1", portA));
+        if ((nullptr == pEndpoints[2 * i]) || (nullptr == pEndpoints[2 * i + 1])) {
+            LOGE("Could not create UdpPeers (ports: %u, %u)!!!\n", portA, portB);
+            return 1;
+        }
+    }
+
+    // Idle CPU
+    sleep_for(100000L);
+    const int64_t cpu0 = get_cpu_time_us();
+    const auto t0 = monotonic_now();
+    sleep_for(IDLE_PERIOD_US);
+    const int64_t cpuUs = get_cpu_time_us() - cpu0;
+    const int64_t wallUs = get_elapsed_realtime_us(t0);
+
+    LOGI("Idle CPU: %.2f%% of a core (%zu endpoints, %lld us CPU in %lld us)\n",
+         100.0 * static_cast<double>(cpuUs) / static_cast<double>(wallUs), pEndpoints.size(),
+         static_cast<long long>(cpuUs), static_cast<long long>(wallUs));
+
+    // Wakeup latency
+    const uint8_t payload[8] = {0};
+    std::vector<int64_t> latenciesUs;
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+    for (size_t i = 0; i < NUMBER_OF_SAMPLES; i++) {
+        sleep_for(SAMPLE_GAP_US);
+
+        const auto ts = monotonic_now();
+        pEndpoints[0]->send(comm::Packet::create(payload, sizeof(payload)));
+        while (pPackets.empty() && (1000000L > get_elapsed_realtime_us(ts))) {
+            pEndpoints[1]->recvAll(pPackets);
+        }
+
+        if (pPackets.empty()) {
+            LOGE("Packet %zu was lost!!!\n", i);
+        } else {
+            latenciesUs.push_back(get_elapsed_realtime_us(ts));
+            pPackets.clear();
+        }
+    }
+
+    if (latenciesUs.empty()) {
+        return 1;
+    }
+
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    LOGI("Wakeup latency (us): p50 %lld, p90 %lld, p99 %lld, max %lld (%zu samples)\n",
+         static_cast<long long>(latenciesUs[latenciesUs.size() / 2]),
+         static_cast<long long>(latenciesUs[latenciesUs.size() * 9 / 10]),
+         static_cast<long long>(latenciesUs[latenciesUs.size() * 99 / 100]),
+         static_cast<long long>(latenciesUs.back()), latenciesUs.size());
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include "Encoder.hpp"
+#include "ShardedTcpServer.hpp"
+#include "common.hpp"
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Scaling of a sharded echo server (SO_REUSEPORT, shards pinned to CPUs) with the number of shards, on loopback.
+// Client threads connect raw sockets (accept rate), then each of them writes one request to each of its sockets &
+// reads the echoes back, round after round (echo throughput).
+// Usage: bm-sharded-server [Port] [Number of Connections] [Number of Rounds]
+
+static constexpr size_t NUMBER_OF_CLIENT_THREADS = 4UL;
+static constexpr size_t PAYLOAD_SIZE = 64UL;
+static constexpr long ACCEPT_TIMEOUT_US = 10000000L;  // 10s
+
+struct Result {
+    size_t shards = 0UL;
+    double acceptsPerS = 0.0;
+    double echoesPerS = 0.0;
+};  // struct Result
+
+static bool read_exactly(const int& socketFd, uint8_t* const pBuffer, const size_t& size) {
+    size_t count = 0UL;
+    while (size > count) {
+        const ssize_t ret = recv(socketFd, pBuffer + count, size - count, 0);
+        if (0 >= ret) {
+            return false;
+        }
+        count += static_cast<size_t>(ret);
+    }
+
+    return true;
+}
+
+static void connect_clients(const uint16_t port, const size_t numberOfConnections, std::vector<int>* const pSocketFds) {
+    struct sockaddr_in serverAddr;
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    serverAddr.sin_port = htons(port);
+
+    for (size_t i = 0; i < numberOfConnections; i++) {
+        const int socketFd = socket(AF_INET, SOCK_STREAM, 0);
+        if (0 > socketFd) {
+            continue;
+        }
+
+        int enable = 1;
+        setsockopt(socketFd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        if (0 != connect(socketFd, (const struct sockaddr*)(&serverAddr), sizeof(serverAddr))) {
+            ::close(socketFd);
+            continue;
+        }
+
+        pSocketFds->push_back(socketFd);
+    }
+}
+
+static void echo(const std::vector<int>* const pSocketFds, const std::vector<std::unique_ptr<uint8_t[]>>* const pFrames,
+                 const size_t frameSize, std::atomic<size_t>* const pEchoes) {
+    std::unique_ptr<uint8_t[]> pBuffer(new uint8_t[frameSize]);
+    size_t echoes = 0UL;
+
+    for (auto& pFrame : *pFrames) {
+        for (auto& socketFd : *pSocketFds) {
+            if (static_cast<ssize_t>(frameSize) != send(socketFd, pFrame.get(), frameSize, 0)) {
+                return;
+            }
+        }
+
+        for (auto& socketFd : *pSocketFds) {
+            if (!read_exactly(socketFd, pBuffer.get(), frameSize)) {
+                return;
+            }
+            echoes++;
+        }
+    }
+
+    (*pEchoes) += echoes;
+}
+
+static bool run(const size_t& numberOfShards, const uint16_t& port, const size_t& numberOfConnections,
+                const size_t& numberOfRounds, Result& result) {
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < static_cast<int>(std::thread::hardware_concurrency()); cpu++) {
+        cpus.push_back(cpu);
+    }
+
+    std::unique_ptr<comm::ShardedTcpServer> pServer = comm::ShardedTcpServer::create(
+        port, numberOfShards, [](comm::P2P_Endpoint& client, std::unique_ptr<comm::Packet>& pPacket) { client.send(pPacket); },
+        comm::EndpointConfig(), cpus);
+    if (!pServer) {
+        return false;
+    }
+
+    // Accept rate
+    std::vector<std::vector<int>> socketFds(NUMBER_OF_CLIENT_THREADS);
+    std::vector<std::thread> clients;
+    const auto t0 = monotonic_now();
+    for (size_t i = 0; i < NUMBER_OF_CLIENT_THREADS; i++) {
+        clients.emplace_back(connect_clients, port, numberOfConnections / NUMBER_OF_CLIENT_THREADS, &socketFds[i]);
+    }
+
+    for (auto& client : clients) {
+        client.join();
+    }
+    clients.clear();
+
+    const size_t expected = (numberOfConnections / NUMBER_OF_CLIENT_THREADS) * NUMBER_OF_CLIENT_THREADS;
+    while ((expected > pServer->getNumberOfClients()) && (ACCEPT_TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+        sleep_for(100L);
+    }
+    const int64_t acceptUs = get_elapsed_realtime_us(t0);
+    const bool accepted = (expected == pServer->getNumberOfClients());
+
+    // Echo throughput: one frame per round (Transaction IDs must change from one packet to the next)
+    uint8_t payload[PAYLOAD_SIZE] = {0};
+    std::vector<std::unique_ptr<uint8_t[]>> pFrames(numberOfRounds);
+    size_t frameSize = 0UL;
+    for (size_t round = 0; round < numberOfRounds; round++) {
+        comm::encode(payload, sizeof(payload), static_cast<uint16_t>(round), pFrames[round], frameSize);
+    }
+
+    std::atomic<size_t> echoes{0UL};
+    const auto t1 = monotonic_now();
+    for (size_t i = 0; accepted && (i < NUMBER_OF_CLIENT_THREADS); i++) {
+        clients.emplace_back(echo, &socketFds[i], &pFrames, frameSize, &echoes);
+    }
+
+    for (auto& client : clients) {
+        client.join();
+    }
+    const int64_t echoUs = get_elapsed_realtime_us(t1);
+
+    for (auto& fds : socketFds) {
+        for (auto& socketFd : fds) {
+            ::close(socketFd);
+        }
+    }
+
+    if (!accepted || ((expected * numberOfRounds) != echoes.load())) {
+        LOGE("%zu shards: %zu/%zu clients accepted, %zu echoes!!!\n", numberOfShards, pServer->getNumberOfClients(), expected,
+             echoes.load());
+        return false;
+    }
+
+    result.shards = numberOfShards;
+    result.acceptsPerS = static_cast<double>(expected) * 1000000.0 / static_cast<double>(acceptUs);
+    result.echoesPerS = static_cast<double>(echoes.load()) * 1000000.0 / static_cast<double>(echoUs);
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = (1 < argc) ? static_cast<uint16_t>(atoi(argv[1])) : 27700U;  // Below the ephemeral port range
+    const size_t numberOfConnections = (2 < argc) ? static_cast<size_t>(atol(argv[2])) : 1000UL;
+    const size_t numberOfRounds = (3 < argc) ? static_cast<size_t>(atol(argv[3])) : 100UL;
+
+    std::vector<size_t> shardCounts = {1UL, 2UL, 4UL};
+    const size_t numberOfCpus = std::thread::hardware_concurrency();
+    for (size_t count = 8UL; count <= numberOfCpus; count *= 2UL) {
+        shardCounts.push_back(count);
+    }
+
+    std::vector<Result> results;
+    for (auto& shards : shardCounts) {
+        Result result;
+        if (run(shards, port++, numberOfConnections, numberOfRounds, result)) {
+            results.push_back(result);
+        }
+    }
+
+    LOGI("%zu connections (%zu client threads), %zu rounds of %zu-byte requests, %zu CPUs\n", numberOfConnections,
+         NUMBER_OF_CLIENT_THREADS, numberOfRounds, PAYLOAD_SIZE, numberOfCpus);
+    LOGI("%-6s | %12s | %12s\n", "Shards", "Accepts/s", "Echoes/s");
+    for (auto& result : results) {
+        LOGI("%-6zu | %12.1f | %12.1f\n", result.shards, result.acceptsPerS, result.echoesPerS);
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include "Encoder.hpp"
+#include "common.hpp"
+
+#include <memory>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Compares the Tx framing paths:
+//  - copy: `comm::encode()` allocates a buffer & copies the payload, then `write()`
+//  - scatter-gather: `comm::encodeHeader()` into a stack buffer, then `writev()` header/payload/trailer
+// Note: payloads are limited to `MAX_PAYLOAD_SIZE`, which is the largest case here.
+
+static constexpr size_t NUMBER_OF_PACKETS = 200000UL;
+
+static double to_mbps(const size_t& bytes, const int64_t& elapsedUs) {
+    return (0 < elapsedUs) ? (static_cast<double>(bytes) / static_cast<double>(elapsedUs)) : 0.0;
+}
+
+static int64_t frame_copy(const std::unique_ptr<uint8_t[]>& pPayload, const size_t& size, const int fd) {
+    std::unique_ptr<uint8_t[]> pEncodedData;
+    size_t encodedSize = 0UL;
+    uint16_t tid = 0;
+    volatile uint8_t sink = 0;
+
+    auto t0 = monotonic_now();
+    for (size_t i = 0; i < NUMBER_OF_PACKETS; i++) {
+        comm::encode(pPayload, size, tid++, pEncodedData, encodedSize);
+        sink = sink + pEncodedData[encodedSize - 1];
+        if ((0 <= fd) && (static_cast<ssize_t>(encodedSize) != ::write(fd, pEncodedData.get(), encodedSize))) {
+            LOGE("Failed to write: %d!!!\n", errno);
+            break;
+        }
+    }
+
+    return get_elapsed_realtime_us(t0);
+}
+
+static int64_t frame_scatter_gather(const std::unique_ptr<uint8_t[]>& pPayload, const size_t& size, const int fd) {
+    uint8_t header[comm::FRAME_HEADER_SIZE];
+    uint8_t trailer = comm::EF;
+    struct iovec iov[] = {
+        {header, comm::FRAME_HEADER_SIZE},
+        {pPayload.get(), size},
+        {&trailer, comm::EF_SIZE}};
+    const ssize_t encodedSize = static_cast<ssize_t>(comm::FRAME_HEADER_SIZE + size + comm::EF_SIZE);
+    uint16_t tid = 0;
+    volatile uint8_t sink = 0;
+
+    auto t0 = monotonic_now();
+    for (size_t i = 0; i < NUMBER_OF_PACKETS; i++) {
+        comm::encodeHeader(size, tid++, header);
+        sink = sink + header[1];
+        if ((0 <= fd) && (encodedSize != ::writev(fd, iov, 3))) {
+            LOGE("Failed to write: %d!!!\n", errno);
+            break;
+        }
+    }
+
+    return get_elapsed_realtime_us(t0);
+}
+
+static int64_t run(const std::unique_ptr<uint8_t[]>& pPayload, const size_t& size, const bool scatterGather, const bool withSyscall) {
+    if (!withSyscall) {
+        return scatterGather ? frame_scatter_gather(pPayload, size, -1) : frame_copy(pPayload, size, -1);
+    }
+
+    int fds[2];
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, fds)) {
+        LOGE("Could not create socket pair: %d!!!\n", errno);
+        return 0;
+    }
+
+    std::thread drain([&fds]() {
+        std::unique_ptr<uint8_t[]> pBuffer(new uint8_t[65536]);
+        while (0 < ::read(fds[1], pBuffer.get(), 65536)) {
+        }
+    });
+
+    int64_t elapsedUs = scatterGather ? frame_scatter_gather(pPayload, size, fds[0]) : frame_copy(pPayload, size, fds[0]);
+
+    ::close(fds[0]);
+    drain.join();
+    ::close(fds[1]);
+
+    return elapsedUs;
+}
+
+int main() {
+    const size_t sizes[] = {64UL, 256UL, comm::MAX_PAYLOAD_SIZE};
+
+    LOGI("%zu packets per run, throughput in payload MB/s\n", NUMBER_OF_PACKETS);
+    LOGI("%-8s | %-10s | %-14s | %-10s | %-14s\n", "Payload", "Copy", "Scatter-gather", "Copy", "Scatter-gather");
+    LOGI("%-8s | %-27s | %-27s\n", "(bytes)", "Framing only", "Framing + write");
+
+    for (const size_t& size : sizes) {
+        std::unique_ptr<uint8_t[]> pPayload(new uint8_t[size]);
+        memset(pPayload.get(), 0xA5, size);
+        const size_t totalBytes = size * NUMBER_OF_PACKETS;
+
+        LOGI("%-8zu | %10.1f | %14.1f | %10.1f | %14.1f\n", size,
+             to_mbps(totalBytes, run(pPayload, size, false, false)),
+             to_mbps(totalBytes, run(pPayload, size, true, false)),
+             to_mbps(totalBytes, run(pPayload, size, false, true)),
+             to_mbps(totalBytes, run(pPayload, size, true, true)));
+    }
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+#include "common.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// UdpPeer pairs on loopback: one datagram per system call vs `recvmmsg()`/`sendmmsg()` batches, without & with
+// UDP segmentation offload (`UDP_SEGMENT`/`UDP_GRO`).
+// Packets are sent in bursts (which fit into default socket buffers), each burst is received before the next one is sent.
+// Payloads are sized so that each datagram carries a single packet.
+// Usage: bm-udp-batch [Port] [Number of Packets]
+
+static constexpr size_t BURST_SIZE = 128UL;
+static constexpr size_t PAYLOAD_SIZE = 512UL;
+static constexpr long BURST_TIMEOUT_US = 5000000L;  // 5s
+
+struct Result {
+    size_t batchSize = 0UL;
+    bool offload = false;
+    double packetsPerS = 0.0;
+    double megabytesPerS = 0.0;
+    double txSyscallsPerPacket = 0.0;
+    double rxSyscallsPerPacket = 0.0;
+    double txFillRatio = 0.0;
+    double rxFillRatio = 0.0;
+};  // struct Result
+
+static bool run(comm::P2P_Endpoint* const pSender, comm::P2P_Endpoint* const pReceiver, const size_t& numberOfPackets, Result& result) {
+    uint8_t payload[PAYLOAD_SIZE];
+    memset(payload, 0xA5, sizeof(payload));
+
+    sleep_for(100000L);
+    const comm::IoStats tx0 = pSender->getIoStats();
+    const comm::IoStats rx0 = pReceiver->getIoStats();
+
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+    size_t received = 0UL;
+    const auto t0 = monotonic_now();
+    for (size_t sent = 0UL; sent < numberOfPackets;) {
+        const size_t burst = ((numberOfPackets - sent) < BURST_SIZE) ? (numberOfPackets - sent) : BURST_SIZE;
+        for (size_t i = 0; i < burst; i++) {
+            pSender->send(comm::Packet::create(payload, sizeof(payload)));
+        }
+        sent += burst;
+
+        const auto ts = monotonic_now();
+        while ((sent > received) && (BURST_TIMEOUT_US > get_elapsed_realtime_us(ts))) {
+            pReceiver->recvAll(pPackets);
+            received += pPackets.size();
+            pPackets.clear();
+        }
+
+        if (sent != received) {
+            LOGE("Received %zu/%zu packets!!!\n", received, sent);
+            return false;
+        }
+    }
+    const int64_t elapsedUs = get_elapsed_realtime_us(t0);
+
+    const comm::IoStats tx1 = pSender->getIoStats();
+    const comm::IoStats rx1 = pReceiver->getIoStats();
+
+    const double txBatches = static_cast<double>(tx1.txBatches - tx0.txBatches);
+    const double rxBatches = static_cast<double>(rx1.rxBatches - rx0.rxBatches);
+    const double batchSize = static_cast<double>(result.batchSize);
+
+    result.offload = pSender->getConfig().udpSegmentOffload && pReceiver->getConfig().udpSegmentOffload;
+    result.packetsPerS = static_cast<double>(numberOfPackets) * 1000000.0 / static_cast<double>(elapsedUs);
+    result.megabytesPerS = result.packetsPerS * static_cast<double>(PAYLOAD_SIZE) / 1000000.0;
+    result.txSyscallsPerPacket = static_cast<double>(tx1.txSyscalls - tx0.txSyscalls) / static_cast<double>(numberOfPackets);
+    result.rxSyscallsPerPacket = static_cast<double>(rx1.rxSyscalls - rx0.rxSyscalls) / static_cast<double>(numberOfPackets);
+    if (0.0 < txBatches) {
+        result.txFillRatio = static_cast<double>(tx1.txDatagrams - tx0.txDatagrams) / (txBatches * batchSize);
+    }
+    if (0.0 < rxBatches) {
+        result.rxFillRatio = static_cast<double>(rx1.rxDatagrams - rx0.rxDatagrams) / (rxBatches * batchSize);
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = (1 < argc) ? static_cast<uint16_t>(atoi(argv[1])) : 47000U;
+    const size_t numberOfPackets = (2 < argc) ? static_cast<size_t>(atol(argv[2])) : 200000UL;
+
+    std::vector<Result> results;
+    const struct {
+        size_t batchSize;
+        bool offload;
+    } settings[] = {{1UL, false}, {8UL, false}, {comm::MAX_UDP_BATCH_SIZE, false}, {comm::MAX_UDP_BATCH_SIZE, true}};
+    for (const auto& setting : settings) {
+        comm::EndpointConfig config;
+        config.udpBatchSize = setting.batchSize;
+        config.udpSegmentOffload = setting.offload;
+
+        const uint16_t portA = port++;
+        const uint16_t portB = port++;
+        std::unique_ptr<comm::P2P_Endpoint> pSender = comm::IP_Endpoint::createUdpPeer(portA, "127.0.0.1", portB, config);
+        std::unique_ptr<comm::P2P_Endpoint> pReceiver = comm::IP_Endpoint::createUdpPeer(portB, "127.0.0.1", portA, config);
+        Result result;
+        result.batchSize = setting.batchSize;
+        if (pSender && pReceiver && run(pSender.get(), pReceiver.get(), numberOfPackets, result)) {
+            results.push_back(result);
+        }
+    }
+
+    LOGI("%zu x %zu-byte packets, bursts of %zu\n", numberOfPackets, PAYLOAD_SIZE, BURST_SIZE);
+    LOGI("%-10s %-7s | %12s %8s | %16s %16s | %8s %8s\n", "Batch size", "Offload", "Packets/s", "MB/s", "Tx syscalls/pkt",
+         "Rx syscalls/pkt", "Tx fill", "Rx fill");
+    for (auto& result : results) {
+        LOGI("%-10zu %-7s | %12.0f %8.1f | %16.4f %16.4f | %8.3f %8.3f\n", result.batchSize, result.offload ? "yes" : "no",
+             result.packetsPerS, result.megabytesPerS, result.txSyscallsPerPacket, result.rxSyscallsPerPacket, result.txFillRatio,
+             result.rxFillRatio);
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+#include "common.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Wakeup latency per wait policy (UdpPeer pairs on loopback): from `send()` on one peer to `recvAll()` returning on
+// the other, with idle gaps in between. Both peers of a pair use the same policy.
+// Spinning threads need cores of their own: with fewer cores than spinning threads, latencies only get worse.
+// Usage: bm-wait-policy [Port] [Number of Samples]
+
+static constexpr long SAMPLE_GAP_US = 1000L;  // 1ms
+static constexpr int64_t BUCKET_LIMITS_US[] = {5, 10, 20, 50, 100, 200, 500, 1000, 5000};
+static constexpr size_t NUMBER_OF_BUCKETS = sizeof(BUCKET_LIMITS_US) / sizeof(BUCKET_LIMITS_US[0]) + 1UL;
+
+static int64_t get_cpu_time_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000LL + ts.tv_nsec / 1000L;
+}
+
+static bool run(const char* pName, const comm::EndpointConfig& config, const uint16_t& port, const size_t& numberOfSamples) {
+    std::unique_ptr<comm::P2P_Endpoint> pSender = comm::IP_Endpoint::createUdpPeer(port, "127.0.0.1", static_cast<uint16_t>(port + 1), config);
+    std::unique_ptr<comm::P2P_Endpoint> pReceiver = comm::IP_Endpoint::createUdpPeer(static_cast<uint16_t>(port + 1), "127.0.0.1", port, config);
+    if ((!pSender) || (!pReceiver)) {
+        LOGE("Could not create UdpPeers (ports: %u, %u)!!!\n", port, port + 1);
+        return false;
+    }
+
+    sleep_for(100000L);
+
+    const uint8_t payload[8] = {0};
+    std::vector<int64_t> latenciesUs;
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+    const int64_t cpu0 = get_cpu_time_us();
+    const auto t0 = monotonic_now();
+    for (size_t i = 0; i < numberOfSamples; i++) {
+        sleep_for(SAMPLE_GAP_US);
+
+        const auto ts = monotonic_now();
+        pSender->send(comm::Packet::create(payload, sizeof(payload)));
+        while (pPackets.empty() && (1000000L > get_elapsed_realtime_us(ts))) {
+            pReceiver->recvAll(pPackets);
+        }
+
+        if (pPackets.empty()) {
+            LOGE("Packet %zu was lost!!!\n", i);
+        } else {
+            latenciesUs.push_back(get_elapsed_realtime_us(ts));
+            pPackets.clear();
+        }
+    }
+    const int64_t cpuUs = get_cpu_time_us() - cpu0;
+    const int64_t wallUs = get_elapsed_realtime_us(t0);
+
+    if (latenciesUs.empty()) {
+        return false;
+    }
+
+    size_t histogram[NUMBER_OF_BUCKETS] = {0};
+    for (const int64_t& latencyUs : latenciesUs) {
+        size_t bucket = 0UL;
+        while ((bucket < (NUMBER_OF_BUCKETS - 1UL)) && (BUCKET_LIMITS_US[bucket] <= latencyUs)) {
+            bucket++;
+        }
+        histogram[bucket]++;
+    }
+
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    LOGI("%s: p50 %lld us, p99 %lld us, max %lld us, CPU %.0f%% of a core (%zu samples)\n", pName,
+         static_cast<long long>(latenciesUs[latenciesUs.size() / 2]),
+         static_cast<long long>(latenciesUs[latenciesUs.size() * 99 / 100]),
+         static_cast<long long>(latenciesUs.back()),
+         100.0 * static_cast<double>(cpuUs) / static_cast<double>(wallUs), latenciesUs.size());
+
+    int64_t lowerLimitUs = 0;
+    for (size_t i = 0; i < NUMBER_OF_BUCKETS; i++) {
+        const size_t barLength = histogram[i] * 50UL / latenciesUs.size();
+        if (i < (NUMBER_OF_BUCKETS - 1UL)) {
+            LOGI("  [%5lld, %5lld) us %6zu %s\n", static_cast<long long>(lowerLimitUs), static_cast<long long>(BUCKET_LIMITS_US[i]),
+                 histogram[i], std::string(barLength, '#').c_str());
+            lowerLimitUs = BUCKET_LIMITS_US[i];
+        } else {
+            LOGI("  [%5lld,   inf) us %6zu %s\n", static_cast<long long>(lowerLimitUs), histogram[i], std::string(barLength, '#').c_str());
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = (1 < argc) ? static_cast<uint16_t>(atoi(argv[1])) : 41000U;
+    const size_t numberOfSamples = (2 < argc) ? static_cast<size_t>(atol(argv[2])) : 2000UL;
+
+    comm::EndpointConfig config;
+    config.waitPolicy = comm::E_WAIT_BLOCK;
+    run("Block", config, port, numberOfSamples);
+
+    config.busyPollUs = 50;
+    run("Block + SO_BUSY_POLL (50us)", config, port += 2, numberOfSamples);
+    config.busyPollUs = 0;
+
+    config.waitPolicy = comm::E_WAIT_HYBRID;
+    config.spinUs = comm::DEFAULT_SPIN_US;
+    run("Hybrid (spin 50us, then block)", config, port += 2, numberOfSamples);
+
+    config.waitPolicy = comm::E_WAIT_SPIN;
+    run("Spin", config, port += 2, numberOfSamples);
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+#ifndef __ASYNC_ENDPOINT_HPP__
+#define __ASYNC_ENDPOINT_HPP__
+
+#include "EventLoop.hpp"
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace comm {
+
+class AsyncTcpServer;
+
+static constexpr long LIVENESS_CHECK_US = 100000L;  // 100ms, rate at which pending receives check the endpoint
+
+/**
+ * @brief Awaitable wrapper of a P2P_Endpoint, driven by an EventLoop: `co_await recv()` & `co_await send()` suspend
+ * the calling coroutine instead of blocking the loop thread.
+ *
+ * Received packets are handed over by `EndpointConfig::rxPacketHandler` (the wrapper owns it). With a Reactor
+ * (`EndpointConfig::pReactor`), a single loop thread & a few I/O threads serve thousands of endpoints.
+ * Objects must be created, used & destroyed on the loop thread (or before `run()`), & must not outlive the loop.
+ */
+class AsyncEndpoint {
+   private:
+    /**
+     * @brief State shared with the Rx handler & pending awaiters.
+     */
+    struct State {
+        explicit State(EventLoop& loop) : loop(loop) {}
+
+        EventLoop& loop;
+        P2P_Endpoint* pEndpoint = nullptr;  // Loop thread only, nullptr once the wrapper is destroyed
+
+        std::mutex mutex;  // Guards the members below (shared with the Rx thread)
+        std::deque<std::unique_ptr<Packet>> packets;
+        std::coroutine_handle<> waiter;  // Coroutine suspended in `recv()`
+        uint64_t waitId = 0ULL;          // Tells liveness checks of successive waits apart
+    };  // struct State
+
+   public:
+    class RecvAwaiter {
+       public:
+        explicit RecvAwaiter(const std::shared_ptr<State>& pState) : mpState(pState) {}
+
+        bool await_ready();
+        bool await_suspend(std::coroutine_handle<> handle);
+        std::unique_ptr<Packet> await_resume();
+
+       private:
+        std::shared_ptr<State> mpState;
+    };  // class RecvAwaiter
+
+    class SendAwaiter {
+       public:
+        SendAwaiter(const std::shared_ptr<State>& pState, std::unique_ptr<Packet>&& pPacket)
+            : mpState(pState), mpPacket(std::move(pPacket)) {}
+
+        bool await_ready();
+        void await_suspend(std::coroutine_handle<> handle);
+        bool await_resume() {
+            return mResult;
+        }
+
+       private:
+        std::shared_ptr<State> mpState;
+        std::unique_ptr<Packet> mpPacket;
+        bool mResult = false;
+    };  // class SendAwaiter
+
+    ~AsyncEndpoint();
+
+    /**
+     * @brief Create a UdpPeer driven by an EventLoop, see `IP_Endpoint::createUdpPeer()`.
+     * `config.rxPacketHandler` & `config.rxBatchHandler` are ignored.
+     */
+    static std::unique_ptr<AsyncEndpoint> createUdpPeer(
+        EventLoop& loop, const uint16_t& localPort, const std::string& peerAddress, const uint16_t& peerPort,
+        const EndpointConfig& config = EndpointConfig());
+
+    /**
+     * @brief Create a TcpClient driven by an EventLoop, see `IP_Endpoint::createTcpClient()`.
+     * Note: the connection is established before returning.
+     */
+    static std::unique_ptr<AsyncEndpoint> createTcpClient(
+        EventLoop& loop, const std::string& serverAddr, const uint16_t& remotePort,
+        const EndpointConfig& config = EndpointConfig());
+
+    /**
+     * @brief `co_await recv()` returns the next received packet, or nullptr once the endpoint is dead.
+     */
+    RecvAwaiter recv() {
+        return RecvAwaiter(mpState);
+    }
+
+    /**
+     * @brief `co_await send(pPacket)` puts the packet into the Tx queue, waiting while the queue is full.
+     * Returns false if the endpoint died before.
+     */
+    SendAwaiter send(std::unique_ptr<Packet> pPacket) {
+        return SendAwaiter(mpState, std::move(pPacket));
+    }
+
+    /**
+     * @brief Return the underlying endpoint (counters, settings, ...).
+     */
+    P2P_Endpoint* getEndpoint() {
+        return mpEndpoint.get();
+    }
+
+    bool isAlive() {
+        return mpEndpoint->isAlive();
+    }
+
+   private:
+    friend class AsyncTcpServer;
+
+    AsyncEndpoint(const std::shared_ptr<State>& pState, std::unique_ptr<P2P_Endpoint>&& pEndpoint);
+
+    /**
+     * @brief Return the settings of an endpoint which hands its packets over to `pState`.
+     */
+    static EndpointConfig bindConfig(const std::shared_ptr<State>& pState, const EndpointConfig& config);
+
+    /**
+     * @brief Resume the coroutine waiting in `pState` if the endpoint has died, check again later otherwise.
+     */
+    static void checkLiveness(const std::shared_ptr<State>& pState, const uint64_t& waitId);
+
+    std::shared_ptr<State> mpState;
+    std::unique_ptr<P2P_Endpoint> mpEndpoint;
+};  // class AsyncEndpoint
+
+}  // namespace comm
+
+#endif  // __ASYNC_ENDPOINT_HPP__
@@ -0,0 +1,66 @@
+#ifndef __ASYNC_TCPSERVER_HPP__
+#define __ASYNC_TCPSERVER_HPP__
+
+#include "AsyncEndpoint.hpp"
+#include "EventLoop.hpp"
+#include "TcpServer.hpp"
+
+#include <coroutine>
+#include <memory>
+
+namespace comm {
+
+/**
+ * @brief Awaitable wrapper of a TcpServer: `co_await accept()` suspends the calling coroutine until a client connects.
+ * Same threading rules as AsyncEndpoint. A coroutine still waiting when the server is destroyed is never resumed.
+ */
+class AsyncTcpServer {
+   public:
+    class AcceptAwaiter {
+       public:
+        explicit AcceptAwaiter(AsyncTcpServer* const pServer) : mpServer(pServer) {}
+
+        bool await_ready();
+        void await_suspend(std::coroutine_handle<> handle);
+        std::unique_ptr<AsyncEndpoint> await_resume() {
+            return std::move(mpClient);
+        }
+
+       private:
+        AsyncTcpServer* mpServer;
+        std::unique_ptr<AsyncEndpoint> mpClient;
+        int mErrorCode = 0;
+    };  // class AcceptAwaiter
+
+    ~AsyncTcpServer();
+
+    /**
+     * @brief Create a TcpServer driven by an EventLoop, see `TcpServer::create()`.
+     *
+     * @param[in] loop The loop serving the server & its clients.
+     * @param[in] localPort The server shall listen on this port.
+     * @param[in] config Settings of accepted endpoints (`rxPacketHandler` & `rxBatchHandler` are ignored).
+     * @return A unique pointer to the AsyncTcpServer, or nullptr if an error occurs.
+     */
+    static std::unique_ptr<AsyncTcpServer> create(
+        EventLoop& loop, const uint16_t localPort, const EndpointConfig& config = EndpointConfig());
+
+    /**
+     * @brief `co_await accept()` returns the next client, or nullptr if an error occurs.
+     */
+    AcceptAwaiter accept() {
+        return AcceptAwaiter(this);
+    }
+
+   private:
+    AsyncTcpServer(EventLoop& loop, std::unique_ptr<TcpServer>&& pServer, const EndpointConfig& config)
+        : mLoop(loop), mpServer(std::move(pServer)), mConfig(config) {}
+
+    EventLoop& mLoop;
+    std::unique_ptr<TcpServer> mpServer;
+    const EndpointConfig mConfig;
+};  // class AsyncTcpServer
+
+}  // namespace comm
+
+#endif  // __ASYNC_TCPSERVER_HPP__
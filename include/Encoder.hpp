@@ -2,12 +2,13 @@
 #define __ENCODER_HPP__
 
 #include "Packet.hpp"
-#include "SyncQueue.hpp"
+#include "Queue.hpp"
 #include "common.hpp"
 
 #include <cstdint>
 #include <cstring>
 #include <deque>
+#include <functional>
 #include <memory>
 
 namespace comm {
@@ -26,27 +27,63 @@ namespace comm {
 bool encode(
     const std::unique_ptr<uint8_t[]>& pData, const size_t& size, const uint16_t& tid,
     std::unique_ptr<uint8_t[]>& pEncodedData, size_t& encodedSize);
+bool encode(
+    const uint8_t* const pData, const size_t& size, const uint16_t& tid,
+    std::unique_ptr<uint8_t[]>& pEncodedData, size_t& encodedSize);
+
+/**
+ * @brief Encodes the header (SF, Transaction ID & Size of Payload) of a frame.
+ *
+ * The payload and the trailer (`EF`) are expected to follow the header on the wire,
+ * so that they can be sent without being copied (e.g. scatter-gather I/O).
+ *
+ * @param[in] size Size in bytes of the payload, must be accepted by `validate_payload_size()`.
+ * @param[in] tid Transaction ID of the packet.
+ * @param[out] pHeader Pointer to the buffer (at least `FRAME_HEADER_SIZE` bytes) to store the header.
+ */
+void encodeHeader(const size_t& size, const uint16_t& tid, uint8_t* const pHeader);
+
+/**
+ * @brief Receives a decoded packet, may take it over (otherwise it is destroyed on return).
+ */
+typedef std::function<void(std::unique_ptr<Packet>& pPacket)> PacketHandler;
+
+/**
+ * @brief Receives the packets decoded from one input span, may take them over (the rest is destroyed on return).
+ */
+typedef std::function<void(std::deque<std::unique_ptr<Packet>>& pPackets)> PacketBatchHandler;
 
 enum DECODING_STATES {
     E_SF,
-    E_TID,
-    E_SIZE,
+    E_HEADER,
     E_PAYLOAD,
     E_VALIDATION
 };
 
 class Decoder {
    public:
-    Decoder() : mState(E_SF), mCachedTransactionId(-1) {}
+    /**
+     * @param[in] queueType Type of the queue of decoded packets, `dstruct::E_SPSC_QUEUE` requires
+     * a single thread feeding the decoder & a single thread dequeuing packets.
+     */
+    Decoder(const dstruct::QUEUE_TYPE& queueType = dstruct::E_SYNC_QUEUE) : mState(E_SF), mCachedTransactionId(-1) {
+        mpDecodedQueue = dstruct::Queue<Packet>::create(queueType, dstruct::SyncQueue<Packet>::DEFAULT_TIMEOUT_MS, dstruct::SyncQueue<Packet>::DEFAULT_CAP_LIMIT);
+        resetBuffer();
+    }
     virtual ~Decoder() { resetBuffer(); }
 
     /**
      * @brief Feeds data to the decoder.
      *
+     * The input is processed span by span, frames may be split at any byte across consecutive calls.
+     *
      * @param[in] pdata Pointer to the data to feed.
      * @param[in] size Size of the data to feed.
+     * @param[in] pOwner [Optional] The buffer containing the data. If provided, packets lying entirely within
+     * the input refer to (instead of copying) their payload and share the ownership of the buffer.
      */
     void feed(const std::unique_ptr<uint8_t[]>& pdata, const size_t& size);
+    void feed(const uint8_t* const pdata, const size_t& size, const std::shared_ptr<const void>& pOwner = nullptr);
 
     /**
      * @brief Dequeues a list of packets from the decoder.
@@ -57,11 +94,44 @@ class Decoder {
      */
     bool dequeue(std::deque<std::unique_ptr<Packet>>& pPackets, const bool wait = true);
 
+    /**
+     * @brief Hand decoded packets to a handler, on the feeding thread & without queueing, instead of queueing them.
+     * A packet handler is called for each packet as soon as it is decoded, a batch handler at the end of each `feed()`
+     * which decoded any packet. The packet handler takes precedence if both are set.
+     * Must not be called while the decoder is being fed.
+     */
+    void setHandlers(const PacketHandler& packetHandler, const PacketBatchHandler& batchHandler) {
+        mPacketHandler = packetHandler;
+        mBatchHandler = batchHandler;
+    }
+
    private:
     /**
-     * @brief Proceeds the next byte from input data.
+     * @brief Size of the header fields following SF: Transaction ID & Size of Payload.
+     */
+    static constexpr size_t HEADER_FIELDS_SIZE = SIZE_OF_TID + SIZE_OF_PAYLOAD_SIZE;
+
+    /**
+     * @brief Parses the header fields (Transaction ID & Size of Payload).
+     *
+     * @return True if the payload size is acceptable, false otherwise.
+     */
+    bool parseHeader(const uint8_t* const pHeader);
+
+    /**
+     * @brief Pushes a decoded packet to the queue.
+     */
+    void save(const uint8_t* const pPayload, const std::shared_ptr<const void>& pOwner = nullptr);
+
+    /**
+     * @brief Pushes a decoded packet to the queue, the packet takes over the payload.
+     */
+    void save(PooledBuffer&& pPayload);
+
+    /**
+     * @brief Hands a decoded packet to the packet handler, the current batch or the queue.
      */
-    void proceed(const uint8_t& b);
+    void deliver(std::unique_ptr<Packet>& pPacket);
 
     /**
      * @brief Resets the decoder's internal buffer.
@@ -70,13 +140,24 @@ class Decoder {
 
     DECODING_STATES mState;
 
+    uint8_t mHeader[HEADER_FIELDS_SIZE];
+    size_t mHeaderPos;
+
     size_t mPayloadSize;
-    std::unique_ptr<uint8_t[]> mpPayload;
+    size_t mPayloadPos;
+    PooledBuffer mpPayload;
+
+    int64_t mTimestampUs;
 
     /**
      * @brief Decoded packets shall be pushed to this queue.
      */
-    dstruct::SyncQueue<Packet> mDecodedQueue;
+    std::unique_ptr<dstruct::Queue<Packet>> mpDecodedQueue;
+
+    PacketHandler mPacketHandler;
+    PacketBatchHandler mBatchHandler;
+    std::deque<std::unique_ptr<Packet>> mBatch;  // Packets decoded by the current `feed()` (batch handler only)
+
     int mTransactionId;
     int mCachedTransactionId;
 };  // class Decoder
@@ -0,0 +1,170 @@
+#ifndef __EVENT_LOOP_HPP__
+#define __EVENT_LOOP_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+typedef int SOCKET;
+
+namespace comm {
+
+/**
+ * @brief Fire-and-forget coroutine, started by `EventLoop::spawn()` & destroyed when it returns.
+ * Exceptions escaping the coroutine terminate the process.
+ */
+class Task {
+   public:
+    struct promise_type {
+        Task get_return_object() {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };  // struct promise_type
+
+    Task(Task&& other) noexcept : mHandle(std::exchange(other.mHandle, nullptr)) {}
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        // Never spawned
+        if (mHandle) {
+            mHandle.destroy();
+        }
+    }
+
+    /**
+     * @brief Hand the coroutine over to the caller, which becomes responsible for resuming it.
+     */
+    std::coroutine_handle<> release() {
+        return std::exchange(mHandle, nullptr);
+    }
+
+   private:
+    explicit Task(const std::coroutine_handle<promise_type>& handle) : mHandle(handle) {}
+
+    std::coroutine_handle<promise_type> mHandle;
+};  // class Task
+
+/**
+ * @brief Single-threaded executor of coroutines (`Task`) & callbacks, built on epoll.
+ *
+ * `run()` executes posted callbacks, expired timers & socket watchers until `stop()` is called. Everything runs on the
+ * thread calling `run()`, hence callbacks must never block. Only `post()` & `stop()` may be called from other threads.
+ * Coroutines still suspended when the loop is destroyed are not resumed.
+ */
+class EventLoop {
+   public:
+    ~EventLoop();
+
+    /**
+     * @brief Create a new EventLoop object.
+     *
+     * @return A unique pointer to the EventLoop, or nullptr if an error occurs.
+     */
+    static std::unique_ptr<EventLoop> create();
+
+    /**
+     * @brief Run a callable on the loop thread, as soon as possible (thread-safe).
+     */
+    void post(std::function<void()> callback);
+
+    /**
+     * @brief Run a callable on the loop thread once a delay has elapsed (loop thread only).
+     */
+    void callAfter(const long& delayUs, std::function<void()> callback);
+
+    /**
+     * @brief Run a callable on the loop thread once the socket becomes readable (loop thread only).
+     * One-shot: the watcher must be renewed to be notified again.
+     *
+     * @return True on success, false otherwise.
+     */
+    bool watchReadable(const SOCKET& handle, std::function<void()> callback);
+
+    /**
+     * @brief Drop the watcher of a socket, if any (loop thread only).
+     */
+    void unwatch(const SOCKET& handle);
+
+    /**
+     * @brief Start a coroutine on the loop thread (thread-safe).
+     */
+    void spawn(Task task);
+
+    /**
+     * @brief Execute callbacks & coroutines on the calling thread until `stop()` is called.
+     */
+    void run();
+
+    /**
+     * @brief Request `run()` to return (thread-safe).
+     */
+    void stop();
+
+    /**
+     * @brief Return true if called from the thread executing `run()`.
+     */
+    bool isInLoopThread() const {
+        return std::this_thread::get_id() == mThreadId;
+    }
+
+    static constexpr size_t MAX_EVENTS = 256UL;
+    static constexpr int WAIT_TIMEOUT_MS = 100;
+
+   private:
+    EventLoop() {}
+
+    /**
+     * @brief Execute callbacks posted so far.
+     */
+    void runPosted();
+
+    /**
+     * @brief Execute expired timers, return the waiting time (in milliseconds) until the next one.
+     */
+    int runTimers();
+
+    void wakeUp();
+
+    int mEpollFd = -1;
+    int mEventFd = -1;  // Wakes up the loop: posted callbacks & termination
+    std::atomic<bool> mExitFlag{false};
+    std::thread::id mThreadId;
+
+    std::mutex mPostedMutex;
+    std::vector<std::function<void()>> mPosted;
+
+    std::multimap<std::chrono::steady_clock::time_point, std::function<void()>> mTimers;
+
+    // Sockets registered with epoll, callbacks are empty while disarmed
+    std::unordered_map<SOCKET, std::function<void()>> mWatchers;
+};  // class EventLoop
+
+}  // namespace comm
+
+#endif  // __EVENT_LOOP_HPP__
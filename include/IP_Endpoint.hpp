@@ -1,10 +1,13 @@
 #ifndef __IP_ENDPOINT_HPP__
 #define __IP_ENDPOINT_HPP__
 
+#include "IoUring.hpp"
 #include "P2P_Endpoint.hpp"
 
 #include <atomic>
 #include <memory>
+#include <string>
+#include <vector>
 
 #ifdef __WIN32__
 #include <WinDef.h>
@@ -12,25 +15,98 @@
 
 #else  // __WIN32__
 #include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 typedef int SOCKET;
 #endif  // __WIN32__
 
 namespace comm {
 
+#ifndef __WIN32__
+static constexpr uint16_t URING_RX_BUFFER_GROUP = 0U;
+static constexpr uint16_t URING_RX_BUFFER_COUNT = 64U;  // Power of 2
+static constexpr size_t URING_RX_BUFFER_SIZE = 2048UL;  // Not less than `MAX_FRAME_SIZE` (whole datagrams)
+static constexpr unsigned URING_RX_SQ_ENTRIES = URING_RX_BUFFER_COUNT + 2U;  // Recycled buffers, the receive & the wake-up
+static constexpr uint64_t URING_WAKEUP_USER_DATA = 1ULL;  // Tags the completion of the wake-up poll (receives are tagged 0)
+static constexpr unsigned URING_TX_DEPTH = 16U;        // Writes submitted at once
+static constexpr uint64_t URING_TX_CANCEL_USER_DATA = URING_TX_DEPTH;  // Tags completions of cancellations (writes are tagged by slot)
+static constexpr size_t URING_TX_COPY_LIMIT = 16UL;    // Smaller segments (headers, trailers) are copied
+static constexpr size_t UDP_GSO_BYTE_LIMIT = 65507UL;  // Payload of a segmented message (largest IPv4 UDP payload)
+#endif  // __WIN32__
+
 class IP_Endpoint : public P2P_Endpoint {
    public:
-    IP_Endpoint(const SOCKET& socketFd, const struct sockaddr_in& peerAddress) {
+    IP_Endpoint(const SOCKET& socketFd, const struct sockaddr_in& peerAddress, const EndpointConfig& config = EndpointConfig()) : P2P_Endpoint(config) {
         mSocketFd = socketFd;
         mPeerSockAddr = peerAddress;
+
+        int socketType = SOCK_STREAM;
+#ifdef __WIN32__
+        int optionLength = sizeof(socketType);
+#else   // __WIN32__
+        socklen_t optionLength = sizeof(socketType);
+#endif  // __WIN32__
+        if ((0 == getsockopt(mSocketFd, SOL_SOCKET, SO_TYPE, (char*)(&socketType), &optionLength)) &&
+            (SOCK_DGRAM == socketType) && (MAX_FRAME_SIZE < mConfig.txBatchByteLimit)) {
+            // Avoid IP Fragmentation
+            mConfig.txBatchByteLimit = MAX_FRAME_SIZE;
+        }
+        mStreamSocket = (SOCK_STREAM == socketType);
+
+#ifdef __WIN32__
+        mConfig.ioBackend = E_IO_SOCKET;
+        mConfig.udpBatchSize = 1UL;
+        mConfig.udpSegmentOffload = false;
+        mConfig.busyPollUs = 0;
+#else   // __WIN32__
+        if ((0 < mConfig.busyPollUs) &&
+            (0 != setsockopt(mSocketFd, SOL_SOCKET, SO_BUSY_POLL, &mConfig.busyPollUs, sizeof(mConfig.busyPollUs)))) {
+            LOGW("Failed to enable SO_BUSY_POLL: %d!\n", errno);
+            mConfig.busyPollUs = 0;
+        }
+
+        if ((E_IO_URING == mConfig.ioBackend) && !setupIoUring()) {
+            LOGW("Fall back to socket I/O!\n");
+            mConfig.ioBackend = E_IO_SOCKET;
+        }
+
+        if (mStreamSocket || (E_IO_SOCKET != mConfig.ioBackend)) {
+            mConfig.udpBatchSize = 1UL;
+            mConfig.udpSegmentOffload = false;
+        } else if (mConfig.udpSegmentOffload && !setupSegmentOffload()) {
+            LOGW("UDP segmentation offload is unavailable!\n");
+            mConfig.udpSegmentOffload = false;
+        }
+
+        if (1UL < mConfig.udpBatchSize) {
+            // Encoded datagrams never exceed `MAX_FRAME_SIZE` (see `txBatchByteLimit`)
+            mpTxDatagrams.reset(new uint8_t[mConfig.udpBatchSize * MAX_FRAME_SIZE]);
+        }
+
+        if (!mConfig.pReactor) {
+            mWakeUpFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (0 > mWakeUpFd) {
+                LOGW("Could not create eventfd: %d, threads will stop at their next timeout!\n", errno);
+            }
+        }
+#endif  // __WIN32__
+
         start();
     }
 
     virtual ~IP_Endpoint() {
         stop();
 
+#ifndef __WIN32__
+        if (0 <= mWakeUpFd) {
+            ::close(mWakeUpFd);
+        }
+#endif  // __WIN32__
+
         if (0 <= mSocketFd) {
 #ifdef __WIN32__
             closesocket(mSocketFd);
@@ -49,18 +125,54 @@ class IP_Endpoint : public P2P_Endpoint {
      * @param[in] localPort UdpPeer shall listen on this port.
      * @param[in] peerAddress The IP address of the peer.
      * @param[in] peerPort The port on which the peer shall listen.
+     * @param[in] config Endpoint settings.
      * @return A unique pointer to the TcpClient, or nullptr if an error occurs.
      */
-    static std::unique_ptr<IP_Endpoint> createUdpPeer(const uint16_t& localPort, const std::string& peerAddress, const uint16_t& peerPort);
+    static std::unique_ptr<IP_Endpoint> createUdpPeer(
+        const uint16_t& localPort, const std::string& peerAddress, const uint16_t& peerPort,
+        const EndpointConfig& config = EndpointConfig());
 
     /**
      * @brief Create a new TcpClient object.
      *
      * @param[in] serverAddr The IP address of the server.
      * @param[in] remotePort The port number of the server.
+     * @param[in] config Endpoint settings.
      * @return A unique pointer to the TcpClient, or nullptr if an error occurs.
      */
-    static std::unique_ptr<IP_Endpoint> createTcpClient(const std::string& serverAddr, const uint16_t& remotePort);
+    static std::unique_ptr<IP_Endpoint> createTcpClient(
+        const std::string& serverAddr, const uint16_t& remotePort,
+        const EndpointConfig& config = EndpointConfig());
+
+    /**
+     * @brief Create a non-blocking TCP socket & start connecting it to a server, without waiting.
+     *
+     * @param[out] socketFd The socket (closed if an error occurs).
+     * @param[out] remoteSocketAddr Address of the server.
+     * @return 1 if connected, 0 if the connection is in progress (see `pollConnects()`), -1 if an error occurs.
+     */
+    static int startConnect(
+        const std::string& serverAddr, const uint16_t& remotePort,
+        SOCKET& socketFd, struct sockaddr_in& remoteSocketAddr);
+
+    /**
+     * @brief Wait until sockets being connected are writable, i.e. connected or failed (see `getConnectError()`).
+     *
+     * @param[out] errorCode 0 on success or timeout, the error code otherwise.
+     * @param[in,out] pPollFds Sockets (`events` is set to `POLLOUT`), `revents` is set on return.
+     * @return Number of completed connections, 0 on timeout, -1 if an error occurs.
+     */
+    static int pollConnects(int& errorCode, struct pollfd* const pPollFds, const size_t& count, const int& timeoutMs);
+
+    /**
+     * @brief Return 0 if a socket reported by `pollConnects()` is connected, otherwise the reason (`SO_ERROR`).
+     */
+    static int getConnectError(const SOCKET socketFd);
+
+    /**
+     * @brief Close a socket which has not been handed over to an endpoint.
+     */
+    static void closeSocket(const SOCKET socketFd);
 
     /**
      * @brief Configure socket to allow Reuse of local addresses (SO_REUSEADDR) and Non-blocking I/O.
@@ -69,6 +181,26 @@ class IP_Endpoint : public P2P_Endpoint {
      */
     static int configureSocket(const SOCKET socketFd);
 
+    IoStats getIoStats() override {
+        IoStats stats;
+        stats.rxSyscalls = mRxSyscallCount;
+        stats.txSyscalls = mTxSyscallCount;
+        stats.rxDatagrams = mRxDatagramCount;
+        stats.rxBatches = mRxDatagramBatchCount;
+        stats.txDatagrams = mTxDatagramCount;
+        stats.txBatches = mTxDatagramBatchCount;
+
+        const double batchSize = static_cast<double>(mConfig.udpBatchSize);
+        if (0ULL < stats.rxBatches) {
+            stats.rxBatchFillRatio = static_cast<double>(stats.rxDatagrams) / (static_cast<double>(stats.rxBatches) * batchSize);
+        }
+        if (0ULL < stats.txBatches) {
+            stats.txBatchFillRatio = static_cast<double>(stats.txDatagrams) / (static_cast<double>(stats.txBatches) * batchSize);
+        }
+
+        return stats;
+    }
+
    protected:
     bool checkRxPipe() override {
         return !mErrorFlag;
@@ -78,14 +210,200 @@ class IP_Endpoint : public P2P_Endpoint {
         return !mErrorFlag;
     }
 
-    ssize_t lread(const std::unique_ptr<uint8_t[]>& pBuffer, const size_t& limit) override;
+    SOCKET getHandle() override {
+        return mSocketFd;
+    }
+
+    bool hasPendingTx() override {
+        return (mPendingTxOffset < mPendingTx.size());
+    }
+
+    int lwaitTx(const int& timeoutMs) override;
+    ssize_t lflushPendingTx() override;
+
+    int lwaitRx(const int& timeoutMs) override;
+    ssize_t lread(uint8_t* const pBuffer, const size_t& limit) override;
     ssize_t lwrite(const std::unique_ptr<uint8_t[]>& pData, const size_t& size) override;
+    ssize_t lwritev(const IoSegment* const pSegments, const size_t& count) override;
 
    private:
+    /**
+     * @brief Keep unsent bytes of segments (stream sockets), the first `writtenCount` bytes have been written.
+     *
+     * @return The size of the segments, which are entirely taken over.
+     */
+    ssize_t keepPendingTx(const IoSegment* const pSegments, const size_t& count, size_t writtenCount) {
+        size_t size = 0UL;
+        for (size_t i = 0; i < count; i++) {
+            size += pSegments[i].size;
+            if (writtenCount >= pSegments[i].size) {
+                writtenCount -= pSegments[i].size;
+            } else {
+                mPendingTx.insert(mPendingTx.end(), pSegments[i].pData + writtenCount, pSegments[i].pData + pSegments[i].size);
+                writtenCount = 0UL;
+            }
+        }
+
+        return static_cast<ssize_t>(size);
+    }
+
+    /**
+     * @brief Keep a datagram which cannot be sent yet (datagram sockets, reactor mode: I/O threads must never block),
+     * it is sent whole by `lflushPendingTx()`.
+     *
+     * @return The size of the datagram.
+     */
+    ssize_t keepPendingDatagram(const IoSegment* const pSegments, const size_t& count) {
+        size_t size = 0UL;
+        for (size_t i = 0; i < count; i++) {
+            mPendingTx.insert(mPendingTx.end(), pSegments[i].pData, pSegments[i].pData + pSegments[i].size);
+            size += pSegments[i].size;
+        }
+        mPendingDatagramSizes.push_back(size);
+
+        return static_cast<ssize_t>(size);
+    }
+
     SOCKET mSocketFd;
     struct sockaddr_in mPeerSockAddr;
+    bool mStreamSocket = false;
 
     std::atomic<bool> mErrorFlag{false};
+
+    /**
+     * @brief Pending output: bytes taken over by `lwritev()` but not written yet, only accessed by the Tx side.
+     */
+    std::vector<uint8_t> mPendingTx;
+    size_t mPendingTxOffset = 0UL;
+    std::vector<size_t> mPendingDatagramSizes;  // Datagram sockets: pending datagrams, stored back to back in `mPendingTx`
+    size_t mPendingDatagramIndex = 0UL;         // Next datagram to send
+
+    std::atomic<uint64_t> mRxSyscallCount{0ULL};
+    std::atomic<uint64_t> mTxSyscallCount{0ULL};
+    std::atomic<uint64_t> mRxDatagramCount{0ULL};
+    std::atomic<uint64_t> mRxDatagramBatchCount{0ULL};
+    std::atomic<uint64_t> mTxDatagramCount{0ULL};
+    std::atomic<uint64_t> mTxDatagramBatchCount{0ULL};
+
+#ifndef __WIN32__
+   protected:
+    ssize_t lflush() override;
+    void lwakeUp() override;
+
+   private:
+    /**
+     * @brief Write segments with `sendmsg()`, retrying if the socket would block.
+     */
+    ssize_t sendSegments(const IoSegment* const pSegments, const size_t& count);
+
+    /**
+     * @brief Read a batch of datagrams with `recvmmsg()`, packed one after another into the buffer.
+     */
+    ssize_t receiveDatagrams(uint8_t* const pBuffer, const size_t& limit);
+
+    /**
+     * @brief Read datagrams coalesced by `UDP_GRO`: frames are self-delimiting, so they are decoded as if read one by one.
+     */
+    ssize_t receiveCoalesced(uint8_t* const pBuffer, const size_t& limit);
+
+    /**
+     * @brief Enable `UDP_SEGMENT` (Tx) & `UDP_GRO` (Rx, copy mode only) if supported (called by the constructor).
+     *
+     * @return True if at least one direction is offloaded, false otherwise.
+     */
+    bool setupSegmentOffload();
+
+    /**
+     * @brief Copy a datagram into the Tx batch, which is written once full or by `lflush()`.
+     */
+    ssize_t queueDatagram(const IoSegment* const pSegments, const size_t& count);
+
+    /**
+     * @brief Write the Tx batch with `sendmmsg()`, waiting for room in the socket buffer if needed (dedicated Tx thread).
+     */
+    ssize_t sendDatagrams();
+
+    /**
+     * @brief Take over datagrams of the Tx batch from `first` on as pending output (see `keepPendingDatagram()`).
+     *
+     * @return The size of the datagrams.
+     */
+    ssize_t keepQueuedDatagrams(const size_t& first);
+
+    /**
+     * @brief io_uring backend: submit queued writes & reap their completions, unwritten bytes are kept as pending output.
+     * Writes never wait for room in the socket buffer, those still in flight after `TX_POLL_TIMEOUT_MS` are cancelled.
+     *
+     * @return The number of bytes written or kept, or -1 if an error occurs.
+     */
+    ssize_t flushTxRing();
+
+    /**
+     * @brief io_uring backend: create the rings & arm the multishot receive (called by the constructor).
+     *
+     * @return True on success, false if io_uring cannot be used.
+     */
+    bool setupIoUring();
+
+    /**
+     * @brief Queue a multishot receive, which keeps completing (one provided buffer each) until it is terminated.
+     */
+    bool armRx();
+
+    /**
+     * @brief Queue a poll on the wake-up eventfd, which completes once the endpoint stops.
+     */
+    bool armWakeUp();
+
+    int lwaitRxRing(const int& timeoutMs);
+    ssize_t lreadRing(uint8_t* const pBuffer, const size_t& limit);
+    ssize_t lwritevRing(const IoSegment* const pSegments, const size_t& count);
+
+    /**
+     * @brief A queued write: its message, segments & copies of small segments (which callers may reuse).
+     */
+    struct TxSlot {
+        struct msghdr message;
+        std::unique_ptr<struct iovec[]> pIov;
+        std::unique_ptr<uint8_t[]> pCopies;
+        size_t size;
+        int result;      // Result of the completion
+        bool completed;
+    };  // struct TxSlot
+
+    /**
+     * @brief io_uring backend: keep the bytes of a queued write from `writtenCount` on as pending output.
+     *
+     * @return The size of the write.
+     */
+    ssize_t keepTxSlot(const TxSlot& slot, const size_t& writtenCount);
+
+    // One ring per direction, so that Rx & Tx threads never share a ring
+    std::unique_ptr<IoUring> mpRxRing;
+    std::unique_ptr<IoUring> mpTxRing;
+
+    bool mRxArmed = false;
+    bool mWakeUpArmed = false;
+    bool mRxReceived = false;        // At least one receive succeeded
+    uint16_t mRxBufferId = 0U;       // Provided buffer being consumed by `lread()`
+    size_t mRxBufferOffset = 0UL;
+    size_t mRxBufferPending = 0UL;  // Bytes left in the buffer, 0 if none
+
+    std::unique_ptr<TxSlot[]> mpTxSlots;
+    size_t mTxSlotCapacity = 0UL;  // Segments per slot
+    unsigned mTxQueued = 0U;
+    struct io_uring_sqe* mpLastTxSqe = nullptr;
+
+    // UDP Tx batch: `udpBatchSize` datagrams of at most `MAX_FRAME_SIZE` bytes
+    std::unique_ptr<uint8_t[]> mpTxDatagrams;
+    size_t mTxDatagramSizes[MAX_UDP_BATCH_SIZE];
+    size_t mQueuedDatagrams = 0UL;
+
+    bool mUdpGso = false;  // Runs of equal-size datagrams are written as segmented messages
+    bool mUdpGro = false;  // Datagrams are received coalesced
+
+    int mWakeUpFd = -1;  // Readable once the endpoint stops, releases Rx & Tx threads from their waits (dedicated threads only)
+#endif  // __WIN32__
 };  // class Peer
 
 }  // namespace comm
@@ -0,0 +1,136 @@
+#ifndef __IO_URING_HPP__
+#define __IO_URING_HPP__
+
+#ifndef __WIN32__
+
+#include <cstddef>
+#include <cstdint>
+#include <linux/io_uring.h>
+#include <memory>
+
+namespace comm {
+
+/**
+ * @brief Minimal io_uring instance built on raw system calls (no liburing): one submission queue, one completion
+ * queue & an optional ring of provided buffers for receives.
+ * An instance is not thread-safe, it must only be used by one thread at a time.
+ */
+class IoUring {
+   public:
+    ~IoUring();
+
+    /**
+     * @brief Create a new IoUring object.
+     *
+     * @param[in] sqEntries Size of the submission queue.
+     * @param[in] cqEntries Size of the completion queue, 0 for the kernel's default (twice the submission queue).
+     * @return A unique pointer to the IoUring, or nullptr if io_uring is unavailable.
+     */
+    static std::unique_ptr<IoUring> create(const unsigned& sqEntries, const unsigned& cqEntries = 0U);
+
+    /**
+     * @brief Register a ring of provided buffers, from which receives with `IOSQE_BUFFER_SELECT` pick their buffer.
+     * If buffer rings are unsupported, legacy provided buffers are used instead: recycled buffers are then handed back
+     * by the next call to `enter()`, so the submission queue must hold `count` more entries than requests in flight.
+     *
+     * @param[in] groupId Buffer group ID (`sqe->buf_group`).
+     * @param[in] count Number of buffers, must be a power of 2.
+     * @param[in] bufferSize Size (in bytes) of each buffer.
+     * @return True on success, false otherwise.
+     */
+    bool setupBufferRing(const uint16_t& groupId, const uint16_t& count, const size_t& bufferSize);
+
+    /**
+     * @brief Return the provided buffer picked by a completion (`cqe->flags >> IORING_CQE_BUFFER_SHIFT`).
+     */
+    const uint8_t* getBuffer(const uint16_t& bufferId) const {
+        return mpBuffers.get() + (static_cast<size_t>(bufferId) * mBufferSize);
+    }
+
+    /**
+     * @brief Hand a provided buffer back to the kernel.
+     */
+    void recycleBuffer(const uint16_t& bufferId);
+
+    /**
+     * @brief Return a cleared submission entry, or nullptr if the submission queue is full.
+     * The entry is submitted by the next call to `enter()`.
+     */
+    struct io_uring_sqe* getSqe();
+
+    /**
+     * @brief Submit pending entries & wait for completions, in a single `io_uring_enter` call.
+     *
+     * @param[in] waitCount Number of completions to wait for, 0 to only submit.
+     * @param[in] timeoutMs The maximum waiting time, -1 for no limit.
+     * @return The number of submitted entries (0 on timeout or interruption), or -errno if an error occurs.
+     */
+    int enter(const unsigned& waitCount, const int& timeoutMs = -1);
+
+    /**
+     * @brief Return true if the completion queue is not empty.
+     */
+    bool hasCqe();
+
+    /**
+     * @brief Pop the oldest completion entry.
+     *
+     * @return True on success, false if the completion queue is empty.
+     */
+    bool popCqe(struct io_uring_cqe& cqe);
+
+    static constexpr uint64_t INTERNAL_USER_DATA = ~0ULL;  // Tags internal requests, not to be used by callers
+
+   private:
+    IoUring() {}
+
+    /**
+     * @brief Register a ring of `count` provided buffers (5.19).
+     */
+    bool registerBufferRing(const uint16_t& count);
+
+    /**
+     * @brief Return true if provided buffer rings work (probed once per process).
+     */
+    static bool isBufferRingSupported();
+    static bool probeBufferRing();
+
+    struct io_uring_cqe* peekRawCqe();
+    bool popRawCqe(struct io_uring_cqe& cqe);
+
+    int mRingFd = -1;
+
+    void* mpRingMemory = nullptr;
+    size_t mRingMemorySize = 0UL;
+    struct io_uring_sqe* mpSqes = nullptr;
+    size_t mSqesSize = 0UL;
+
+    // Submission queue
+    unsigned* mpSqHead = nullptr;
+    unsigned* mpSqTail = nullptr;
+    unsigned mSqMask = 0U;
+    unsigned mSqEntries = 0U;
+    unsigned mSqTail = 0U;  // Local tail, published by `enter()`
+
+    // Completion queue
+    unsigned* mpCqHead = nullptr;
+    unsigned* mpCqTail = nullptr;
+    unsigned mCqMask = 0U;
+    struct io_uring_cqe* mpCqes = nullptr;
+
+    // Provided buffers
+    struct io_uring_buf_ring* mpBufferRing = nullptr;
+    size_t mBufferRingSize = 0UL;
+    std::unique_ptr<uint8_t[]> mpBuffers;
+    size_t mBufferSize = 0UL;
+    uint16_t mBufferGroupId = 0U;
+    bool mLegacyBuffers = false;
+    uint16_t mBufferMask = 0U;
+    uint16_t mBufferTail = 0U;
+};  // class IoUring
+
+}  // namespace comm
+
+#endif  // __WIN32__
+
+#endif  // __IO_URING_HPP__
@@ -3,7 +3,10 @@
 
 #include "Encoder.hpp"
 #include "Packet.hpp"
-#include "SyncQueue.hpp"
+#include "SlabPool.hpp"
+#include "Queue.hpp"
+#include "Reactor.hpp"
+#include "Thread.hpp"
 
 #include <atomic>
 #include <cstdint>
@@ -13,6 +16,7 @@
 #include <mutex>
 #include <thread>
 #include <unistd.h>
+#include <vector>
 
 #ifdef __WIN32__
 #include <WinDef.h>
@@ -22,10 +26,7 @@
 
 namespace comm {
 
-static constexpr int RETRY_LIMIT = 5;
-static constexpr long RETRY_BREAK_US = 100000L;  // 100ms
-
-static constexpr long CONNECT_RETRY_BREAK_US = 100000L;  // 100ms
+static constexpr long CONNECT_TIMEOUT_MS = 1000L;  // 1s
 
 #ifdef __WIN32__
 static constexpr DWORD RX_TIMEOUT_S = 1;
@@ -33,9 +34,183 @@ static constexpr DWORD RX_TIMEOUT_S = 1;
 static constexpr time_t RX_TIMEOUT_S = 1LL;
 #endif  // __WIN32__
 
+static constexpr int RX_POLL_TIMEOUT_MS = 10;  // Idle Rx threads re-check the exit flag at this rate
+
+static constexpr int TX_POLL_TIMEOUT_MS = 10;  // Tx threads blocked by backpressure re-check the exit flag at this rate
+
 static constexpr int TX_RETRY_LIMIT = 3;
 static constexpr long TX_RETRY_BREAK_US = 1000L;  // 1ms
 
+static constexpr size_t DEFAULT_RX_SLAB_SIZE = 65536UL;  // 64KB
+
+static constexpr size_t MAX_IO_SEGMENTS = 1024UL;  // Not greater than IOV_MAX
+static constexpr size_t SEGMENTS_PER_FRAME = 3UL;   // Header, Payload & Trailer
+
+static constexpr size_t DEFAULT_TX_BATCH_PACKET_LIMIT = 64UL;
+static constexpr size_t MAX_TX_BATCH_PACKET_LIMIT = MAX_IO_SEGMENTS / SEGMENTS_PER_FRAME;
+static constexpr size_t DEFAULT_TX_BATCH_BYTE_LIMIT = 65536UL;  // 64KB
+
+static constexpr size_t MAX_UDP_BATCH_SIZE = 64UL;  // Datagrams per `recvmmsg()`/`sendmmsg()`
+static constexpr size_t UDP_GRO_BUFFER_SIZE = 65536UL;  // Room for a coalesced datagram (at most 64KB)
+
+/**
+ * @brief Transport backends of socket-based endpoints.
+ */
+enum IO_BACKEND {
+    E_IO_SOCKET = 0,  // One system call per read/write
+    E_IO_URING        // io_uring (Linux): multishot receives & Tx batches submitted at once
+};  // enum IO_BACKEND
+
+static constexpr long DEFAULT_SPIN_US = 50L;
+
+/**
+ * @brief How Rx & Tx threads wait for data (dedicated threads only, reactor threads always block).
+ */
+enum WAIT_POLICY {
+    E_WAIT_BLOCK = 0,  // Sleep until data arrives (lowest CPU usage)
+    E_WAIT_SPIN,       // Busy-wait with a pause hint (lowest latency, a core per thread)
+    E_WAIT_HYBRID      // Busy-wait for `spinUs`, then sleep
+};  // enum WAIT_POLICY
+
+/**
+ * @brief A contiguous chunk of data to be written (scatter-gather I/O).
+ */
+struct IoSegment {
+    const uint8_t* pData;
+    size_t size;
+};  // struct IoSegment
+
+/**
+ * @brief Endpoint settings, applied at creation time.
+ */
+struct EndpointConfig {
+    /**
+     * @brief Zero-copy receive: decoded packets refer to pooled Rx slabs instead of owning a copy of their payload.
+     * A slab is recycled once all packets referring to it have been destroyed.
+     */
+    bool zeroCopyRx = false;
+
+    /**
+     * @brief Size (in bytes) of Rx slabs (zero-copy receive only), must not be less than `MAX_FRAME_SIZE`.
+     */
+    size_t rxSlabSize = DEFAULT_RX_SLAB_SIZE;
+
+    /**
+     * @brief Maximum number of frames written at once, must not be greater than `MAX_TX_BATCH_PACKET_LIMIT`.
+     */
+    size_t txBatchPacketLimit = DEFAULT_TX_BATCH_PACKET_LIMIT;
+
+    /**
+     * @brief Maximum number of bytes written at once. A frame is never split, so a single frame may exceed this limit.
+     * Datagram-based endpoints cap it at `MAX_FRAME_SIZE` to avoid IP fragmentation.
+     */
+    size_t txBatchByteLimit = DEFAULT_TX_BATCH_BYTE_LIMIT;
+
+    /**
+     * @brief Type of the Tx queue, `dstruct::E_SPSC_QUEUE` requires `send()` to be called by a single thread.
+     */
+    dstruct::QUEUE_TYPE txQueueType = dstruct::E_SYNC_QUEUE;
+
+    /**
+     * @brief Direct send: `send()` encodes & writes the packet on the calling thread if nothing is queued & the Tx side
+     * is idle, which saves the hand-over to the Tx thread (request/response traffic). Otherwise it falls back to the
+     * Tx queue. Bytes which cannot be written at once are left to the Tx side (stream sockets).
+     */
+    bool directSend = false;
+
+    /**
+     * @brief Type of the Rx queue, `dstruct::E_SPSC_QUEUE` requires `recvAll()` to be called by a single thread.
+     */
+    dstruct::QUEUE_TYPE rxQueueType = dstruct::E_SYNC_QUEUE;
+
+    /**
+     * @brief If set, the endpoint is served by the I/O threads of this reactor instead of its own Rx & Tx threads.
+     */
+    std::shared_ptr<Reactor> pReactor;
+
+    /**
+     * @brief Transport backend. `E_IO_URING` falls back to `E_IO_SOCKET` if io_uring is unavailable, on Windows and in
+     * reactor mode.
+     */
+    IO_BACKEND ioBackend = E_IO_SOCKET;
+
+    /**
+     * @brief Maximum number of datagrams read or written by one system call (`recvmmsg()`/`sendmmsg()`, Linux),
+     * must not be greater than `MAX_UDP_BATCH_SIZE`. 1 for one datagram per call. Also scales the Rx buffer.
+     * Ignored by stream-based endpoints and by the io_uring backend.
+     */
+    size_t udpBatchSize = 1UL;
+
+    /**
+     * @brief UDP segmentation offload (Linux): runs of equal-size datagrams of a Tx batch (see `udpBatchSize`) are
+     * written as one message each (`UDP_SEGMENT`) & datagrams are received coalesced (`UDP_GRO`, copy mode only).
+     * Ignored by stream-based endpoints and by the io_uring backend, or if the kernel does not support it.
+     */
+    bool udpSegmentOffload = false;
+
+    /**
+     * @brief Wait policy of Rx & Tx threads.
+     */
+    WAIT_POLICY waitPolicy = E_WAIT_BLOCK;
+
+    /**
+     * @brief Busy-waiting period (in microseconds) of `E_WAIT_HYBRID`, before going to sleep.
+     */
+    long spinUs = DEFAULT_SPIN_US;
+
+    /**
+     * @brief If positive, `SO_BUSY_POLL` (Linux): blocking reads & waits poll the device queue for up to this period
+     * (in microseconds) instead of waiting for an interrupt. Raising it above `net.core.busy_poll` needs CAP_NET_ADMIN.
+     */
+    int busyPollUs = 0;
+
+    /**
+     * @brief Placement & scheduling of the Rx & Tx threads (dedicated threads only, see `pReactor`).
+     */
+    ThreadConfig rxThread;
+    ThreadConfig txThread;
+
+    /**
+     * @brief If set, decoded packets are handed to this callable on the Rx thread (or the reactor I/O thread), in order
+     * & without queueing: `recvAll()` then returns nothing. Lowest receive latency, but the handler delays further
+     * reads until it returns. Takes precedence over `rxBatchHandler`.
+     */
+    PacketHandler rxPacketHandler;
+
+    /**
+     * @brief Same as `rxPacketHandler`, but called once per read with all packets decoded from it.
+     */
+    PacketBatchHandler rxBatchHandler;
+};  // struct EndpointConfig
+
+/**
+ * @brief Tx counters, a batch is a group of frames written at once.
+ */
+struct TxStats {
+    uint64_t batches = 0ULL;
+    uint64_t packets = 0ULL;
+    uint64_t bytes = 0ULL;
+};  // struct TxStats
+
+/**
+ * @brief Lower layer counters: system calls issued by Rx & Tx paths.
+ */
+struct IoStats {
+    uint64_t rxSyscalls = 0ULL;
+    uint64_t txSyscalls = 0ULL;
+
+    /**
+     * @brief Datagram-based endpoints: datagrams & system calls which moved them (batches).
+     * Fill ratio: average number of datagrams per batch over the configured `udpBatchSize`.
+     */
+    uint64_t rxDatagrams = 0ULL;
+    uint64_t rxBatches = 0ULL;
+    double rxBatchFillRatio = 0.0;
+    uint64_t txDatagrams = 0ULL;
+    uint64_t txBatches = 0ULL;
+    double txBatchFillRatio = 0.0;
+};  // struct IoStats
+
 class P2P_Endpoint {
    public:
     virtual ~P2P_Endpoint() {}
@@ -51,6 +226,39 @@ class P2P_Endpoint {
      */
     bool recvAll(std::deque<std::unique_ptr<Packet>>& pRxPackets, const bool wait = true);
 
+    /**
+     * @brief Return a snapshot of Tx counters.
+     */
+    TxStats getTxStats();
+
+    /**
+     * @brief Return a snapshot of lower layer counters (none by default).
+     */
+    virtual IoStats getIoStats() {
+        return IoStats();
+    }
+
+    /**
+     * @brief Return the transport backend in use.
+     */
+    IO_BACKEND getIoBackend() const {
+        return mConfig.ioBackend;
+    }
+
+    /**
+     * @brief Return the settings in effect, i.e. after validation & fallbacks.
+     */
+    const EndpointConfig& getConfig() const {
+        return mConfig;
+    }
+
+    /**
+     * @brief Return the settings in effect for the Rx/Tx thread, as read by the thread itself once started.
+     * Default (empty) settings are returned before that, or in reactor mode.
+     */
+    ThreadConfig getRxThreadSettings();
+    ThreadConfig getTxThreadSettings();
+
     /**
      * @brief Return true if any internal thread is still alive.
      */
@@ -64,17 +272,48 @@ class P2P_Endpoint {
     }
 
    protected:
-    P2P_Endpoint() {
+    P2P_Endpoint(const EndpointConfig& config = EndpointConfig()) : mConfig(config), mDecoder(config.rxQueueType) {
+        mDecoder.setHandlers(mConfig.rxPacketHandler, mConfig.rxBatchHandler);
+
+        if (0 == mConfig.udpBatchSize) {
+            mConfig.udpBatchSize = 1UL;
+        } else if (MAX_UDP_BATCH_SIZE < mConfig.udpBatchSize) {
+            mConfig.udpBatchSize = MAX_UDP_BATCH_SIZE;
+        }
+
+        if (mConfig.zeroCopyRx && (MAX_FRAME_SIZE <= mConfig.rxSlabSize)) {
+            mpRxSlabPool = dstruct::SlabPool::create(mConfig.rxSlabSize);
+        } else {
+            // Room for a batch of datagrams, or a coalesced one
+            mConfig.zeroCopyRx = false;
+            mRxBufferSize = MAX_FRAME_SIZE * mConfig.udpBatchSize;
+            if (mConfig.udpSegmentOffload && (UDP_GRO_BUFFER_SIZE > mRxBufferSize)) {
+                mRxBufferSize = UDP_GRO_BUFFER_SIZE;
+            }
+            mpRxBuffer.reset(new uint8_t[mRxBufferSize]);
+        }
+
+        if (0 == mConfig.txBatchPacketLimit) {
+            mConfig.txBatchPacketLimit = 1UL;
+        } else if (MAX_TX_BATCH_PACKET_LIMIT < mConfig.txBatchPacketLimit) {
+            mConfig.txBatchPacketLimit = MAX_TX_BATCH_PACKET_LIMIT;
+        }
+
+        mpTxHeaders.reset(new uint8_t[mConfig.txBatchPacketLimit * FRAME_HEADER_SIZE]);
+        mpTxSegments.reset(new IoSegment[mConfig.txBatchPacketLimit * SEGMENTS_PER_FRAME]);
+
+        mpTxQueue = dstruct::Queue<Packet>::create(mConfig.txQueueType, dstruct::SyncQueue<Packet>::DEFAULT_TIMEOUT_MS, dstruct::SyncQueue<Packet>::DEFAULT_CAP_LIMIT);
         mTransactionId = 0;
     }
 
     /**
-     * @brief Start internal threads. The method must only be called by the constructor of a derived class.
+     * @brief Start internal threads (or register with the reactor). The method must only be called by the constructor of a derived class.
      */
     void start();
 
     /**
-     * @brief Stop internal threads. The method must only be called by the destructor of a derived class.
+     * @brief Stop internal threads (or unregister from the reactor). The method must only be called by the destructor of a derived class.
+     * Waiting threads are woken up & joined, so that nothing refers to the object once the method returns.
      */
     void stop();
 
@@ -98,6 +337,66 @@ class P2P_Endpoint {
      */
     virtual bool checkTxPipe() { return true; }
 
+    /**
+     * @brief Write a batch of encoded frames & update Tx counters.
+     *
+     * @return The number of bytes written, or -1 if an error occurs.
+     */
+    ssize_t flushTxBatch(const IoSegment* const pSegments, const size_t& numberOfPackets, const size_t& numberOfBytes);
+
+    /**
+     * @brief Return the handle (socket) which the reactor waits on, or `INVALID_HANDLE` if the endpoint does not have any.
+     */
+    virtual SOCKET getHandle() {
+        return INVALID_HANDLE;
+    }
+
+    /**
+     * @brief Wait until Rx buffer becomes readable, so that idle Rx threads do not spin on `lread()`.
+     * The default implementation does not wait.
+     *
+     * @param[in] timeoutMs The maximum waiting time.
+     * @return 1 if data (or an error condition) is pending, 0 on timeout, or -1 if an error occurs.
+     */
+    virtual int lwaitRx(const int& timeoutMs) {
+        (void)timeoutMs;
+        return 1;
+    }
+
+    /**
+     * @brief Return true if bytes taken over by `lwritev()` are still waiting to be written (e.g. after a short write
+     * on a congested stream socket). Nothing else is written until they are flushed by `lflushPendingTx()`.
+     */
+    virtual bool hasPendingTx() {
+        return false;
+    }
+
+    /**
+     * @brief Wait until Tx buffer becomes writable. The default implementation does not wait.
+     *
+     * @param[in] timeoutMs The maximum waiting time.
+     * @return 1 if Tx buffer is writable (or an error condition is pending), 0 on timeout, or -1 if an error occurs.
+     */
+    virtual int lwaitTx(const int& timeoutMs) {
+        (void)timeoutMs;
+        return 1;
+    }
+
+    /**
+     * @brief Release threads waiting in `lwaitRx()`/`lwaitTx()`, which return 0 (or data) without waiting from now on.
+     * Called by `stop()`. The default implementation does nothing: threads notice the exit flag at their next timeout.
+     */
+    virtual void lwakeUp() {}
+
+    /**
+     * @brief Write pending bytes (non-blocking).
+     *
+     * @return The number of bytes written, or -1 if an error occurs.
+     */
+    virtual ssize_t lflushPendingTx() {
+        return 0;
+    }
+
     /**
      * @brief Read Rx buffer (non-blocking).
      *
@@ -105,10 +404,11 @@ class P2P_Endpoint {
      * @param[in] limit The maximum number of bytes to read.
      * @return The number of bytes read from Rx buffer, or -1 if an error occurs.
      */
-    virtual ssize_t lread(const std::unique_ptr<uint8_t[]>& pBuffer, const size_t& limit) = 0;
+    virtual ssize_t lread(uint8_t* const pBuffer, const size_t& limit) = 0;
 
     /**
      * @brief Write data to Tx buffer (non-blocking).
+     * Stream-based endpoints take over whatever cannot be written at once (see `hasPendingTx()`).
      *
      * @param[in] pData Pointer to the data to write.
      * @param[in] size The size of the data to write.
@@ -116,19 +416,171 @@ class P2P_Endpoint {
      */
     virtual ssize_t lwrite(const std::unique_ptr<uint8_t[]>& pData, const size_t& size) = 0;
 
-    std::unique_ptr<std::thread> mpRxThread;
-    std::unique_ptr<std::thread> mpTxThread;
+    /**
+     * @brief Write a list of segments to Tx buffer as if they were contiguous (non-blocking).
+     * The default implementation gathers the segments into a temporary buffer and calls `lwrite()`.
+     *
+     * @param[in] pSegments Pointer to the segments to write.
+     * @param[in] count The number of segments.
+     * @return The number of bytes written, or -1 if an error occurs.
+     */
+    virtual ssize_t lwritev(const IoSegment* const pSegments, const size_t& count);
+
+    /**
+     * @brief Complete writes deferred by `lwrite()`/`lwritev()`, called once all batches of a Tx round are written.
+     * Segments passed to `lwritev()` must stay valid until then. The default implementation does nothing.
+     *
+     * @return The number of bytes written, or -1 if an error occurs.
+     */
+    virtual ssize_t lflush() {
+        return 0;
+    }
+
+    std::unique_ptr<Thread> mpRxThread;
+    std::unique_ptr<Thread> mpTxThread;
+    std::mutex mThreadSettingsMutex;
+    ThreadConfig mRxThreadSettings;
+    ThreadConfig mTxThreadSettings;
     std::atomic<bool> mRxAliveFlag{false};
     std::atomic<bool> mTxAliveFlag{false};
     std::atomic<bool> mExitFlag{false};
 
+    EndpointConfig mConfig;
+
    private:
+    friend class Reactor;
+
+    /**
+     * @brief Read from lower layer once & feed the decoder.
+     *
+     * @return The number of bytes read, or -1 if an error occurs.
+     */
+    ssize_t receive();
+
+    /**
+     * @brief Encode & write all packets in Tx queue.
+     *
+     * @param[in] wait If true, wait for packets if Tx queue is empty (at most the timeout of the queue).
+     * @return The number of bytes written, or -1 if an error occurs.
+     */
+    ssize_t transmit(const bool wait);
+
+    /**
+     * @brief Frames of a Tx round: encoded but not written yet, and bytes written so far.
+     */
+    struct TxRound {
+        size_t numberOfPackets = 0UL;
+        size_t numberOfBytes = 0UL;
+        ssize_t byteCount = 0;
+    };  // struct TxRound
+
+    /**
+     * @brief Encode a packet into the Tx batch, which is written first if the frame does not fit in.
+     * Invalid packets are skipped.
+     *
+     * @return 0 on success, or -1 if an error occurs.
+     */
+    int encodeTxPacket(Packet* const pPacket, TxRound& round);
+
+    /**
+     * @brief Write the rest of the Tx batch & complete deferred writes.
+     *
+     * @return The number of bytes written by the round, or -1 if an error occurs.
+     */
+    ssize_t completeTxRound(TxRound& round);
+
+    /**
+     * @brief Direct send: encode & write a packet on the calling thread.
+     *
+     * @return 1 if the packet was written (the packet is released), 0 if it must be queued, or -1 if an error occurs.
+     */
+    int sendDirect(std::unique_ptr<Packet>& pPacket);
+
+    /**
+     * @brief Direct send: lock the Tx side (batch, pending bytes, lower layer Tx) against `send()`.
+     * Returns an empty lock otherwise.
+     */
+    std::unique_lock<std::mutex> lockTx() {
+        return mConfig.directSend ? std::unique_lock<std::mutex>(mTxMutex) : std::unique_lock<std::mutex>();
+    }
+
+    /**
+     * @brief Rx thread: busy-poll `receive()` per the wait policy (no-op for `E_WAIT_BLOCK`).
+     *
+     * @return The number of bytes read, 0 if the spin ended without data, or -1 if an error occurs.
+     */
+    ssize_t spinRx();
+
+    /**
+     * @brief Rx thread: wait for data after `spinRx()` (or timeout, to check the exit flag).
+     *
+     * @return A positive value if data is ready, 0 on timeout, or -1 if an error occurs.
+     */
+    int waitRx();
+
+    /**
+     * @brief Tx thread: wait for packets per the wait policy (or timeout, to check the exit flag) & transmit them.
+     *
+     * @return The number of bytes written, or -1 if an error occurs.
+     */
+    ssize_t waitTransmit();
+
+    /**
+     * @brief Rx buffer, owned by each endpoint so that Rx threads never share it.
+     */
+    std::unique_ptr<uint8_t[]> mpRxBuffer;
+    size_t mRxBufferSize = MAX_FRAME_SIZE;
+
+    /**
+     * @brief Zero-copy receive: the slab being filled by `lread()` and its pool.
+     */
+    std::shared_ptr<dstruct::SlabPool> mpRxSlabPool;
+    std::shared_ptr<uint8_t> mpRxSlab;
+    size_t mRxSlabOffset = 0UL;
+
     Decoder mDecoder;
 
-    dstruct::SyncQueue<Packet> mTxQueue;
+    std::unique_ptr<dstruct::Queue<Packet>> mpTxQueue;
     uint16_t mTransactionId;
+
+    /**
+     * @brief Direct send: guards the Tx side, & counts packets queued but not written yet (written first).
+     */
+    std::mutex mTxMutex;
+    std::atomic<size_t> mTxBacklog{0UL};
+
+    /**
+     * @brief Tx batch: encoded headers & segments to write.
+     */
+    std::unique_ptr<uint8_t[]> mpTxHeaders;
+    std::unique_ptr<IoSegment[]> mpTxSegments;
+
+    /**
+     * @brief Reactor mode: I/O thread serving the endpoint & whether a Tx flush has been requested.
+     */
+    size_t mIoThreadIndex = 0UL;
+    std::atomic<bool> mTxNotified{false};
+    bool mTxWatched = false;  // Waiting for the socket to become writable (pending Tx bytes)
+
+    std::atomic<uint64_t> mTxBatchCount{0ULL};
+    std::atomic<uint64_t> mTxPacketCount{0ULL};
+    std::atomic<uint64_t> mTxByteCount{0ULL};
 };  // class P2P_Endpoint
 
+/**
+ * @brief Send the same packet to many endpoints (e.g. a status pushed to all clients of a server).
+ *
+ * The payload is shared instead of being copied for each endpoint: endpoints queue views of it (see `Packet::createView()`)
+ * & only encode frame headers, each with its own Transaction ID. Payloads up to `Packet::SMALL_PAYLOAD_SIZE` bytes
+ * are copied within the packets instead (as cheap as a view, without a reference count shared by Tx threads).
+ *
+ * @param[in] pEndpoints Destination endpoints.
+ * @param[in] pPacket The packet, released once all endpoints have written it.
+ * @return Number of endpoints which accepted the packet (see `P2P_Endpoint::send()`).
+ */
+size_t broadcast(const std::vector<P2P_Endpoint*>& pEndpoints, std::unique_ptr<Packet>&& pPacket);
+size_t broadcast(const std::vector<P2P_Endpoint*>& pEndpoints, const std::shared_ptr<Packet>& pPacket);
+
 }  // namespace comm
 
 #include "inline/P2P_Endpoint.inl"
@@ -1,6 +1,7 @@
 #ifndef __PACKET_HPP__
 #define __PACKET_HPP__
 
+#include "PacketPool.hpp"
 #include "common.hpp"
 
 #include <cstdint>
@@ -19,7 +20,25 @@ class Packet {
     Packet(const Packet&) = delete;
     Packet& operator=(const Packet&) = delete;
 
-    virtual ~Packet() {}
+    virtual ~Packet() {
+        releasePayload();
+    }
+
+    /**
+     * @brief Packet objects are allocated from `PacketPool`, compatible with `std::unique_ptr<Packet>`.
+     */
+    static void* operator new(std::size_t size) {
+        return PacketPool::allocate(size);
+    }
+
+    static void operator delete(void* pPacket, std::size_t size) {
+        PacketPool::deallocate(pPacket, size);
+    }
+
+    /**
+     * @brief Payloads up to this size are stored within the Packet object (no extra allocation).
+     */
+    static constexpr size_t SMALL_PAYLOAD_SIZE = 64UL;
 
     static std::unique_ptr<Packet> create(
         const std::unique_ptr<uint8_t[]>& pPayload,
@@ -31,8 +50,46 @@ class Packet {
         const size_t& payloadSize,
         const int64_t& timestampUs = -1);
 
-    const std::unique_ptr<uint8_t[]>& getPayload() {
-        return mpPayload;
+    /**
+     * @brief Creates a packet which takes over the given payload (no copy).
+     *
+     * @param[in] pPayload Payload allocated by `new[]`, released (by the packet) when the packet is destroyed.
+     * @param[in] payloadSize Size of the payload.
+     * @param[in] timestampUs Timestamp of the packet.
+     */
+    static std::unique_ptr<Packet> create(
+        std::unique_ptr<uint8_t[]>&& pPayload,
+        const size_t& payloadSize,
+        const int64_t& timestampUs = -1);
+
+    /**
+     * @brief Creates a packet which takes over the given payload (no copy).
+     *
+     * @param[in] pPayload Payload allocated by `PacketPool::allocateBuffer()`.
+     * @param[in] payloadSize Size of the payload, must not exceed the size of the buffer.
+     * @param[in] timestampUs Timestamp of the packet.
+     */
+    static std::unique_ptr<Packet> create(
+        PooledBuffer&& pPayload,
+        const size_t& payloadSize,
+        const int64_t& timestampUs = -1);
+
+    /**
+     * @brief Creates a packet which refers to (instead of copying) the given payload.
+     *
+     * @param[in] pPayload Pointer to the payload, must stay valid as long as `pOwner` is alive.
+     * @param[in] payloadSize Size of the payload.
+     * @param[in] pOwner The buffer containing the payload, the packet shares its ownership.
+     * @param[in] timestampUs Timestamp of the packet.
+     */
+    static std::unique_ptr<Packet> createView(
+        const uint8_t* const& pPayload,
+        const size_t& payloadSize,
+        const std::shared_ptr<const void>& pOwner,
+        const int64_t& timestampUs = -1);
+
+    const uint8_t* getPayload() {
+        return mpData;
     }
 
     const size_t& getPayloadSize() {
@@ -43,6 +100,13 @@ class Packet {
         return mTimestampUs;
     }
 
+    /**
+     * @brief Return true if the payload is not owned by the packet.
+     */
+    bool isView() {
+        return (nullptr != mpOwner);
+    }
+
    protected:
     Packet(
         const std::unique_ptr<uint8_t[]>& pPayload,
@@ -54,10 +118,48 @@ class Packet {
         const size_t& payloadSize,
         const int64_t& timestampUs);
 
+    Packet(
+        const uint8_t* const& pPayload,
+        const size_t& payloadSize,
+        const std::shared_ptr<const void>& pOwner,
+        const int64_t& timestampUs);
+
+    Packet(
+        uint8_t* const pPayload,
+        const size_t& capacity,
+        const size_t& payloadSize,
+        const int64_t& timestampUs);
+
    private:
-    std::unique_ptr<uint8_t[]> mpPayload;
+    /**
+     * @brief Returns the owned payload (if any) to `PacketPool`.
+     */
+    void releasePayload();
+
+    /**
+     * @brief Takes over the payload of another packet.
+     */
+    void moveFrom(Packet& other);
+
+    /**
+     * @brief Owned payload: allocated from `PacketPool` (copied payloads larger than `SMALL_PAYLOAD_SIZE`, adopted pooled buffers)
+     * or by `new[]` (adopted `std::unique_ptr<uint8_t[]>`).
+     */
+    uint8_t* mpPayload = nullptr;
+
+    /**
+     * @brief Size of the pool block pointed by `mpPayload`, 0 if it was allocated by `new[]`.
+     */
+    size_t mPayloadCapacity = 0UL;
+    std::shared_ptr<const void> mpOwner;
+    const uint8_t* mpData;
     size_t mPayloadSize;
     int64_t mTimestampUs;
+
+    /**
+     * @brief Small payloads are stored within the object.
+     */
+    uint8_t mInlinePayload[SMALL_PAYLOAD_SIZE];
 };  // class Packet
 
 }  // namespace comm
@@ -0,0 +1,91 @@
+#ifndef __PACKETPOOL_HPP__
+#define __PACKETPOOL_HPP__
+
+#include "common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace comm {
+
+class PoolDeleter;
+
+/**
+ * @brief Payload buffer allocated from `PacketPool`, ownership may be handed over to a Packet.
+ */
+typedef std::unique_ptr<uint8_t[], PoolDeleter> PooledBuffer;
+
+/**
+ * @brief Pool counters: a hit is an allocation served by recycled memory, a miss falls back to the heap.
+ */
+struct PoolStats {
+    uint64_t hits = 0ULL;
+    uint64_t misses = 0ULL;
+};  // struct PoolStats
+
+/**
+ * @brief Memory pool backing Packet objects & their payloads.
+ *
+ * Blocks are grouped in size classes (from `MIN_BLOCK_SIZE` up to `MAX_PAYLOAD_SIZE`, power of 2).
+ * Each thread keeps a cache of free blocks per size class, which is refilled from / drained to
+ * a shared pool in bulk, so that most allocations & deallocations do not take any lock.
+ * A block may be released by a thread other than the one which allocated it.
+ * Requests larger than the largest size class are forwarded to the heap.
+ */
+class PacketPool {
+   public:
+    PacketPool() = delete;
+
+    /**
+     * @brief Allocate a block of at least `size` bytes.
+     */
+    static void* allocate(const size_t& size);
+
+    /**
+     * @brief Return a block to the pool, `size` must be the one passed to `allocate()`.
+     */
+    static void deallocate(void* const pBlock, const size_t& size);
+
+    /**
+     * @brief Return a snapshot of pool counters.
+     */
+    static PoolStats getStats();
+
+    /**
+     * @brief Allocate a buffer of `size` bytes, which is returned to the pool when released.
+     */
+    static PooledBuffer allocateBuffer(const size_t& size);
+
+    static constexpr size_t MIN_BLOCK_SIZE = 64UL;
+    static constexpr size_t MAX_BLOCK_SIZE = MAX_PAYLOAD_SIZE;
+};  // class PacketPool
+
+/**
+ * @brief Returns a buffer to `PacketPool`, keeps the size it was allocated with.
+ */
+class PoolDeleter {
+   public:
+    PoolDeleter(const size_t& size = 0UL) : mSize(size) {}
+
+    void operator()(uint8_t* const pBlock) const {
+        PacketPool::deallocate(pBlock, mSize);
+    }
+
+    const size_t& getSize() const {
+        return mSize;
+    }
+
+   private:
+    size_t mSize;
+};  // class PoolDeleter
+
+inline PooledBuffer PacketPool::allocateBuffer(const size_t& size) {
+    // Size 0 is reserved for empty buffers (default deleter)
+    const size_t blockSize = (0UL < size) ? size : 1UL;
+    return PooledBuffer(static_cast<uint8_t*>(allocate(blockSize)), PoolDeleter(blockSize));
+}
+
+}  // namespace comm
+
+#endif  // __PACKETPOOL_HPP__
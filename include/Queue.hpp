@@ -0,0 +1,69 @@
+#ifndef __QUEUE_HPP__
+#define __QUEUE_HPP__
+
+#include <deque>
+#include <memory>
+
+namespace dstruct {
+
+enum QUEUE_TYPE {
+    E_SYNC_QUEUE = 0,  // Mutex & condition variable, any number of producers & consumers
+    E_SPSC_QUEUE       // Lock-free ring, a single producer thread & a single consumer thread
+};
+
+template <class T>
+class SyncQueue;
+
+template <class T>
+class SpscQueue;
+
+/**
+ * @brief Queue of owned items, the interface shared by `SyncQueue` & `SpscQueue`.
+ */
+template <class T>
+class Queue {
+   public:
+    virtual ~Queue() {}
+
+    /**
+     * @brief Move an item to the back of the queue (non-blocking).
+     *
+     * @return True if the item was queued, false if the queue is full (the item is kept by the caller).
+     */
+    virtual bool enqueue(std::unique_ptr<T>& pItem) = 0;
+    virtual bool enqueue(std::unique_ptr<T>&& pItem) = 0;
+
+    /**
+     * @brief Move all queued items to the back of `items`.
+     *
+     * @param[out] items Destination.
+     * @param[in] wait If true and the queue is empty, wait for an item (at most the timeout of the queue).
+     * @return True if any item was dequeued.
+     */
+    virtual bool dequeue(std::deque<std::unique_ptr<T>>& items, const bool wait = true) = 0;
+
+    /**
+     * @brief Return true if no item is queued, without taking any lock (e.g. to spin before a blocking `dequeue()`).
+     * Items may be enqueued meanwhile: only the consumer may rely on a false result.
+     */
+    virtual bool isEmpty() const = 0;
+
+    virtual void setTimeoutMs(const int timeoutMs) = 0;
+    virtual void setCapLimit(const size_t capLimit) = 0;
+
+    /**
+     * @brief Release consumers waiting in `dequeue()`, which no longer waits from now on (e.g. before joining them).
+     */
+    virtual void shutdown() = 0;
+
+    /**
+     * @brief Create a queue of the given type.
+     */
+    static std::unique_ptr<Queue<T>> create(const QUEUE_TYPE& type, const int timeoutMs, const size_t capLimit);
+};  // class Queue
+
+}  // namespace dstruct
+
+#include "inline/Queue.inl"
+
+#endif  // __QUEUE_HPP__
@@ -0,0 +1,120 @@
+#ifndef __REACTOR_HPP__
+#define __REACTOR_HPP__
+
+#include "Thread.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __WIN32__
+#include <winsock2.h>  // Need to link with Ws2_32.lib
+#else                  // __WIN32__
+typedef int SOCKET;
+#endif                 // __WIN32__
+
+namespace comm {
+
+class P2P_Endpoint;
+
+static constexpr SOCKET INVALID_HANDLE = static_cast<SOCKET>(~0);
+
+/**
+ * @brief Event loop serving many endpoints with a fixed pool of I/O threads.
+ *
+ * An endpoint created with `EndpointConfig::pReactor` does not start its own Rx/Tx threads: it is registered with
+ * the least loaded I/O thread, which reads & decodes its input when the socket becomes readable, and flushes its
+ * Tx queue after `send()`. `send()` & `recvAll()` keep working as with dedicated threads.
+ * I/O threads must never block: Rx packets are only queued (or passed to callbacks which must return quickly).
+ */
+class Reactor {
+   public:
+    ~Reactor();
+
+    /**
+     * @brief Create a new Reactor object & start its I/O threads.
+     *
+     * @param[in] numberOfThreads Number of I/O threads, 0 for one per hardware thread.
+     * @param[in] threadConfig Settings of all I/O threads.
+     * @return A shared pointer to the Reactor, or nullptr if an error occurs.
+     */
+    static std::shared_ptr<Reactor> create(const size_t& numberOfThreads = 0UL, const ThreadConfig& threadConfig = ThreadConfig());
+
+    size_t getNumberOfThreads() const {
+        return mIoThreads.size();
+    }
+
+    /**
+     * @brief Return the number of endpoints currently registered.
+     */
+    size_t getNumberOfEndpoints() const;
+
+    /**
+     * @brief Register an endpoint (called by `P2P_Endpoint::start()`).
+     *
+     * @return True on success, false otherwise.
+     */
+    bool attach(P2P_Endpoint* const pEndpoint);
+
+    /**
+     * @brief Unregister an endpoint (called by `P2P_Endpoint::stop()`).
+     * Once the method returns, I/O threads no longer refer to the endpoint.
+     */
+    void detach(P2P_Endpoint* const pEndpoint);
+
+    /**
+     * @brief Request the I/O thread serving the endpoint to flush its Tx queue (called by `P2P_Endpoint::send()`).
+     */
+    void notifyTx(P2P_Endpoint* const pEndpoint);
+
+    static constexpr size_t MAX_EVENTS = 256UL;     // Readiness events handled per wait
+    static constexpr size_t RX_READS_PER_EVENT = 8UL;  // Reads per readable endpoint before serving others
+    static constexpr int WAIT_TIMEOUT_MS = 100;
+
+   private:
+    struct IoThread;
+
+    Reactor();
+
+    /**
+     * @brief Loop of an I/O thread.
+     */
+    void run(IoThread* const pIoThread);
+
+    /**
+     * @brief Read & decode pending input of an endpoint, return false if the endpoint failed.
+     */
+    bool serveRx(P2P_Endpoint* const pEndpoint);
+
+    /**
+     * @brief Write pending bytes, then flush the Tx queue of an endpoint, return false if the endpoint failed.
+     */
+    bool serveTx(P2P_Endpoint* const pEndpoint);
+
+    /**
+     * @brief Wait for the socket of an endpoint to become writable while it has pending bytes, return false on failure.
+     */
+    bool watchTx(IoThread* const pIoThread, P2P_Endpoint* const pEndpoint);
+
+    /**
+     * @brief Unregister a failed endpoint from its I/O thread (called by the I/O thread).
+     */
+    void retire(IoThread* const pIoThread, P2P_Endpoint* const pEndpoint);
+
+    /**
+     * @brief Wake up an I/O thread blocked in waiting for events.
+     */
+    void wakeUp(IoThread* const pIoThread);
+
+    std::vector<std::unique_ptr<IoThread>> mIoThreads;
+    std::atomic<bool> mExitFlag{false};
+};  // class Reactor
+
+}  // namespace comm
+
+#endif  // __REACTOR_HPP__
@@ -0,0 +1,95 @@
+#ifndef __SHARDED_TCPSERVER_HPP__
+#define __SHARDED_TCPSERVER_HPP__
+
+#include "P2P_Endpoint.hpp"
+#include "Packet.hpp"
+#include "Reactor.hpp"
+#include "TcpServer.hpp"
+#include "Thread.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace comm {
+
+/**
+ * @brief Receives a packet from an accepted client, may take it over (otherwise it is destroyed on return).
+ * Called on the I/O thread of the shard serving the client, so it must return quickly.
+ */
+typedef std::function<void(P2P_Endpoint& client, std::unique_ptr<Packet>& pPacket)> ClientPacketHandler;
+
+/**
+ * @brief TCP server sharded across cores (Linux only).
+ *
+ * Each shard opens its own listening socket on the same port with `SO_REUSEPORT`: the kernel spreads incoming
+ * connections over shards. A shard accepts on its own thread and serves its clients with its own reactor I/O thread,
+ * so a client never leaves its shard: it is accepted, owned, served & destroyed there.
+ * Clients are destroyed by their shard once they are dead (e.g. closed by the peer), or with the server.
+ */
+class ShardedTcpServer {
+   public:
+    ~ShardedTcpServer();
+
+    /**
+     * @brief Create the shards & start serving.
+     *
+     * @param[in] localPort The server shall listen on this port.
+     * @param[in] numberOfShards Number of shards, 0 for one per hardware thread.
+     * @param[in] packetHandler Receives packets of all clients.
+     * @param[in] config Settings of accepted endpoints (`pReactor`, `rxPacketHandler` & `rxBatchHandler` are ignored).
+     * @param[in] cpus Threads of shard `i` run on CPU `cpus[i % cpus.size()]`, empty for any CPU.
+     * @return A unique pointer to the ShardedTcpServer, or nullptr if an error occurs.
+     */
+    static std::unique_ptr<ShardedTcpServer> create(
+        const uint16_t localPort, const size_t& numberOfShards, const ClientPacketHandler& packetHandler,
+        const EndpointConfig& config = EndpointConfig(), const std::vector<int>& cpus = std::vector<int>());
+
+    size_t getNumberOfShards() const {
+        return mShards.size();
+    }
+
+    /**
+     * @brief Return the number of clients currently owned by a shard.
+     */
+    size_t getNumberOfClients(const size_t& shardIndex) const;
+
+    /**
+     * @brief Return the number of clients currently owned by all shards.
+     */
+    size_t getNumberOfClients() const;
+
+    /**
+     * @brief Send a packet to all clients, its payload is shared by all of them (see `comm::broadcast()`).
+     *
+     * @return Number of clients which accepted the packet.
+     */
+    size_t broadcast(std::unique_ptr<Packet>&& pPacket);
+
+    static constexpr long ACCEPT_WAIT_MS = 100L;  // Also period of exit checks & of the cleanup of dead clients
+
+   private:
+    struct Shard;
+    struct ClientSlot;
+
+    ShardedTcpServer();
+
+    /**
+     * @brief Loop of the accepting thread of a shard.
+     */
+    void run(Shard* const pShard);
+
+    /**
+     * @brief Accept all pending connection requests of a shard.
+     */
+    void acceptAll(Shard* const pShard);
+
+    std::vector<std::unique_ptr<Shard>> mShards;
+    std::atomic<bool> mExitFlag{false};
+};  // class ShardedTcpServer
+
+}  // namespace comm
+
+#endif  // __SHARDED_TCPSERVER_HPP__
@@ -0,0 +1,76 @@
+#ifndef __SLABPOOL_HPP__
+#define __SLABPOOL_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dstruct {
+
+/**
+ * @brief Pool of fixed-size, reference-counted buffers (slabs).
+ *
+ * A slab acquired from the pool is returned to the pool (instead of being freed)
+ * once the last reference to it has been released.
+ */
+class SlabPool : public std::enable_shared_from_this<SlabPool> {
+   public:
+    virtual ~SlabPool() {
+        for (auto& pSlab : mFreeSlabs) {
+            delete[] pSlab;
+        }
+    }
+
+    /**
+     * @brief Create a new SlabPool object.
+     *
+     * @param[in] slabSize Size (in bytes) of each slab.
+     * @param[in] capLimit Maximum number of free slabs kept for recycling.
+     */
+    static std::shared_ptr<SlabPool> create(const size_t slabSize, const size_t capLimit = DEFAULT_CAP_LIMIT);
+
+    /**
+     * @brief Get a slab from the pool, allocate a new one if no free slab is available.
+     */
+    std::shared_ptr<uint8_t> acquire();
+
+    const size_t& getSlabSize() {
+        return mSlabSize;
+    }
+
+    static constexpr size_t DEFAULT_CAP_LIMIT = 16UL;
+
+   protected:
+    SlabPool(const size_t slabSize, const size_t capLimit) : mSlabSize(slabSize), mCapLimit(capLimit) {}
+
+   private:
+    /**
+     * @brief Returns a slab to the pool, or frees it if the pool is full.
+     */
+    void recycle(uint8_t* pSlab);
+
+    const size_t mSlabSize;
+    const size_t mCapLimit;
+
+    std::vector<uint8_t*> mFreeSlabs;
+    std::mutex mMutex;
+
+    friend struct SlabRecycler;
+};  // class SlabPool
+
+/**
+ * @brief Deleter of slabs: the slab goes back to its pool if the pool is still alive.
+ */
+struct SlabRecycler {
+    std::weak_ptr<SlabPool> mpPool;
+
+    void operator()(uint8_t* pSlab) const;
+};  // struct SlabRecycler
+
+}  // namespace dstruct
+
+#include "inline/SlabPool.inl"
+
+#endif  // __SLABPOOL_HPP__
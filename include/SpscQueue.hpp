@@ -0,0 +1,82 @@
+#ifndef __SPSCQUEUE_HPP__
+#define __SPSCQUEUE_HPP__
+
+#include "Queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace dstruct {
+
+/**
+ * @brief Bounded lock-free ring for exactly one producer thread & one consumer thread.
+ *
+ * Same contract as `SyncQueue`: `enqueue()` never blocks and fails if the queue is full,
+ * `dequeue()` moves all queued items & may wait (at most `timeoutMs`) while the queue is empty.
+ * Producer & consumer indices live in separate cache lines, each side caches the other's index
+ * so that the shared one is only read when the cached value says full (or empty).
+ * The producer only takes the lock to wake up a consumer which is actually waiting.
+ */
+template <class T>
+class SpscQueue : public Queue<T> {
+   public:
+    SpscQueue(const int timeoutMs = DEFAULT_TIMEOUT_MS, const size_t capLimit = DEFAULT_CAP_LIMIT);
+    virtual ~SpscQueue();
+
+    bool enqueue(std::unique_ptr<T>& pItem) override;
+    bool enqueue(std::unique_ptr<T>&& pItem) override;
+    bool dequeue(std::deque<std::unique_ptr<T>>& items, const bool wait = true) override;
+    bool isEmpty() const override;
+
+    void setTimeoutMs(const int timeoutMs) override;
+
+    /**
+     * @brief The ring is allocated at construction time, the limit is capped at its capacity.
+     */
+    void setCapLimit(const size_t capLimit) override;
+
+    void shutdown() override;
+
+    static constexpr int DEFAULT_TIMEOUT_MS = 10;
+    static constexpr size_t DEFAULT_CAP_LIMIT = 1024UL;
+    static constexpr size_t CACHE_LINE_SIZE = 64UL;
+
+   private:
+    /**
+     * @brief Move all published items to `items`, return the number of moved items (consumer only).
+     */
+    size_t drain(std::deque<std::unique_ptr<T>>& items);
+
+    // Read-only after construction
+    T** mpSlots;
+    size_t mCapacity;  // Power of 2
+    size_t mMask;
+    std::atomic<int> mTimeoutMs;
+    std::atomic<size_t> mCapLimit;
+    char mPadding0[CACHE_LINE_SIZE];
+
+    // Producer
+    std::atomic<size_t> mTail;
+    size_t mCachedHead;
+    char mPadding1[CACHE_LINE_SIZE];
+
+    // Consumer
+    std::atomic<size_t> mHead;
+    size_t mCachedTail;
+    std::atomic<bool> mWaiting;
+    char mPadding2[CACHE_LINE_SIZE];
+
+    std::mutex mMutex;
+    std::condition_variable mCv;
+    std::atomic<bool> mShutdown;
+};  // class SpscQueue
+
+}  // namespace dstruct
+
+#include "inline/SpscQueue.inl"
+
+#endif  // __SPSCQUEUE_HPP__
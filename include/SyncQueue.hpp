@@ -1,6 +1,8 @@
 #ifndef __SYNCQUEUE_HPP__
 #define __SYNCQUEUE_HPP__
 
+#include "Queue.hpp"
+
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -10,17 +12,19 @@
 namespace dstruct {
 
 template <class T>
-class SyncQueue {
+class SyncQueue : public Queue<T> {
    public:
     SyncQueue(const int timeoutMs = DEFAULT_TIMEOUT_MS, const size_t capLimit = DEFAULT_CAP_LIMIT) : mTimeoutMs(timeoutMs), mCapLimit(capLimit) {}
     virtual ~SyncQueue() {}
 
-    bool enqueue(std::unique_ptr<T>& pItem);
-    bool enqueue(std::unique_ptr<T>&& pItem);
-    bool dequeue(std::deque<std::unique_ptr<T>>& items, const bool wait = true);
+    bool enqueue(std::unique_ptr<T>& pItem) override;
+    bool enqueue(std::unique_ptr<T>&& pItem) override;
+    bool dequeue(std::deque<std::unique_ptr<T>>& items, const bool wait = true) override;
+    bool isEmpty() const override;
 
-    void setTimeoutMs(const int timeoutMs);
-    void setCapLimit(const size_t capLimit);
+    void setTimeoutMs(const int timeoutMs) override;
+    void setCapLimit(const size_t capLimit) override;
+    void shutdown() override;
 
     static constexpr int DEFAULT_TIMEOUT_MS = 10;
     static constexpr size_t DEFAULT_CAP_LIMIT = 1024UL;
@@ -29,8 +33,10 @@ class SyncQueue {
     std::deque<std::unique_ptr<T>> mQueue;
     std::mutex mMutex;
     std::condition_variable mCv;
+    std::atomic<size_t> mSize{0UL};  // Size of `mQueue`, written under `mMutex`, read by `isEmpty()` without it
     std::atomic<int> mTimeoutMs;
     std::atomic<std::size_t> mCapLimit;
+    std::atomic<bool> mShutdown{false};
 };  // class SyncQueue
 
 }  // namespace dstruct
@@ -0,0 +1,92 @@
+#ifndef __TCPCONNECTIONPOOL_HPP__
+#define __TCPCONNECTIONPOOL_HPP__
+
+#include "P2P_Endpoint.hpp"
+#include "TcpConnector.hpp"
+#include "Thread.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace comm {
+
+/**
+ * @brief Keeps warm connections to a server & hands them out on demand.
+ *
+ * A maintenance thread keeps `size` idle connections open: missing ones are connected in parallel (TcpConnector),
+ * e.g. at startup or once connections are handed out. Dead idle connections are replaced, failed connection requests
+ * are retried every `RECONNECT_BREAK_MS`.
+ */
+class TcpConnectionPool {
+   public:
+    ~TcpConnectionPool();
+
+    /**
+     * @brief Create a pool & start connecting.
+     *
+     * @param[in] serverAddr The IP address of the server.
+     * @param[in] remotePort The port number of the server.
+     * @param[in] size Number of idle connections to keep.
+     * @param[in] config Settings of connected endpoints (e.g. a shared `pReactor`).
+     * @param[in] threadConfig Settings of the maintenance thread.
+     * @return A unique pointer to the TcpConnectionPool, or nullptr if an error occurs.
+     */
+    static std::unique_ptr<TcpConnectionPool> create(
+        const std::string& serverAddr, const uint16_t& remotePort, const size_t& size,
+        const EndpointConfig& config = EndpointConfig(), const ThreadConfig& threadConfig = ThreadConfig());
+
+    /**
+     * @brief Take an idle connection, waiting for one if none is available.
+     *
+     * @param[in] timeout_ms Max. waiting time.
+     * @return A connected TcpClient, or nullptr on timeout.
+     */
+    std::unique_ptr<P2P_Endpoint> acquire(const long timeout_ms = 1000L);
+
+    /**
+     * @brief Give a connection back: it is kept if it is alive & the pool is not full, destroyed otherwise.
+     */
+    void release(std::unique_ptr<P2P_Endpoint>&& pClient);
+
+    /**
+     * @brief Return the number of idle connections.
+     */
+    size_t getNumberOfIdleConnections() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mIdleClients.size();
+    }
+
+    static constexpr long MAINTENANCE_PERIOD_MS = 100L;  // Also period of exit checks & of liveness checks
+    static constexpr long RECONNECT_BREAK_MS = 100L;
+
+   private:
+    TcpConnectionPool(const std::string& serverAddr, const uint16_t& remotePort, const size_t& size,
+                      const EndpointConfig& config)
+        : mServerAddr(serverAddr), mRemotePort(remotePort), mSize(size), mConfig(config) {}
+
+    /**
+     * @brief Loop of the maintenance thread.
+     */
+    void run();
+
+    const std::string mServerAddr;
+    const uint16_t mRemotePort;
+    const size_t mSize;
+    const EndpointConfig mConfig;
+
+    mutable std::mutex mMutex;  // Guards `mIdleClients`
+    std::condition_variable mIdleCondition;    // Signaled once a connection becomes idle
+    std::condition_variable mRefillCondition;  // Signaled once a connection is handed out
+    std::deque<std::unique_ptr<P2P_Endpoint>> mIdleClients;
+
+    std::atomic<bool> mExitFlag{false};
+    std::unique_ptr<Thread> mpThread;
+};  // class TcpConnectionPool
+
+}  // namespace comm
+
+#endif  // __TCPCONNECTIONPOOL_HPP__
@@ -0,0 +1,85 @@
+#ifndef __TCPCONNECTOR_HPP__
+#define __TCPCONNECTOR_HPP__
+
+#include "IP_Endpoint.hpp"
+#include "P2P_Endpoint.hpp"
+#include "common.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace comm {
+
+/**
+ * @brief Called for each completed connection request, it may take the ownership of the endpoint.
+ *
+ * @param[in] requestId ID returned by `TcpConnector::connect()`.
+ * @param[in] pClient The connected TcpClient, nullptr if the request failed.
+ * @param[in] errorCode 0 if connected, otherwise the reason of the failure (e.g. `ETIMEDOUT`).
+ */
+typedef std::function<void(const size_t& requestId, std::unique_ptr<P2P_Endpoint>& pClient, const int& errorCode)>
+    ConnectHandler;
+
+/**
+ * @brief Connects TcpClients in parallel: connections are started without waiting, then completed together once their
+ * sockets become writable (`SO_ERROR` tells whether they succeeded). Must be used by a single thread.
+ */
+class TcpConnector {
+   public:
+    /**
+     * @param[in] config Settings of connected endpoints.
+     */
+    explicit TcpConnector(const EndpointConfig& config = EndpointConfig()) : mConfig(config) {}
+
+    /**
+     * @brief Close connections which are still in progress.
+     */
+    ~TcpConnector();
+
+    /**
+     * @brief Start connecting to a server, without waiting.
+     *
+     * @param[in] serverAddr The IP address of the server.
+     * @param[in] remotePort The port number of the server.
+     * @param[in] timeout_ms The request fails (`ETIMEDOUT`) if it is not connected meanwhile.
+     * @return ID of the request (passed to the handler of `waitForConnections()`), 0 if it could not be started.
+     */
+    size_t connect(const std::string& serverAddr, const uint16_t& remotePort, const long timeout_ms = CONNECT_TIMEOUT_MS);
+
+    /**
+     * @brief Wait until connection requests complete, then report all completed ones (connected, failed or timed out).
+     *
+     * @param[out] errorCode 0 on success or timeout, the error code if waiting failed.
+     * @param[in] handler Called for each completed request.
+     * @param[in] timeout_ms Max. waiting time for the first completion.
+     * @return Number of completed requests.
+     */
+    size_t waitForConnections(int& errorCode, const ConnectHandler& handler, const long timeout_ms = 1000L);
+
+    /**
+     * @brief Return the number of connection requests which have not been reported yet.
+     */
+    size_t getNumberOfPendingConnections() const {
+        return mRequests.size();
+    }
+
+   private:
+    struct Request {
+        size_t id;
+        SOCKET socketFd;
+        struct sockaddr_in remoteSocketAddr;
+        monotonic_time_point deadline;
+        bool connected;  // Connected by `connect()` already
+    };  // struct Request
+
+    const EndpointConfig mConfig;
+    std::vector<Request> mRequests;
+    std::vector<struct pollfd> mPollFds;
+    size_t mNextRequestId = 1UL;
+};  // class TcpConnector
+
+}  // namespace comm
+
+#endif  // __TCPCONNECTOR_HPP__
@@ -3,12 +3,21 @@
 
 #include "IP_Endpoint.hpp"
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #ifndef __WIN32__
 constexpr int INVALID_SOCKET = -1;
 #endif  // __WIN32__
 
 namespace comm {
 
+/**
+ * @brief Called for each accepted connection, it may take the ownership of the endpoint.
+ */
+typedef std::function<void(std::unique_ptr<P2P_Endpoint>& pClient)> ClientHandler;
+
 class TcpServer {
    public:
     ~TcpServer() {
@@ -28,9 +37,12 @@ class TcpServer {
      * @brief Create a new TcpServer object.
      *
      * @param[in] localPort The server shall listen on this port.
+     * @param[in] config Settings of endpoints representing accepted connections.
+     * @param[in] reusePort Linux: enable `SO_REUSEPORT`, servers of the same port share incoming connections.
      * @return A unique pointer to the TcpServer, or nullptr if an error occurs.
      */
-    static std::unique_ptr<TcpServer> create(const uint16_t localPort);
+    static std::unique_ptr<TcpServer> create(
+        const uint16_t localPort, const EndpointConfig& config = EndpointConfig(), const bool reusePort = false);
 
     /**
      * @brief Waiting for connection request.
@@ -39,16 +51,63 @@ class TcpServer {
      */
     std::unique_ptr<P2P_Endpoint> waitForClient(int& errorCode, const long timeout_ms = 1000L);
 
+    /**
+     * @brief Wait until connection requests are pending, then accept all of them (up to `MAX_ACCEPTS_PER_WAIT`).
+     *
+     * @param[out] errorCode 0 on success or timeout, the error code otherwise.
+     * @param[in] handler Called for each accepted connection.
+     * @param[in] timeout_ms Max. waiting time for the first connection request.
+     * @return Number of accepted connections.
+     */
+    size_t waitForClients(int& errorCode, const ClientHandler& handler, const long timeout_ms = 1000L);
+
+    /**
+     * @brief Same as above, accepted connections are appended to `pClients`.
+     */
+    size_t waitForClients(int& errorCode, std::vector<std::unique_ptr<P2P_Endpoint>>& pClients, const long timeout_ms = 1000L) {
+        return waitForClients(
+            errorCode,
+            [&pClients](std::unique_ptr<P2P_Endpoint>& pClient) { pClients.push_back(std::move(pClient)); },
+            timeout_ms);
+    }
+
+    /**
+     * @brief Accept a pending connection, without waiting.
+     *
+     * @param[out] errorCode 0 if no connection is pending or on success, `ACCEPT_RETRY` if a connection request was
+     * dropped (e.g. aborted by the client) while others may still be pending, the error code otherwise.
+     * @param[in] config Settings of the endpoint representing the connection.
+     * @return P2P_Endpoint object representing the connection with the client, or nullptr.
+     */
+    std::unique_ptr<P2P_Endpoint> tryAccept(int& errorCode, const EndpointConfig& config);
+
+    /**
+     * @brief Wait until the listening socket is readable, e.g. before accepting with `tryAccept()`.
+     *
+     * @return 1 if connection requests are pending, 0 on timeout, -1 if an error occurs (`errorCode` is set).
+     */
+    int waitForConnectionRequest(int& errorCode, const long timeout_ms);
+
+    /**
+     * @brief Return the listening socket, e.g. to wait for connection requests with an event loop.
+     */
+    SOCKET getHandle() const {
+        return mLocalSocketFd;
+    }
+
+    static constexpr int ACCEPT_RETRY = -1;  // Not an error code (those are positive)
+
    protected:
-    TcpServer(const SOCKET localSocketFd) {
+    TcpServer(const SOCKET localSocketFd, const EndpointConfig& config) : mConfig(config) {
         mLocalSocketFd = localSocketFd;
     }
 
    private:
     SOCKET mLocalSocketFd;
+    const EndpointConfig mConfig;
 
-    static constexpr int BACKLOG = 5;
-    static constexpr long ACCEPT_RETRY_BREAK_MS = 100L;
+    static constexpr int BACKLOG = SOMAXCONN;  // Capped by the system (e.g. `net.core.somaxconn` on Linux)
+    static constexpr size_t MAX_ACCEPTS_PER_WAIT = 4096UL;  // Bounds a single `waitForClients()` call under a connection storm
     static constexpr struct sockaddr_in DUMMY_SOCKADDR = {AF_INET, 0};
 };  // class TcpServer
 
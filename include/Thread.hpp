@@ -0,0 +1,88 @@
+#ifndef __THREAD_HPP__
+#define __THREAD_HPP__
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef __WIN32__
+#include <thread>
+#else  // __WIN32__
+#include <pthread.h>
+#endif  // __WIN32__
+
+namespace comm {
+
+static constexpr size_t MAX_THREAD_NAME_LENGTH = 15UL;  // Linux limit, excluding the terminating null byte
+
+/**
+ * @brief Placement & scheduling settings of an internal thread. Default values keep the settings of the system.
+ */
+struct ThreadConfig {
+    /**
+     * @brief Thread name (shown by `top -H`, `ps -L`, debuggers), truncated to `MAX_THREAD_NAME_LENGTH` characters.
+     */
+    std::string name;
+
+    /**
+     * @brief CPUs on which the thread may run (e.g. isolated cores), empty for any CPU.
+     */
+    std::vector<int> cpus;
+
+    /**
+     * @brief Real-time priority (1 to 99) for `SCHED_FIFO`, 0 for the default time-sharing policy.
+     * `SCHED_FIFO` needs CAP_SYS_NICE (or a suitable RLIMIT_RTPRIO), otherwise the default policy is kept.
+     */
+    int fifoPriority = 0;
+
+    /**
+     * @brief Stack size (in bytes), 0 for the default one. Sizes below the system minimum are raised to it.
+     */
+    size_t stackSize = 0UL;
+};  // struct ThreadConfig
+
+/**
+ * @brief Native threads with placement & scheduling settings (`std::thread` cannot set them before the thread runs).
+ */
+class Thread {
+   public:
+    /**
+     * @brief Join the thread if it has not been joined yet.
+     */
+    ~Thread();
+
+    /**
+     * @brief Start a thread. Settings which cannot be applied are skipped with a warning.
+     *
+     * @param[in] config Thread settings.
+     * @param[in] function Function run by the thread.
+     * @return A unique pointer to the Thread, or nullptr if the thread could not be started.
+     */
+    static std::unique_ptr<Thread> start(const ThreadConfig& config, const std::function<void()>& function);
+
+    /**
+     * @brief Wait until the thread returns. Called by the thread itself, it is detached instead (it cannot wait for itself).
+     */
+    void join();
+
+    /**
+     * @brief Return the settings in effect for the calling thread.
+     */
+    static ThreadConfig getCurrentSettings();
+
+   private:
+    Thread() {}
+
+#ifdef __WIN32__
+    std::thread mThread;
+#else   // __WIN32__
+    pthread_t mThread;
+    bool mJoinable = false;
+#endif  // __WIN32__
+};  // class Thread
+
+}  // namespace comm
+
+#endif  // __THREAD_HPP__
@@ -48,6 +48,17 @@ int64_t get_elapsed_realtime_us(const monotonic_time_point& tp);
  */
 void sleep_for(uint32_t duration_us);
 
+/**
+ * @brief Hints the CPU that the caller is busy-waiting (`pause` on x86, `yield` on ARM).
+ */
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
 namespace comm {
 
 // Frame Structure
@@ -64,7 +75,8 @@ constexpr int32_t MAX_VALUE_OF_TID = 0xFFFF;  // Must be less than ((1 << (SIZE_
 constexpr size_t SIZE_OF_PAYLOAD_SIZE = 4UL;
 constexpr size_t MAX_PAYLOAD_SIZE = 1024UL;  // Avoid IP Fragmentation
 
-constexpr size_t MAX_FRAME_SIZE = SF_SIZE + SIZE_OF_TID + SIZE_OF_PAYLOAD_SIZE + MAX_PAYLOAD_SIZE + EF_SIZE;
+constexpr size_t FRAME_HEADER_SIZE = SF_SIZE + SIZE_OF_TID + SIZE_OF_PAYLOAD_SIZE;
+constexpr size_t MAX_FRAME_SIZE = FRAME_HEADER_SIZE + MAX_PAYLOAD_SIZE + EF_SIZE;
 
 /**
  * @brief Returns `false` if the payload size is greater than `MAX_PAYLOAD_SIZE`.
@@ -3,6 +3,12 @@
 inline bool comm::encode(
     const std::unique_ptr<uint8_t[]>& pData, const size_t& size, const uint16_t& tid,
     std::unique_ptr<uint8_t[]>& pEncodedData, size_t& encodedSize) {
+    return encode(pData.get(), size, tid, pEncodedData, encodedSize);
+}
+
+inline bool comm::encode(
+    const uint8_t* const pData, const size_t& size, const uint16_t& tid,
+    std::unique_ptr<uint8_t[]>& pEncodedData, size_t& encodedSize) {
 
     if (nullptr == pData) {
         LOGD("Input buffer is empty.\n");
@@ -14,12 +20,27 @@ inline bool comm::encode(
         return false;
     }
 
-    encodedSize = SF_SIZE + SIZE_OF_TID + SIZE_OF_PAYLOAD_SIZE + size + EF_SIZE;
+    encodedSize = FRAME_HEADER_SIZE + size + EF_SIZE;
     pEncodedData.reset(new uint8_t[encodedSize]);
 
+    // 1. Header
+    uint8_t* internal_pointer = pEncodedData.get();
+    encodeHeader(size, tid, internal_pointer);
+    internal_pointer += FRAME_HEADER_SIZE;
+
+    // 2. Payload
+    memcpy(internal_pointer, pData, size);
+
+    // 3. End Frame
+    *(internal_pointer + size) = EF;
+
+    return true;
+}
+
+inline void comm::encodeHeader(const size_t& size, const uint16_t& tid, uint8_t* const pHeader) {
     // Note: hard-coded to maximize performance!
     // 1. Start Frame
-    uint8_t* internal_pointer = pEncodedData.get();
+    uint8_t* internal_pointer = pHeader;
     *(internal_pointer++) = SF;
 
     // 2. Transaction ID
@@ -31,86 +52,63 @@ inline bool comm::encode(
     *(internal_pointer++) = static_cast<uint8_t>((size >> 8) & 0xFF);
     *(internal_pointer++) = static_cast<uint8_t>((size >> 16) & 0xFF);
     *(internal_pointer++) = static_cast<uint8_t>((size >> 24) & 0xFF);
-
-    // 4. Payload
-    memcpy(internal_pointer, pData.get(), size);
-
-    // 5. End Frame
-    *(internal_pointer + size) = EF;
-
-    return true;
 }
 
 inline void comm::Decoder::feed(const std::unique_ptr<uint8_t[]>& pdata, const size_t& size) {
-    LOGD("Feed %zu bytes.\n", size);
-    for (size_t i = 0; i < size; i++) {
-        proceed(pdata[i]);
-    }
+    feed(pdata.get(), size);
 }
 
-inline bool comm::Decoder::dequeue(std::deque<std::unique_ptr<Packet>>& pPackets, const bool wait) {
-    return mDecodedQueue.dequeue(pPackets, wait);
-}
+inline void comm::Decoder::feed(const uint8_t* const pdata, const size_t& size, const std::shared_ptr<const void>& pOwner) {
+    LOGD("Feed %zu bytes.\n", size);
+    if ((nullptr == pdata) || (0 == size)) {
+        return;
+    }
 
-inline void comm::Decoder::proceed(const uint8_t& b) {
-    static int64_t timestampUs = -1L;
-    switch (mState) {
-        case E_SF:
-            if (SF == b) {
-                resetBuffer();
-                timestampUs = get_elapsed_realtime_us();
-                mState = E_TID;
-            } else {
-                // Discard
-                LOGE("Expected 0x%02X but received 0x%02X!!!\n", static_cast<unsigned int>(SF), static_cast<unsigned int>(b));
-            }
-            break;
+    const uint8_t* p = pdata;
+    const uint8_t* const pEnd = pdata + size;
 
-        case E_TID: {
-            static int tid_byte_pos = 0;
-            static int delta = 0;
+    while (pEnd > p) {
+        size_t available = static_cast<size_t>(pEnd - p);
 
-            LOGD("TID byte %d -> shift %d bits.\n", tid_byte_pos, (tid_byte_pos << 3));
-            mTransactionId |= (static_cast<int>(b) & 0xFF) << (tid_byte_pos++ << 3);
+        switch (mState) {
+            case E_SF: {
+                const uint8_t* pSF = static_cast<const uint8_t*>(memchr(p, SF, available));
+                if (nullptr == pSF) {
+                    // Discard
+                    LOGE("Expected 0x%02X, discarded %zu bytes!!!\n", static_cast<unsigned int>(SF), available);
+                    p = pEnd;
+                    break;
+                }
 
-            if (SIZE_OF_TID <= static_cast<size_t>(tid_byte_pos)) {
-                tid_byte_pos = 0;
+                if (pSF != p) {
+                    // Discard
+                    LOGE("Expected 0x%02X, discarded %zu bytes!!!\n", static_cast<unsigned int>(SF), static_cast<size_t>(pSF - p));
+                }
 
-                if (0 <= mCachedTransactionId) {
-                    if (mCachedTransactionId <= mTransactionId) {
-                        delta = mTransactionId - mCachedTransactionId;
-                    } else {
-                        // Carry-over
-                        delta = (MAX_VALUE_OF_TID - mCachedTransactionId) + mTransactionId;
-                    }
+                p = pSF + SF_SIZE;
+                resetBuffer();
+                mTimestampUs = get_elapsed_realtime_us();
+                mState = E_HEADER;
+            } break;
+
+            case E_HEADER: {
+                const uint8_t* pHeader = mHeader;
+                if ((0 == mHeaderPos) && (HEADER_FIELDS_SIZE <= available)) {
+                    // Fast path: the whole header is available in the input span
+                    pHeader = p;
+                    p += HEADER_FIELDS_SIZE;
+                } else {
+                    const size_t count = (HEADER_FIELDS_SIZE - mHeaderPos < available) ? (HEADER_FIELDS_SIZE - mHeaderPos) : available;
+                    memcpy(mHeader + mHeaderPos, p, count);
+                    mHeaderPos += count;
+                    p += count;
 
-                    if (0 == delta) {
-                        LOGE("Duplicated Transaction ID: %d -> %d!!!\n", mCachedTransactionId, mTransactionId);
-                    } else if (1 < delta) {
-                        LOGE("Lost packets between (%d;%d)!!!\n", mCachedTransactionId, mTransactionId);
-                    } else {
-                        LOGD("Transaction ID: %d -> %d.\n", mCachedTransactionId, mTransactionId);
+                    if (HEADER_FIELDS_SIZE > mHeaderPos) {
+                        break;
                     }
-                } else {
-                    LOGD("Received 1st packet with Transaction ID: %d.\n", mTransactionId);
                 }
 
-                mCachedTransactionId = mTransactionId;
-
-                mState = E_SIZE;
-            }
-        } break;
-
-        case E_SIZE: {
-            static size_t size_byte_pos = 0;
-            LOGD("Size byte %zu -> shift %zu bits.\n", size_byte_pos, (size_byte_pos << 3));
-            mPayloadSize |= (static_cast<size_t>(b) & 0xFFUL) << (size_byte_pos++ << 3);
-
-            if (SIZE_OF_PAYLOAD_SIZE <= size_byte_pos) {
-                size_byte_pos = 0;
-
-                if (validate_payload_size(mPayloadSize)) {
-                    mpPayload.reset(new uint8_t[mPayloadSize]);
+                if (parseHeader(pHeader)) {
                     mState = E_PAYLOAD;
                     LOGD("Payload size: %zu (bytes).\n", mPayloadSize);
                 } else {
@@ -118,42 +116,127 @@ inline void comm::Decoder::proceed(const uint8_t& b) {
                     mState = E_SF;
                     LOGE("Invalid payload size: %zu!!!\n", mPayloadSize);
                 }
-            }
-        } break;
+            } break;
 
-        case E_PAYLOAD: {
-            static size_t payload_byte_pos = 0;
+            case E_PAYLOAD: {
+                if ((0 == mPayloadPos) && ((mPayloadSize + EF_SIZE) <= available)) {
+                    // Fast path: payload & EF are available in the input span, no need to buffer
+                    if (EF == p[mPayloadSize]) {
+                        save(p, pOwner);
+                    } else {
+                        // Discard
+                        LOGE("Expected 0x%02X but received 0x%02X!!!\n", EF, p[mPayloadSize]);
+                    }
 
-            mpPayload[payload_byte_pos++] = b;
-            if (mPayloadSize <= payload_byte_pos) {
-                payload_byte_pos = 0;
-                mState = E_VALIDATION;
-            }
-        } break;
+                    p += mPayloadSize + EF_SIZE;
+                    mState = E_SF;
+                    break;
+                }
+
+                if (!mpPayload) {
+                    mpPayload = PacketPool::allocateBuffer(mPayloadSize);
+                }
+
+                const size_t count = (mPayloadSize - mPayloadPos < available) ? (mPayloadSize - mPayloadPos) : available;
+                memcpy(mpPayload.get() + mPayloadPos, p, count);
+                mPayloadPos += count;
+                p += count;
 
-        case E_VALIDATION: {
-            if (EF == b) {
-                // Save the frame
-                if (!mDecodedQueue.enqueue(Packet::create(mpPayload, mPayloadSize, timestampUs))) {
-                    LOGE("Decoder Queue is full!!!\n");
+                if (mPayloadSize <= mPayloadPos) {
+                    mState = E_VALIDATION;
+                }
+            } break;
+
+            case E_VALIDATION: {
+                if (EF == *p) {
+                    // The packet takes over the reassembled payload
+                    save(std::move(mpPayload));
+                } else {
+                    // Discard
+                    LOGE("Expected 0x%02X but received 0x%02X!!!\n", EF, *p);
                 }
 
-                LOGD("Decoded a packet with %zu bytes payload at %lld (us).\n", mPayloadSize, static_cast<long long int>(timestampUs));
-            } else {
-                // Discard
-                LOGE("Expected 0x%02X but received 0x%02X!!!\n", EF, b);
+                p += EF_SIZE;
             }
+                // break;
+
+            default:
+                mState = E_SF;
+                break;
+        }
+    }
+
+    if (mBatchHandler && !mBatch.empty()) {
+        mBatchHandler(mBatch);
+        mBatch.clear();
+    }
+}
+
+inline bool comm::Decoder::dequeue(std::deque<std::unique_ptr<Packet>>& pPackets, const bool wait) {
+    return mpDecodedQueue->dequeue(pPackets, wait);
+}
+
+inline bool comm::Decoder::parseHeader(const uint8_t* const pHeader) {
+    // Note: byte-wise composition is folded into plain loads by the compiler.
+    mTransactionId = static_cast<int>(pHeader[0]) | (static_cast<int>(pHeader[1]) << 8);
+    mPayloadSize = static_cast<size_t>(pHeader[2]) | (static_cast<size_t>(pHeader[3]) << 8) |
+                   (static_cast<size_t>(pHeader[4]) << 16) | (static_cast<size_t>(pHeader[5]) << 24);
+
+    if (0 <= mCachedTransactionId) {
+        int delta;
+        if (mCachedTransactionId <= mTransactionId) {
+            delta = mTransactionId - mCachedTransactionId;
+        } else {
+            // Carry-over
+            delta = (MAX_VALUE_OF_TID - mCachedTransactionId) + mTransactionId;
+        }
+
+        if (0 == delta) {
+            LOGE("Duplicated Transaction ID: %d -> %d!!!\n", mCachedTransactionId, mTransactionId);
+        } else if (1 < delta) {
+            LOGE("Lost packets between (%d;%d)!!!\n", mCachedTransactionId, mTransactionId);
+        } else {
+            LOGD("Transaction ID: %d -> %d.\n", mCachedTransactionId, mTransactionId);
         }
-            // break;
+    } else {
+        LOGD("Received 1st packet with Transaction ID: %d.\n", mTransactionId);
+    }
+
+    mCachedTransactionId = mTransactionId;
+
+    return validate_payload_size(mPayloadSize);
+}
+
+inline void comm::Decoder::save(const uint8_t* const pPayload, const std::shared_ptr<const void>& pOwner) {
+    std::unique_ptr<Packet> pPacket = (pOwner) ? Packet::createView(pPayload, mPayloadSize, pOwner, mTimestampUs)
+                                               : Packet::create(pPayload, mPayloadSize, mTimestampUs);
+    deliver(pPacket);
+
+    LOGD("Decoded a packet with %zu bytes payload at %lld (us).\n", mPayloadSize, static_cast<long long int>(mTimestampUs));
+}
+
+inline void comm::Decoder::save(PooledBuffer&& pPayload) {
+    std::unique_ptr<Packet> pPacket = Packet::create(std::move(pPayload), mPayloadSize, mTimestampUs);
+    deliver(pPacket);
+
+    LOGD("Decoded a packet with %zu bytes payload at %lld (us).\n", mPayloadSize, static_cast<long long int>(mTimestampUs));
+}
 
-        default:
-            mState = E_SF;
-            break;
+inline void comm::Decoder::deliver(std::unique_ptr<Packet>& pPacket) {
+    if (mPacketHandler) {
+        mPacketHandler(pPacket);
+    } else if (mBatchHandler) {
+        mBatch.push_back(std::move(pPacket));
+    } else if (!mpDecodedQueue->enqueue(pPacket)) {
+        LOGE("Decoder Queue is full!!!\n");
     }
 }
 
 inline void comm::Decoder::resetBuffer() {
     mpPayload.reset();
+    mHeaderPos = 0UL;
     mPayloadSize = 0UL;
+    mPayloadPos = 0UL;
+    mTimestampUs = -1L;
     mTransactionId = 0;
 }
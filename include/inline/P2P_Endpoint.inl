@@ -5,23 +5,89 @@ namespace comm {
 inline void P2P_Endpoint::start() {
     mExitFlag = false;
 
-    mpRxThread.reset(new std::thread(&P2P_Endpoint::runRx, this));
-    mpRxThread->detach();
+    if (mConfig.pReactor) {
+        mRxAliveFlag = true;
+        mTxAliveFlag = true;
+        if (!mConfig.pReactor->attach(this)) {
+            LOGE("Could not register with the reactor!!!\n");
+            mRxAliveFlag = false;
+            mTxAliveFlag = false;
+        }
+
+        return;
+    }
+
+    // Alive until the threads return, even if they have not run yet
+    mRxAliveFlag = true;
+    mTxAliveFlag = true;
+
+    mpRxThread = Thread::start(mConfig.rxThread, [this]() {
+        {
+            std::lock_guard<std::mutex> lock(mThreadSettingsMutex);
+            mRxThreadSettings = Thread::getCurrentSettings();
+        }
+
+        runRx();
+    });
+    if (!mpRxThread) {
+        LOGE("Could not start Rx thread!!!\n");
+        mRxAliveFlag = false;
+    }
+
+    mpTxThread = Thread::start(mConfig.txThread, [this]() {
+        {
+            std::lock_guard<std::mutex> lock(mThreadSettingsMutex);
+            mTxThreadSettings = Thread::getCurrentSettings();
+        }
 
-    mpTxThread.reset(new std::thread(&P2P_Endpoint::runTx, this));
-    mpTxThread->detach();
+        runTx();
+    });
+    if (!mpTxThread) {
+        LOGE("Could not start Tx thread!!!\n");
+        mTxAliveFlag = false;
+    }
 }
 
 inline void P2P_Endpoint::stop() {
     mExitFlag = true;
 
-    for (int i = 0; (RETRY_LIMIT > i) && isAlive(); i++) {
-        sleep_for(RETRY_BREAK_US);
+    if (mConfig.pReactor) {
+        mConfig.pReactor->detach(this);
+        mRxAliveFlag = false;
+        mTxAliveFlag = false;
+        return;
     }
 
-    if (isAlive()) {
-        LOGE("Failed to terminate internal threads!!!\n");
+    // Waits are interrupted rather than left to time out
+    mpTxQueue->shutdown();
+    lwakeUp();
+
+    if (mpRxThread) {
+        mpRxThread->join();
     }
+
+    if (mpTxThread) {
+        mpTxThread->join();
+    }
+}
+
+inline TxStats P2P_Endpoint::getTxStats() {
+    TxStats stats;
+    stats.batches = mTxBatchCount;
+    stats.packets = mTxPacketCount;
+    stats.bytes = mTxByteCount;
+
+    return stats;
+}
+
+inline ThreadConfig P2P_Endpoint::getRxThreadSettings() {
+    std::lock_guard<std::mutex> lock(mThreadSettingsMutex);
+    return mRxThreadSettings;
+}
+
+inline ThreadConfig P2P_Endpoint::getTxThreadSettings() {
+    std::lock_guard<std::mutex> lock(mThreadSettingsMutex);
+    return mTxThreadSettings;
 }
 
 inline bool P2P_Endpoint::isAlive() {
@@ -30,9 +96,25 @@ inline bool P2P_Endpoint::isAlive() {
 
 inline bool P2P_Endpoint::send(std::unique_ptr<Packet>& pPacket) {
     if (pPacket) {
-        if (mTxQueue.enqueue(pPacket)) {
+        if (mConfig.directSend) {
+            const int ret = sendDirect(pPacket);
+            if (0 != ret) {
+                return (0 < ret);
+            }
+
+            mTxBacklog++;
+        }
+
+        if (mpTxQueue->enqueue(pPacket)) {
+            if (mConfig.pReactor) {
+                mConfig.pReactor->notifyTx(this);
+            }
+
             return true;
         } else {
+            if (mConfig.directSend) {
+                mTxBacklog--;
+            }
             LOGE("Tx Queue is full!!!\n");
         }
     } else {
@@ -43,17 +125,23 @@ inline bool P2P_Endpoint::send(std::unique_ptr<Packet>& pPacket) {
 }
 
 inline bool P2P_Endpoint::send(std::unique_ptr<Packet>&& pPacket) {
-    if (pPacket) {
-        if (mTxQueue.enqueue(pPacket)) {
-            return true;
-        } else {
-            LOGE("Tx Queue is full!!!\n");
-        }
-    } else {
-        LOGE("Tx packet must not be empty!!!\n");
+    return send(pPacket);
+}
+
+inline ssize_t P2P_Endpoint::lwritev(const IoSegment* const pSegments, const size_t& count) {
+    size_t size = 0UL;
+    for (size_t i = 0; i < count; i++) {
+        size += pSegments[i].size;
     }
 
-    return false;
+    std::unique_ptr<uint8_t[]> pData(new uint8_t[size]);
+    size_t offset = 0UL;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(pData.get() + offset, pSegments[i].pData, pSegments[i].size);
+        offset += pSegments[i].size;
+    }
+
+    return lwrite(pData, size);
 }
 
 inline bool P2P_Endpoint::recvAll(std::deque<std::unique_ptr<Packet>>& pRxPackets, const bool wait) {
@@ -3,46 +3,78 @@
 namespace comm {
 
 inline Packet::Packet(Packet&& other) {
-    mpPayload = std::move(other.mpPayload);
+    moveFrom(other);
+}
+
+inline Packet& Packet::operator=(Packet&& other) {
+    if (this != &other) {
+        releasePayload();
+        moveFrom(other);
+    }
+
+    return *this;
+}
+
+inline void Packet::moveFrom(Packet& other) {
+    mpPayload = other.mpPayload;
+    other.mpPayload = nullptr;
+    mPayloadCapacity = other.mPayloadCapacity;
+    other.mPayloadCapacity = 0UL;
+    mpOwner = std::move(other.mpOwner);
     mPayloadSize = other.mPayloadSize;
     other.mPayloadSize = 0L;
 
+    if (other.mInlinePayload == other.mpData) {
+        memcpy(mInlinePayload, other.mInlinePayload, mPayloadSize);
+        mpData = mInlinePayload;
+    } else {
+        mpData = other.mpData;
+    }
+    other.mpData = nullptr;
+
     mTimestampUs = other.mTimestampUs;
     other.mTimestampUs = -1L;
 }
 
-inline Packet& Packet::operator=(Packet&& other) {
-    if (this != &other) {
-        mpPayload = std::move(other.mpPayload);
-        mPayloadSize = other.mPayloadSize;
-        other.mPayloadSize = 0L;
+inline Packet::Packet(
+    const std::unique_ptr<uint8_t[]>& pPayload,
+    const size_t& payloadSize,
+    const int64_t& timestampUs) : Packet(pPayload.get(), payloadSize, timestampUs) {}
 
-        mTimestampUs = other.mTimestampUs;
-        other.mTimestampUs = -1L;
+inline std::unique_ptr<Packet> Packet::create(
+    const std::unique_ptr<uint8_t[]>& pPayload,
+    const size_t& payloadSize,
+    const int64_t& timestampUs) {
+    if ((pPayload) && validate_payload_size(payloadSize)) {
+        return std::unique_ptr<Packet>(
+            new Packet(pPayload, payloadSize, timestampUs));
+    } else {
+        return std::unique_ptr<Packet>(nullptr);
     }
-
-    return *this;
 }
 
 inline Packet::Packet(
-    const std::unique_ptr<uint8_t[]>& pPayload,
+    const uint8_t* const& pPayload,
     const size_t& payloadSize,
     const int64_t& timestampUs) {
-    mTimestampUs = get_elapsed_realtime_us();
+    mTimestampUs = (0 < timestampUs) ? timestampUs : get_elapsed_realtime_us();
     mPayloadSize = payloadSize;
-    mpPayload.reset(new uint8_t[mPayloadSize]);
-    memcpy(mpPayload.get(), pPayload.get(), mPayloadSize);
-
-    if (0 < timestampUs) {
-        mTimestampUs = timestampUs;
+    if (SMALL_PAYLOAD_SIZE >= mPayloadSize) {
+        memcpy(mInlinePayload, pPayload, mPayloadSize);
+        mpData = mInlinePayload;
+    } else {
+        mpPayload = static_cast<uint8_t*>(PacketPool::allocate(mPayloadSize));
+        mPayloadCapacity = mPayloadSize;
+        memcpy(mpPayload, pPayload, mPayloadSize);
+        mpData = mpPayload;
     }
 }
 
 inline std::unique_ptr<Packet> Packet::create(
-    const std::unique_ptr<uint8_t[]>& pPayload,
+    const uint8_t* const& pPayload,
     const size_t& payloadSize,
     const int64_t& timestampUs) {
-    if ((pPayload) && validate_payload_size(payloadSize)) {
+    if ((nullptr != pPayload) && validate_payload_size(payloadSize)) {
         return std::unique_ptr<Packet>(
             new Packet(pPayload, payloadSize, timestampUs));
     } else {
@@ -53,27 +85,72 @@ inline std::unique_ptr<Packet> Packet::create(
 inline Packet::Packet(
     const uint8_t* const& pPayload,
     const size_t& payloadSize,
-    const int64_t& timestampUs) {
-    mTimestampUs = get_elapsed_realtime_us();
+    const std::shared_ptr<const void>& pOwner,
+    const int64_t& timestampUs) : mpOwner(pOwner), mpData(pPayload) {
+    mTimestampUs = (0 < timestampUs) ? timestampUs : get_elapsed_realtime_us();
+    mPayloadSize = payloadSize;
+}
+
+inline Packet::Packet(
+    uint8_t* const pPayload,
+    const size_t& capacity,
+    const size_t& payloadSize,
+    const int64_t& timestampUs) : mpPayload(pPayload), mPayloadCapacity(capacity), mpData(pPayload) {
+    mTimestampUs = (0 < timestampUs) ? timestampUs : get_elapsed_realtime_us();
     mPayloadSize = payloadSize;
-    mpPayload.reset(new uint8_t[mPayloadSize]);
-    memcpy(mpPayload.get(), pPayload, mPayloadSize);
+}
 
-    if (0 < timestampUs) {
-        mTimestampUs = timestampUs;
+inline std::unique_ptr<Packet> Packet::create(
+    std::unique_ptr<uint8_t[]>&& pPayload,
+    const size_t& payloadSize,
+    const int64_t& timestampUs) {
+    if ((pPayload) && validate_payload_size(payloadSize)) {
+        std::unique_ptr<Packet> pPacket(new Packet(pPayload.get(), 0UL, payloadSize, timestampUs));
+        pPayload.release();
+        return pPacket;
+    } else {
+        return std::unique_ptr<Packet>(nullptr);
     }
 }
 
 inline std::unique_ptr<Packet> Packet::create(
+    PooledBuffer&& pPayload,
+    const size_t& payloadSize,
+    const int64_t& timestampUs) {
+    const size_t capacity = pPayload.get_deleter().getSize();
+    if ((pPayload) && (0UL < capacity) && (capacity >= payloadSize) && validate_payload_size(payloadSize)) {
+        std::unique_ptr<Packet> pPacket(new Packet(pPayload.get(), capacity, payloadSize, timestampUs));
+        pPayload.release();
+        return pPacket;
+    } else {
+        return std::unique_ptr<Packet>(nullptr);
+    }
+}
+
+inline std::unique_ptr<Packet> Packet::createView(
     const uint8_t* const& pPayload,
     const size_t& payloadSize,
+    const std::shared_ptr<const void>& pOwner,
     const int64_t& timestampUs) {
-    if ((nullptr != pPayload) && validate_payload_size(payloadSize)) {
+    if ((nullptr != pPayload) && (pOwner) && validate_payload_size(payloadSize)) {
         return std::unique_ptr<Packet>(
-            new Packet(pPayload, payloadSize, timestampUs));
+            new Packet(pPayload, payloadSize, pOwner, timestampUs));
     } else {
         return std::unique_ptr<Packet>(nullptr);
     }
 }
 
+inline void Packet::releasePayload() {
+    if (nullptr != mpPayload) {
+        if (0UL < mPayloadCapacity) {
+            PacketPool::deallocate(mpPayload, mPayloadCapacity);
+        } else {
+            delete[] mpPayload;
+        }
+
+        mpPayload = nullptr;
+        mPayloadCapacity = 0UL;
+    }
+}
+
 }  // namespace comm
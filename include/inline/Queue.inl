@@ -0,0 +1,16 @@
+#include "Queue.hpp"
+#include "SpscQueue.hpp"
+#include "SyncQueue.hpp"
+
+namespace dstruct {
+
+template <class T>
+inline std::unique_ptr<Queue<T>> Queue<T>::create(const QUEUE_TYPE& type, const int timeoutMs, const size_t capLimit) {
+    if (E_SPSC_QUEUE == type) {
+        return std::unique_ptr<Queue<T>>(new SpscQueue<T>(timeoutMs, capLimit));
+    } else {
+        return std::unique_ptr<Queue<T>>(new SyncQueue<T>(timeoutMs, capLimit));
+    }
+}
+
+}  // namespace dstruct
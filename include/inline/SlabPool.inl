@@ -0,0 +1,51 @@
+#include "SlabPool.hpp"
+
+namespace dstruct {
+
+inline std::shared_ptr<SlabPool> SlabPool::create(const size_t slabSize, const size_t capLimit) {
+    if (0 == slabSize) {
+        return std::shared_ptr<SlabPool>(nullptr);
+    }
+
+    return std::shared_ptr<SlabPool>(new SlabPool(slabSize, capLimit));
+}
+
+inline std::shared_ptr<uint8_t> SlabPool::acquire() {
+    uint8_t* pSlab = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mFreeSlabs.empty()) {
+            pSlab = mFreeSlabs.back();
+            mFreeSlabs.pop_back();
+        }
+    }
+
+    if (nullptr == pSlab) {
+        pSlab = new uint8_t[mSlabSize];
+    }
+
+    return std::shared_ptr<uint8_t>(pSlab, SlabRecycler{shared_from_this()});
+}
+
+inline void SlabPool::recycle(uint8_t* pSlab) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mCapLimit > mFreeSlabs.size()) {
+            mFreeSlabs.push_back(pSlab);
+            return;
+        }
+    }
+
+    delete[] pSlab;
+}
+
+inline void SlabRecycler::operator()(uint8_t* pSlab) const {
+    std::shared_ptr<SlabPool> pPool = mpPool.lock();
+    if (pPool) {
+        pPool->recycle(pSlab);
+    } else {
+        delete[] pSlab;
+    }
+}
+
+}  // namespace dstruct
@@ -0,0 +1,119 @@
+#include "SpscQueue.hpp"
+
+namespace dstruct {
+
+template <class T>
+inline SpscQueue<T>::SpscQueue(const int timeoutMs, const size_t capLimit) : mTimeoutMs(timeoutMs), mTail(0UL), mCachedHead(0UL), mHead(0UL), mCachedTail(0UL), mWaiting(false), mShutdown(false) {
+    mCapacity = 1UL;
+    while (mCapacity < capLimit) {
+        mCapacity <<= 1;
+    }
+    mMask = mCapacity - 1;
+    mCapLimit = (0UL < capLimit) ? capLimit : 1UL;
+
+    mpSlots = new T*[mCapacity];
+}
+
+template <class T>
+inline SpscQueue<T>::~SpscQueue() {
+    const size_t tail = mTail.load(std::memory_order_acquire);
+    for (size_t head = mHead.load(std::memory_order_relaxed); head != tail; head++) {
+        delete mpSlots[head & mMask];
+    }
+
+    delete[] mpSlots;
+}
+
+template <class T>
+inline bool SpscQueue<T>::enqueue(std::unique_ptr<T>& pItem) {
+    const size_t tail = mTail.load(std::memory_order_relaxed);
+    const size_t capLimit = mCapLimit.load(std::memory_order_relaxed);
+
+    if ((tail - mCachedHead) >= capLimit) {
+        mCachedHead = mHead.load(std::memory_order_acquire);
+        if ((tail - mCachedHead) >= capLimit) {
+            return false;
+        }
+    }
+
+    mpSlots[tail & mMask] = pItem.release();
+    mTail.store(tail + 1, std::memory_order_release);
+
+    // Pairs with the fence in `dequeue()`: either the consumer sees the item, or the producer sees the waiting flag
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mWaiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCv.notify_one();
+    }
+
+    return true;
+}
+
+template <class T>
+inline bool SpscQueue<T>::enqueue(std::unique_ptr<T>&& pItem) {
+    return enqueue(pItem);
+}
+
+template <class T>
+inline bool SpscQueue<T>::dequeue(std::deque<std::unique_ptr<T>>& items, const bool wait) {
+    if (0UL < drain(items)) {
+        return true;
+    } else if (!wait) {
+        return false;
+    }
+
+    mWaiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (isEmpty() && !mShutdown.load(std::memory_order_relaxed)) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCv.wait_for(lock, std::chrono::milliseconds(mTimeoutMs), [this]() { return !isEmpty() || mShutdown.load(std::memory_order_relaxed); });
+    }
+    mWaiting.store(false, std::memory_order_relaxed);
+
+    return (0UL < drain(items));
+}
+
+template <class T>
+inline size_t SpscQueue<T>::drain(std::deque<std::unique_ptr<T>>& items) {
+    size_t head = mHead.load(std::memory_order_relaxed);
+    if (head == mCachedTail) {
+        mCachedTail = mTail.load(std::memory_order_acquire);
+        if (head == mCachedTail) {
+            return 0UL;
+        }
+    }
+
+    const size_t count = mCachedTail - head;
+    for (; head != mCachedTail; head++) {
+        items.push_back(std::unique_ptr<T>(mpSlots[head & mMask]));
+    }
+    mHead.store(head, std::memory_order_release);
+
+    return count;
+}
+
+template <class T>
+inline bool SpscQueue<T>::isEmpty() const {
+    return mHead.load(std::memory_order_relaxed) == mTail.load(std::memory_order_acquire);
+}
+
+template <class T>
+inline void SpscQueue<T>::setTimeoutMs(const int timeoutMs) {
+    mTimeoutMs = timeoutMs;
+}
+
+template <class T>
+inline void SpscQueue<T>::setCapLimit(const size_t capLimit) {
+    mCapLimit = (0UL == capLimit) ? 1UL : ((mCapacity < capLimit) ? mCapacity : capLimit);
+}
+
+template <class T>
+inline void SpscQueue<T>::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShutdown = true;
+    }
+    mCv.notify_all();
+}
+
+}  // namespace dstruct
@@ -10,6 +10,7 @@ inline bool SyncQueue<T>::enqueue(std::unique_ptr<T>& pItem) {
     result = mCapLimit > mQueue.size();
     if (result) {
         mQueue.push_back(std::move(pItem));
+        mSize.store(mQueue.size(), std::memory_order_release);
     }
     mCv.notify_one();
 
@@ -24,6 +25,7 @@ inline bool SyncQueue<T>::enqueue(std::unique_ptr<T>&& pItem) {
     result = mCapLimit > mQueue.size();
     if (result) {
         mQueue.push_back(std::move(pItem));
+        mSize.store(mQueue.size(), std::memory_order_release);
     }
     mCv.notify_one();
 
@@ -37,8 +39,8 @@ inline bool SyncQueue<T>::dequeue(std::deque<std::unique_ptr<T>>& items, const b
     if (wait) {
         std::unique_lock<std::mutex> lock(mMutex);
 
-        if (mQueue.empty()) {
-            mCv.wait_for(lock, std::chrono::milliseconds(mTimeoutMs));
+        if (mQueue.empty() && !mShutdown) {
+            mCv.wait_for(lock, std::chrono::milliseconds(mTimeoutMs), [this]() { return !mQueue.empty() || mShutdown; });
         }
 
         result = !mQueue.empty();
@@ -47,6 +49,7 @@ inline bool SyncQueue<T>::dequeue(std::deque<std::unique_ptr<T>>& items, const b
             items.push_back(std::move(mQueue.front()));
             mQueue.pop_front();
         }
+        mSize.store(0UL, std::memory_order_relaxed);
     } else {
         std::lock_guard<std::mutex> lock(mMutex);
 
@@ -56,11 +59,17 @@ inline bool SyncQueue<T>::dequeue(std::deque<std::unique_ptr<T>>& items, const b
             items.push_back(std::move(mQueue.front()));
             mQueue.pop_front();
         }
+        mSize.store(0UL, std::memory_order_relaxed);
     }
 
     return result;
 }
 
+template <class T>
+inline bool SyncQueue<T>::isEmpty() const {
+    return 0UL == mSize.load(std::memory_order_acquire);
+}
+
 template <class T>
 inline void SyncQueue<T>::setTimeoutMs(const int timeoutMs) {
     mTimeoutMs = timeoutMs;
@@ -71,4 +80,13 @@ inline void SyncQueue<T>::setCapLimit(const size_t capLimit) {
     mCapLimit = capLimit;
 }
 
+template <class T>
+inline void SyncQueue<T>::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShutdown = true;
+    }
+    mCv.notify_all();
+}
+
 }  // namespace dstruct
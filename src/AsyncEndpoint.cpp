@@ -0,0 +1,147 @@
+#include "AsyncEndpoint.hpp"
+
+#include "common.hpp"
+
+namespace comm {
+
+AsyncEndpoint::AsyncEndpoint(const std::shared_ptr<State>& pState, std::unique_ptr<P2P_Endpoint>&& pEndpoint)
+    : mpState(pState), mpEndpoint(std::move(pEndpoint)) {
+    mpState->pEndpoint = mpEndpoint.get();
+}
+
+AsyncEndpoint::~AsyncEndpoint() {
+    // Pending awaiters complete (as if the endpoint died) at their next check
+    mpState->pEndpoint = nullptr;
+    mpEndpoint.reset();
+}
+
+std::unique_ptr<AsyncEndpoint> AsyncEndpoint::createUdpPeer(
+    EventLoop& loop, const uint16_t& localPort, const std::string& peerAddress, const uint16_t& peerPort,
+    const EndpointConfig& config) {
+    std::shared_ptr<State> pState = std::make_shared<State>(loop);
+    std::unique_ptr<P2P_Endpoint> pEndpoint = IP_Endpoint::createUdpPeer(localPort, peerAddress, peerPort, bindConfig(pState, config));
+    if (!pEndpoint) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<AsyncEndpoint>(new AsyncEndpoint(pState, std::move(pEndpoint)));
+}
+
+std::unique_ptr<AsyncEndpoint> AsyncEndpoint::createTcpClient(
+    EventLoop& loop, const std::string& serverAddr, const uint16_t& remotePort, const EndpointConfig& config) {
+    std::shared_ptr<State> pState = std::make_shared<State>(loop);
+    std::unique_ptr<P2P_Endpoint> pEndpoint = IP_Endpoint::createTcpClient(serverAddr, remotePort, bindConfig(pState, config));
+    if (!pEndpoint) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<AsyncEndpoint>(new AsyncEndpoint(pState, std::move(pEndpoint)));
+}
+
+EndpointConfig AsyncEndpoint::bindConfig(const std::shared_ptr<State>& pState, const EndpointConfig& config) {
+    EndpointConfig boundConfig = config;
+    boundConfig.rxBatchHandler = nullptr;
+
+    // Runs on the Rx thread (or a reactor I/O thread)
+    boundConfig.rxPacketHandler = [pState](std::unique_ptr<Packet>& pPacket) {
+        std::coroutine_handle<> waiter;
+        {
+            std::lock_guard<std::mutex> lock(pState->mutex);
+            pState->packets.push_back(std::move(pPacket));
+            waiter = std::exchange(pState->waiter, nullptr);
+        }
+
+        if (waiter) {
+            pState->loop.post([waiter]() { waiter.resume(); });
+        }
+    };
+
+    return boundConfig;
+}
+
+void AsyncEndpoint::checkLiveness(const std::shared_ptr<State>& pState, const uint64_t& waitId) {
+    pState->loop.callAfter(LIVENESS_CHECK_US, [pState, waitId]() {
+        std::coroutine_handle<> waiter;
+        {
+            std::lock_guard<std::mutex> lock(pState->mutex);
+            if ((waitId != pState->waitId) || !pState->waiter) {
+                // Already resumed by a packet
+                return;
+            }
+
+            if ((nullptr != pState->pEndpoint) && pState->pEndpoint->isAlive()) {
+                checkLiveness(pState, waitId);
+                return;
+            }
+
+            waiter = std::exchange(pState->waiter, nullptr);
+        }
+
+        waiter.resume();
+    });
+}
+
+bool AsyncEndpoint::RecvAwaiter::await_ready() {
+    {
+        std::lock_guard<std::mutex> lock(mpState->mutex);
+        if (!mpState->packets.empty()) {
+            return true;
+        }
+    }
+
+    return (nullptr == mpState->pEndpoint) || !mpState->pEndpoint->isAlive();
+}
+
+bool AsyncEndpoint::RecvAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    uint64_t waitId;
+    {
+        std::lock_guard<std::mutex> lock(mpState->mutex);
+        if (!mpState->packets.empty()) {
+            // Received in the meantime
+            return false;
+        }
+
+        mpState->waiter = handle;
+        waitId = ++mpState->waitId;
+    }
+
+    checkLiveness(mpState, waitId);
+
+    return true;
+}
+
+std::unique_ptr<Packet> AsyncEndpoint::RecvAwaiter::await_resume() {
+    std::unique_ptr<Packet> pPacket;
+
+    std::lock_guard<std::mutex> lock(mpState->mutex);
+    if (!mpState->packets.empty()) {
+        pPacket = std::move(mpState->packets.front());
+        mpState->packets.pop_front();
+    }
+
+    return pPacket;
+}
+
+bool AsyncEndpoint::SendAwaiter::await_ready() {
+    P2P_Endpoint* const pEndpoint = mpState->pEndpoint;
+    if ((!mpPacket) || (nullptr == pEndpoint) || !pEndpoint->isAlive()) {
+        return true;
+    }
+
+    // The packet stays here while the Tx queue is full
+    mResult = pEndpoint->send(mpPacket);
+
+    return mResult;
+}
+
+void AsyncEndpoint::SendAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    mpState->loop.callAfter(TX_RETRY_BREAK_US, [this, handle]() {
+        if (await_ready()) {
+            handle.resume();
+        } else {
+            await_suspend(handle);
+        }
+    });
+}
+
+}  // namespace comm
@@ -0,0 +1,50 @@
+#include "AsyncTcpServer.hpp"
+
+#include "common.hpp"
+
+namespace comm {
+
+AsyncTcpServer::~AsyncTcpServer() {
+    mLoop.unwatch(mpServer->getHandle());
+}
+
+std::unique_ptr<AsyncTcpServer> AsyncTcpServer::create(EventLoop& loop, const uint16_t localPort, const EndpointConfig& config) {
+    std::unique_ptr<TcpServer> pServer = TcpServer::create(localPort, config);
+    if (!pServer) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<AsyncTcpServer>(new AsyncTcpServer(loop, std::move(pServer), config));
+}
+
+bool AsyncTcpServer::AcceptAwaiter::await_ready() {
+    std::shared_ptr<AsyncEndpoint::State> pState = std::make_shared<AsyncEndpoint::State>(mpServer->mLoop);
+    std::unique_ptr<P2P_Endpoint> pEndpoint;
+    do {
+        pEndpoint = mpServer->mpServer->tryAccept(mErrorCode, AsyncEndpoint::bindConfig(pState, mpServer->mConfig));
+    } while (TcpServer::ACCEPT_RETRY == mErrorCode);
+
+    if (pEndpoint) {
+        mpClient.reset(new AsyncEndpoint(pState, std::move(pEndpoint)));
+        return true;
+    }
+
+    return (0 != mErrorCode);
+}
+
+void AsyncTcpServer::AcceptAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    const bool watched = mpServer->mLoop.watchReadable(mpServer->mpServer->getHandle(), [this, handle]() {
+        if (await_ready()) {
+            handle.resume();
+        } else {
+            // Taken by another server sharing the socket, or aborted by the client
+            await_suspend(handle);
+        }
+    });
+
+    if (!watched) {
+        mpServer->mLoop.post([handle]() { handle.resume(); });
+    }
+}
+
+}  // namespace comm
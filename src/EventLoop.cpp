@@ -0,0 +1,195 @@
+#include "EventLoop.hpp"
+
+#include "common.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace comm {
+
+EventLoop::~EventLoop() {
+    if (0 <= mEventFd) {
+        ::close(mEventFd);
+    }
+
+    if (0 <= mEpollFd) {
+        ::close(mEpollFd);
+    }
+
+    LOGI("Finalized.\n");
+}
+
+std::unique_ptr<EventLoop> EventLoop::create() {
+    std::unique_ptr<EventLoop> pLoop(new EventLoop());
+
+    pLoop->mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (0 > pLoop->mEpollFd) {
+        LOGE("Could not create epoll instance: %d!!!\n", errno);
+        return nullptr;
+    }
+
+    pLoop->mEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (0 > pLoop->mEventFd) {
+        LOGE("Could not create eventfd: %d!!!\n", errno);
+        return nullptr;
+    }
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = pLoop->mEventFd;
+    if (0 > epoll_ctl(pLoop->mEpollFd, EPOLL_CTL_ADD, pLoop->mEventFd, &event)) {
+        LOGE("Could not register eventfd: %d!!!\n", errno);
+        return nullptr;
+    }
+
+    return pLoop;
+}
+
+void EventLoop::post(std::function<void()> callback) {
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(mPostedMutex);
+        wasEmpty = mPosted.empty();
+        mPosted.push_back(std::move(callback));
+    }
+
+    if (wasEmpty) {
+        wakeUp();
+    }
+}
+
+void EventLoop::callAfter(const long& delayUs, std::function<void()> callback) {
+    mTimers.emplace(monotonic_now() + std::chrono::microseconds(delayUs), std::move(callback));
+}
+
+bool EventLoop::watchReadable(const SOCKET& handle, std::function<void()> callback) {
+    struct epoll_event event;
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.fd = handle;
+
+    auto it = mWatchers.find(handle);
+    if (mWatchers.end() == it) {
+        if (0 > epoll_ctl(mEpollFd, EPOLL_CTL_ADD, handle, &event)) {
+            LOGE("Could not register socket %d: %d!!!\n", handle, errno);
+            return false;
+        }
+        it = mWatchers.emplace(handle, nullptr).first;
+    } else if (0 > epoll_ctl(mEpollFd, EPOLL_CTL_MOD, handle, &event)) {
+        LOGE("Could not re-arm socket %d: %d!!!\n", handle, errno);
+        return false;
+    }
+
+    it->second = std::move(callback);
+
+    return true;
+}
+
+void EventLoop::unwatch(const SOCKET& handle) {
+    auto it = mWatchers.find(handle);
+    if (mWatchers.end() != it) {
+        epoll_ctl(mEpollFd, EPOLL_CTL_DEL, handle, nullptr);
+        mWatchers.erase(it);
+    }
+}
+
+void EventLoop::spawn(Task task) {
+    const std::coroutine_handle<> handle = task.release();
+    post([handle]() { handle.resume(); });
+}
+
+void EventLoop::stop() {
+    mExitFlag = true;
+    wakeUp();
+}
+
+void EventLoop::wakeUp() {
+    const uint64_t value = 1ULL;
+    if (sizeof(value) != ::write(mEventFd, &value, sizeof(value))) {
+        // EAGAIN: the counter is saturated, the loop will wake up anyway
+        LOGD("Could not write to eventfd: %d.\n", errno);
+    }
+}
+
+void EventLoop::runPosted() {
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mPostedMutex);
+        callbacks.swap(mPosted);
+    }
+
+    for (auto& callback : callbacks) {
+        callback();
+    }
+}
+
+int EventLoop::runTimers() {
+    while (!mTimers.empty()) {
+        const auto now = monotonic_now();
+        auto it = mTimers.begin();
+        if (it->first > now) {
+            // Rounded up: waking up early would only spin
+            const int64_t remainingUs = std::chrono::duration_cast<std::chrono::microseconds>(it->first - now).count();
+            const int64_t remainingMs = (remainingUs + US_PER_MS - 1) / US_PER_MS;
+            return (WAIT_TIMEOUT_MS < remainingMs) ? WAIT_TIMEOUT_MS : static_cast<int>(remainingMs);
+        }
+
+        // The callback may add timers
+        std::function<void()> callback = std::move(it->second);
+        mTimers.erase(it);
+        callback();
+    }
+
+    return WAIT_TIMEOUT_MS;
+}
+
+void EventLoop::run() {
+    struct epoll_event events[MAX_EVENTS];
+
+    mThreadId = std::this_thread::get_id();
+
+    while (!mExitFlag) {
+        runPosted();
+
+        int timeoutMs = runTimers();
+        {
+            std::lock_guard<std::mutex> lock(mPostedMutex);
+            if (!mPosted.empty()) {
+                timeoutMs = 0;
+            }
+        }
+
+        if (mExitFlag) {
+            break;
+        }
+
+        const int count = epoll_wait(mEpollFd, events, MAX_EVENTS, timeoutMs);
+        if ((0 > count) && (EINTR != errno)) {
+            LOGE("Failed to wait for events: %d!!!\n", errno);
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            const SOCKET handle = events[i].data.fd;
+            if (mEventFd == handle) {
+                uint64_t value;
+                if (sizeof(value) != ::read(mEventFd, &value, sizeof(value))) {
+                    LOGD("Could not read from eventfd: %d.\n", errno);
+                }
+                continue;
+            }
+
+            // Disarmed (one-shot) until renewed by the callback
+            auto it = mWatchers.find(handle);
+            if ((mWatchers.end() != it) && it->second) {
+                std::function<void()> callback = std::move(it->second);
+                it->second = nullptr;
+                callback();
+            }
+        }
+    }
+
+    mThreadId = std::thread::id();
+}
+
+}  // namespace comm
@@ -1,10 +1,14 @@
 #include "IP_Endpoint.hpp"
 
 #include <arpa/inet.h>
+#include <cstring>
 #include <ctime>
 #include <fcntl.h>
 #include <memory>
 #include <netinet/in.h>
+#include <netinet/udp.h>
+#include <poll.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 namespace comm {
@@ -32,10 +36,121 @@ int IP_Endpoint::configureSocket(const SOCKET socketFd) {
     return 0;
 }
 
-ssize_t IP_Endpoint::lread(const std::unique_ptr<uint8_t[]>& pBuffer, const size_t& limit) {
+int IP_Endpoint::lwaitTx(const int& timeoutMs) {
+    mTxSyscallCount++;
+    struct pollfd pollFds[2] = {{mSocketFd, POLLOUT, 0}, {mWakeUpFd, POLLIN, 0}};
+    int ret = poll(pollFds, (0 <= mWakeUpFd) ? 2 : 1, timeoutMs);
+    if (0 > ret) {
+        if (EINTR == errno) {
+            ret = 0;
+        } else {
+            mErrorFlag = true;
+            LOGE("Failed to poll Socket: %d!!!\n", errno);
+        }
+    } else if (0 < ret) {
+        // Woken up: reported as a timeout
+        ret = (0 != pollFds[0].revents) ? 1 : 0;
+    }
+
+    return ret;
+}
+
+ssize_t IP_Endpoint::lflushPendingTx() {
+    ssize_t byteCount = 0;
+    while (hasPendingTx()) {
+        mTxSyscallCount++;
+        ssize_t ret;
+        if (mStreamSocket) {
+            ret = ::send(mSocketFd, mPendingTx.data() + mPendingTxOffset, mPendingTx.size() - mPendingTxOffset, 0);
+        } else {
+            // Datagrams are sent whole, one by one
+            ret = sendto(mSocketFd, mPendingTx.data() + mPendingTxOffset, mPendingDatagramSizes[mPendingDatagramIndex], 0,
+                         (const struct sockaddr*)(&mPeerSockAddr), sizeof(mPeerSockAddr));
+            if (0 < ret) {
+                mPendingDatagramIndex++;
+                mTxDatagramCount++;
+                mTxDatagramBatchCount++;
+            }
+        }
+
+        if (0 < ret) {
+            mPendingTxOffset += ret;
+            byteCount += ret;
+        } else if ((0 > ret) && (EINTR == errno)) {
+            continue;
+        } else if ((0 > ret) && ((EAGAIN == errno) || (EWOULDBLOCK == errno))) {
+            break;
+        } else {
+            mErrorFlag = true;
+            LOGE("Failed to write to Socket: %d!!!\n", errno);
+            return -1;
+        }
+    }
+
+    if (!hasPendingTx()) {
+        mPendingTx.clear();
+        mPendingTxOffset = 0UL;
+        mPendingDatagramSizes.clear();
+        mPendingDatagramIndex = 0UL;
+    }
+
+    LOGD("Transmitted %zd pending bytes.\n", byteCount);
+
+    return byteCount;
+}
+
+int IP_Endpoint::lwaitRx(const int& timeoutMs) {
+    if (mpRxRing) {
+        return lwaitRxRing(timeoutMs);
+    }
+
+    mRxSyscallCount++;
+    struct pollfd pollFds[2] = {{mSocketFd, POLLIN, 0}, {mWakeUpFd, POLLIN, 0}};
+    int ret = poll(pollFds, (0 <= mWakeUpFd) ? 2 : 1, timeoutMs);
+    if (0 > ret) {
+        if (EINTR == errno) {
+            ret = 0;
+        } else {
+            mErrorFlag = true;
+            LOGE("Failed to poll Socket: %d!!!\n", errno);
+        }
+    } else if (0 < ret) {
+        // Woken up: reported as a timeout
+        ret = (0 != pollFds[0].revents) ? 1 : 0;
+    }
+
+    return ret;
+}
+
+void IP_Endpoint::lwakeUp() {
+    if (0 > mWakeUpFd) {
+        return;
+    }
+
+    // Never read: the eventfd stays readable, for both threads
+    const uint64_t value = 1ULL;
+    if (sizeof(value) != ::write(mWakeUpFd, &value, sizeof(value))) {
+        LOGD("Could not write to eventfd: %d.\n", errno);
+    }
+}
+
+ssize_t IP_Endpoint::lread(uint8_t* const pBuffer, const size_t& limit) {
+    if (mpRxRing) {
+        return lreadRing(pBuffer, limit);
+    }
+
+    if (mUdpGro) {
+        return receiveCoalesced(pBuffer, limit);
+    }
+
+    if (1UL < mConfig.udpBatchSize) {
+        return receiveDatagrams(pBuffer, limit);
+    }
+
+    mRxSyscallCount++;
     ssize_t ret = recvfrom(
         mSocketFd,
-        pBuffer.get(),
+        pBuffer,
         limit,
         0,     // flags
         NULL,  // address
@@ -54,40 +169,737 @@ ssize_t IP_Endpoint::lread(const std::unique_ptr<uint8_t[]>& pBuffer, const size
     } else {
         // [TODO] To verify source address against mPeerSockAddr
         LOGD("Received %zd bytes.\n", ret);
+        if (!mStreamSocket) {
+            mRxDatagramCount++;
+            mRxDatagramBatchCount++;
+        }
     }
 
     return ret;
 }
 
+ssize_t IP_Endpoint::receiveDatagrams(uint8_t* const pBuffer, const size_t& limit) {
+    // Each datagram gets a `MAX_FRAME_SIZE` slot, larger ones are truncated (& dropped by the Decoder)
+    size_t vlen = limit / MAX_FRAME_SIZE;
+    if (mConfig.udpBatchSize < vlen) {
+        vlen = mConfig.udpBatchSize;
+    }
+    if (0UL == vlen) {
+        vlen = 1UL;
+    }
+
+    struct iovec iov[MAX_UDP_BATCH_SIZE];
+    struct mmsghdr messages[MAX_UDP_BATCH_SIZE];
+    memset(messages, 0, vlen * sizeof(struct mmsghdr));
+    for (size_t i = 0; i < vlen; i++) {
+        iov[i].iov_base = pBuffer + (i * MAX_FRAME_SIZE);
+        iov[i].iov_len = (limit < ((i + 1) * MAX_FRAME_SIZE)) ? (limit - (i * MAX_FRAME_SIZE)) : MAX_FRAME_SIZE;
+        messages[i].msg_hdr.msg_iov = &iov[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    mRxSyscallCount++;
+    const int ret = recvmmsg(mSocketFd, messages, static_cast<unsigned int>(vlen), MSG_DONTWAIT, NULL);
+    if (0 > ret) {
+        if ((EAGAIN == errno) || (EWOULDBLOCK == errno) || (EINTR == errno)) {
+            return 0;
+        }
+
+        mErrorFlag = true;
+        LOGE("Failed to read from Socket: %d!!!\n", errno);
+        return -1;
+    }
+
+    // Frames are self-delimiting: datagrams are packed one after another for the Decoder
+    size_t byteCount = 0UL;
+    for (int i = 0; i < ret; i++) {
+        const size_t size = messages[i].msg_len;
+        if ((0UL < size) && (byteCount != (i * MAX_FRAME_SIZE))) {
+            memmove(pBuffer + byteCount, iov[i].iov_base, size);
+        }
+        byteCount += size;
+    }
+
+    if (0 < ret) {
+        mRxDatagramCount += static_cast<uint64_t>(ret);
+        mRxDatagramBatchCount++;
+    }
+
+    LOGD("Received %d datagrams (%zu bytes).\n", ret, byteCount);
+
+    return static_cast<ssize_t>(byteCount);
+}
+
+ssize_t IP_Endpoint::receiveCoalesced(uint8_t* const pBuffer, const size_t& limit) {
+    struct iovec iov = {pBuffer, limit};
+    union {
+        char buffer[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr alignment;
+    } control;
+
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+
+    mRxSyscallCount++;
+    const ssize_t ret = recvmsg(mSocketFd, &message, MSG_DONTWAIT);
+    if (0 > ret) {
+        if ((EAGAIN == errno) || (EWOULDBLOCK == errno) || (EINTR == errno)) {
+            return 0;
+        }
+
+        mErrorFlag = true;
+        LOGE("Failed to read from Socket: %d!!!\n", errno);
+        return -1;
+    }
+
+    if (0 != (MSG_TRUNC & message.msg_flags)) {
+        LOGW("Truncated datagram (%zd bytes)!\n", ret);
+    }
+
+    // Without a `UDP_GRO` message, a single datagram was received
+    size_t segmentSize = static_cast<size_t>(ret);
+    for (struct cmsghdr* pCmsg = CMSG_FIRSTHDR(&message); nullptr != pCmsg; pCmsg = CMSG_NXTHDR(&message, pCmsg)) {
+        if ((SOL_UDP == pCmsg->cmsg_level) && (UDP_GRO == pCmsg->cmsg_type)) {
+            int gsoSize = 0;
+            memcpy(&gsoSize, CMSG_DATA(pCmsg), sizeof(gsoSize));
+            if (0 < gsoSize) {
+                segmentSize = static_cast<size_t>(gsoSize);
+            }
+        }
+    }
+
+    if (0 < ret) {
+        mRxDatagramCount += (static_cast<size_t>(ret) + segmentSize - 1UL) / segmentSize;
+        mRxDatagramBatchCount++;
+    }
+
+    LOGD("Received %zd bytes (segment size: %zu).\n", ret, segmentSize);
+
+    return ret;
+}
+
+bool IP_Endpoint::setupSegmentOffload() {
+    // Segment sizes are given per message, the option is only read to probe for support (4.18)
+    int value = 0;
+    socklen_t optionLength = sizeof(value);
+    mUdpGso = (0 == getsockopt(mSocketFd, SOL_UDP, UDP_SEGMENT, &value, &optionLength));
+    if (!mUdpGso) {
+        LOGW("`UDP_SEGMENT` is not supported: %d!\n", errno);
+    }
+
+    // Coalesced datagrams may not fit into the free room of a Rx slab
+    if (!mConfig.zeroCopyRx) {
+        value = 1;
+        mUdpGro = (0 == setsockopt(mSocketFd, SOL_UDP, UDP_GRO, &value, sizeof(value)));
+        if (!mUdpGro) {
+            LOGW("`UDP_GRO` is not supported: %d!\n", errno);
+        }
+    }
+
+    return mUdpGso || mUdpGro;
+}
+
 ssize_t IP_Endpoint::lwrite(const std::unique_ptr<uint8_t[]>& pData, const size_t& size) {
+    const IoSegment segment = {pData.get(), size};
+    const ssize_t ret = lwritev(&segment, 1UL);
+
+    // The data is only borrowed for the duration of the call
+    return ((0 > ret) || (0 > lflush())) ? -1 : ret;
+}
+
+ssize_t IP_Endpoint::lwritev(const IoSegment* const pSegments, const size_t& count) {
+    if (MAX_IO_SEGMENTS < count) {
+        LOGE("Too many segments: %zu!!!\n", count);
+        return -1;
+    }
+
+    if (mpTxRing) {
+        return lwritevRing(pSegments, count);
+    }
+
+    if (mpTxDatagrams) {
+        return queueDatagram(pSegments, count);
+    }
+
+    return sendSegments(pSegments, count);
+}
+
+ssize_t IP_Endpoint::queueDatagram(const IoSegment* const pSegments, const size_t& count) {
+    size_t size = 0UL;
+    for (size_t i = 0; i < count; i++) {
+        size += pSegments[i].size;
+    }
+
+    if (MAX_FRAME_SIZE < size) {
+        // Does not fit into a slot: written directly, after queued datagrams
+        return (0 > lflush()) ? -1 : sendSegments(pSegments, count);
+    }
+
+    if ((mConfig.udpBatchSize <= mQueuedDatagrams) && (0 > lflush())) {
+        return -1;
+    }
+
+    uint8_t* pSlot = mpTxDatagrams.get() + (mQueuedDatagrams * MAX_FRAME_SIZE);
+    for (size_t i = 0; i < count; i++) {
+        memcpy(pSlot, pSegments[i].pData, pSegments[i].size);
+        pSlot += pSegments[i].size;
+    }
+    mTxDatagramSizes[mQueuedDatagrams] = size;
+    mQueuedDatagrams++;
+
+    return static_cast<ssize_t>(size);
+}
+
+ssize_t IP_Endpoint::sendDatagrams() {
+    if (0UL == mQueuedDatagrams) {
+        return 0;
+    }
+
+    // In order: nothing is written directly while older datagrams are pending
+    if (hasPendingTx() && (0 > lflushPendingTx())) {
+        mQueuedDatagrams = 0UL;
+        return -1;
+    }
+
+    if (hasPendingTx()) {
+        return keepQueuedDatagrams(0UL);
+    }
+
+    struct iovec iov[MAX_UDP_BATCH_SIZE];
+    for (size_t i = 0; i < mQueuedDatagrams; i++) {
+        iov[i].iov_base = mpTxDatagrams.get() + (i * MAX_FRAME_SIZE);
+        iov[i].iov_len = mTxDatagramSizes[i];
+    }
+
+    // One message per datagram, or per run of segments (equal sizes, the last one may be smaller) with `UDP_SEGMENT`
+    struct mmsghdr messages[MAX_UDP_BATCH_SIZE];
+    size_t segmentCounts[MAX_UDP_BATCH_SIZE];
+    union {
+        char buffer[CMSG_SPACE(sizeof(uint16_t))];
+        struct cmsghdr alignment;
+    } controls[MAX_UDP_BATCH_SIZE];
+
+    size_t messageCount = 0UL;
+    memset(messages, 0, mQueuedDatagrams * sizeof(struct mmsghdr));
+    for (size_t i = 0; i < mQueuedDatagrams; messageCount++) {
+        const size_t segmentSize = mTxDatagramSizes[i];
+        size_t segmentCount = 1UL;
+        if (mUdpGso) {
+            size_t size = segmentSize;
+            while (((i + segmentCount) < mQueuedDatagrams) && (segmentSize >= mTxDatagramSizes[i + segmentCount]) &&
+                   (UDP_GSO_BYTE_LIMIT >= (size + mTxDatagramSizes[i + segmentCount]))) {
+                size += mTxDatagramSizes[i + segmentCount];
+                segmentCount++;
+                if (segmentSize > mTxDatagramSizes[i + segmentCount - 1UL]) {
+                    break;
+                }
+            }
+        }
+
+        struct msghdr& message = messages[messageCount].msg_hdr;
+        message.msg_name = &mPeerSockAddr;
+        message.msg_namelen = sizeof(mPeerSockAddr);
+        message.msg_iov = &iov[i];
+        message.msg_iovlen = segmentCount;
+        if (1UL < segmentCount) {
+            message.msg_control = controls[messageCount].buffer;
+            message.msg_controllen = sizeof(controls[messageCount].buffer);
+
+            struct cmsghdr* const pCmsg = CMSG_FIRSTHDR(&message);
+            pCmsg->cmsg_level = SOL_UDP;
+            pCmsg->cmsg_type = UDP_SEGMENT;
+            pCmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            const uint16_t gsoSize = static_cast<uint16_t>(segmentSize);
+            memcpy(CMSG_DATA(pCmsg), &gsoSize, sizeof(gsoSize));
+        }
+
+        segmentCounts[messageCount] = segmentCount;
+        i += segmentCount;
+    }
+
+    // Datagrams are sent whole or not at all, in order
+    size_t sent = 0UL;
+    size_t sentDatagrams = 0UL;
+    ssize_t byteCount = 0;
+    for (int i = 0; (i < TX_RETRY_LIMIT) && (sent < messageCount); i++) {
+        mTxSyscallCount++;
+        const int ret = sendmmsg(mSocketFd, messages + sent, static_cast<unsigned int>(messageCount - sent), 0);
+        if (0 < ret) {
+            for (int j = 0; j < ret; j++) {
+                byteCount += messages[sent + j].msg_len;
+                sentDatagrams += segmentCounts[sent + j];
+                mTxDatagramCount += segmentCounts[sent + j];
+            }
+            sent += static_cast<size_t>(ret);
+            mTxDatagramBatchCount++;
+        } else if ((0 > ret) && (EIO == errno) && mUdpGso) {
+            // The route cannot segment (e.g. no checksum offload): remaining datagrams are written one by one
+            LOGW("`UDP_SEGMENT` was disabled!\n");
+            mUdpGso = false;
+
+            const size_t remaining = mQueuedDatagrams - sentDatagrams;
+            memmove(mpTxDatagrams.get(), mpTxDatagrams.get() + (sentDatagrams * MAX_FRAME_SIZE), remaining * MAX_FRAME_SIZE);
+            memmove(mTxDatagramSizes, mTxDatagramSizes + sentDatagrams, remaining * sizeof(size_t));
+            mQueuedDatagrams = remaining;
+
+            const ssize_t remainingByteCount = sendDatagrams();
+            return (0 > remainingByteCount) ? -1 : (byteCount + remainingByteCount);
+        } else if ((0 > ret) && ((EAGAIN == errno) || (EWOULDBLOCK == errno) || (EINTR == errno))) {
+            LOGD("`sendmmsg()` returned `EWOULDBLOCK`.\n");
+
+            if (mConfig.pReactor) {
+                // I/O threads must never block: remaining datagrams are sent once the socket becomes writable
+                return byteCount + keepQueuedDatagrams(sentDatagrams);
+            }
+
+            // Dedicated Tx thread: wait for room in the socket buffer
+            if (0 > lwaitTx(TX_POLL_TIMEOUT_MS)) {
+                mQueuedDatagrams = 0UL;
+                return -1;
+            }
+        } else {
+            mErrorFlag = true;
+            LOGE("Failed to write to Socket: %d!!!\n", errno);
+            mQueuedDatagrams = 0UL;
+            return -1;
+        }
+    }
+
+    if (sentDatagrams < mQueuedDatagrams) {
+        LOGW("Dropped %zu datagrams!\n", mQueuedDatagrams - sentDatagrams);
+    }
+    mQueuedDatagrams = 0UL;
+
+    LOGD("Transmitted %zd bytes.\n", byteCount);
+
+    return byteCount;
+}
+
+ssize_t IP_Endpoint::keepQueuedDatagrams(const size_t& first) {
+    ssize_t byteCount = 0;
+    for (size_t i = first; i < mQueuedDatagrams; i++) {
+        const IoSegment segment = {mpTxDatagrams.get() + (i * MAX_FRAME_SIZE), mTxDatagramSizes[i]};
+        byteCount += keepPendingDatagram(&segment, 1UL);
+    }
+    mQueuedDatagrams = 0UL;
+
+    return byteCount;
+}
+
+ssize_t IP_Endpoint::sendSegments(const IoSegment* const pSegments, const size_t& count) {
+    struct iovec iov[MAX_IO_SEGMENTS];
+    for (size_t i = 0; i < count; i++) {
+        iov[i].iov_base = const_cast<uint8_t*>(pSegments[i].pData);
+        iov[i].iov_len = pSegments[i].size;
+    }
+
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_name = &mPeerSockAddr;
+    message.msg_namelen = sizeof(mPeerSockAddr);
+    message.msg_iov = iov;
+    message.msg_iovlen = count;
+
     ssize_t ret = 0;
+    if (mStreamSocket) {
+        // Bytes must leave in order: nothing is written directly while older bytes are pending
+        if (hasPendingTx() && (0 > lflushPendingTx())) {
+            return -1;
+        }
+
+        if (!hasPendingTx()) {
+            mTxSyscallCount++;
+            ret = sendmsg(mSocketFd, &message, 0);
+            if (0 > ret) {
+                if ((EAGAIN == errno) || (EWOULDBLOCK == errno) || (EINTR == errno)) {
+                    ret = 0;
+                } else {
+                    mErrorFlag = true;
+                    LOGE("Failed to write to Socket: %d!!!\n", errno);
+                    return -1;
+                }
+            }
+        }
+
+        // A short write must not drop the tail of a frame: unsent bytes are kept until the socket becomes writable
+        return keepPendingTx(pSegments, count, static_cast<size_t>(ret));
+    }
+
+    // Datagrams are sent whole or not at all, in order: nothing is written directly while older datagrams are pending
+    if (hasPendingTx() && (0 > lflushPendingTx())) {
+        return -1;
+    }
+
+    if (hasPendingTx()) {
+        return keepPendingDatagram(pSegments, count);
+    }
+
     for (int i = 0; (i < TX_RETRY_LIMIT); i++) {
-        ret = sendto(
-            mSocketFd,
-            pData.get(),
-            size,
-            0,                                         // flags
-            (const struct sockaddr*)(&mPeerSockAddr),  // dest_address
-            sizeof(mPeerSockAddr)                      // dest_address_len
-        );
+        mTxSyscallCount++;
+        ret = sendmsg(mSocketFd, &message, 0);
         if (0 < ret) {
             LOGD("Transmitted %zd bytes.\n", ret);
+            mTxDatagramCount++;
+            mTxDatagramBatchCount++;
             break;
         } else if (0 == ret) {
             // Should not happen!!!
             LOGW("No data was sent via `sendmsg()`!\n");
-        } else if (EWOULDBLOCK == errno) {
+        } else if ((EAGAIN == errno) || (EWOULDBLOCK == errno)) {
             ret = 0;
             LOGD("`sendmsg()` returned `EWOULDBLOCK`.\n");
+
+            if (mConfig.pReactor) {
+                // I/O threads must never block: the datagram is sent once the socket becomes writable
+                return keepPendingDatagram(pSegments, count);
+            }
+
+            // Dedicated Tx thread: wait for room in the socket buffer
+            if (0 > lwaitTx(TX_POLL_TIMEOUT_MS)) {
+                return -1;
+            }
         } else {
             mErrorFlag = true;
             LOGE("Failed to write to Socket: %d!!!\n", errno);
             break;
         }
-
-        sleep_for(TX_RETRY_BREAK_US);  // [Risk] Shared resources' ownership?
     }
 
     return ret;
 }
+
+bool IP_Endpoint::setupIoUring() {
+    if (mConfig.pReactor) {
+        LOGW("io_uring backend is not supported in reactor mode!\n");
+        return false;
+    }
+
+    // Completions of the multishot receive are bounded by the number of provided buffers.
+    // Requests are cancelled when the thread which submitted them exits: the receive is armed by the Rx thread.
+    mpRxRing = IoUring::create(URING_RX_SQ_ENTRIES, 2U * URING_RX_BUFFER_COUNT);
+    mpTxRing = IoUring::create(URING_TX_DEPTH);
+    if ((!mpRxRing) || (!mpTxRing) ||
+        !mpRxRing->setupBufferRing(URING_RX_BUFFER_GROUP, URING_RX_BUFFER_COUNT, URING_RX_BUFFER_SIZE)) {
+        mpRxRing.reset();
+        mpTxRing.reset();
+        return false;
+    }
+
+    mTxSlotCapacity = mConfig.txBatchPacketLimit * SEGMENTS_PER_FRAME;
+    mpTxSlots.reset(new TxSlot[URING_TX_DEPTH]);
+    for (unsigned i = 0; i < URING_TX_DEPTH; i++) {
+        mpTxSlots[i].pIov.reset(new struct iovec[mTxSlotCapacity]);
+        mpTxSlots[i].pCopies.reset(new uint8_t[mTxSlotCapacity * URING_TX_COPY_LIMIT]);
+    }
+
+    LOGI("io_uring backend is enabled.\n");
+
+    return true;
+}
+
+bool IP_Endpoint::armRx() {
+    struct io_uring_sqe* const pSqe = mpRxRing->getSqe();
+    if (nullptr == pSqe) {
+        LOGE("io_uring submission queue is full!!!\n");
+        return false;
+    }
+
+    pSqe->opcode = IORING_OP_RECV;
+    pSqe->fd = mSocketFd;
+    pSqe->ioprio = IORING_RECV_MULTISHOT;
+    pSqe->flags = IOSQE_BUFFER_SELECT;
+    pSqe->buf_group = URING_RX_BUFFER_GROUP;
+    mRxArmed = true;
+
+    return true;
+}
+
+bool IP_Endpoint::armWakeUp() {
+    struct io_uring_sqe* const pSqe = mpRxRing->getSqe();
+    if (nullptr == pSqe) {
+        LOGE("io_uring submission queue is full!!!\n");
+        return false;
+    }
+
+    pSqe->opcode = IORING_OP_POLL_ADD;
+    pSqe->fd = mWakeUpFd;
+    pSqe->poll32_events = POLLIN;
+    pSqe->user_data = URING_WAKEUP_USER_DATA;
+    mWakeUpArmed = true;
+
+    return true;
+}
+
+int IP_Endpoint::lwaitRxRing(const int& timeoutMs) {
+    if ((0UL < mRxBufferPending) || mpRxRing->hasCqe()) {
+        return 1;
+    }
+
+    // Submitted along with the receive, by the Rx thread (see `setupIoUring()`)
+    if ((0 <= mWakeUpFd) && (!mWakeUpArmed) && !armWakeUp()) {
+        mErrorFlag = true;
+        return -1;
+    }
+
+    // The multishot receive terminated (e.g. provided buffers ran out), it is re-armed by the same system call
+    if ((!mRxArmed) && !armRx()) {
+        mErrorFlag = true;
+        return -1;
+    }
+
+    mRxSyscallCount++;
+    const int ret = mpRxRing->enter(1U, timeoutMs);
+    if (0 > ret) {
+        mErrorFlag = true;
+        LOGE("Failed to wait for io_uring completions: %d!!!\n", -ret);
+        return -1;
+    }
+
+    return mpRxRing->hasCqe() ? 1 : 0;
+}
+
+ssize_t IP_Endpoint::lreadRing(uint8_t* const pBuffer, const size_t& limit) {
+    while (0UL == mRxBufferPending) {
+        struct io_uring_cqe cqe;
+        if (!mpRxRing->popCqe(cqe)) {
+            // Busy-polling readers (see `P2P_Endpoint::spinRx()`) never wait, the receive is re-armed here
+            if (!mRxArmed) {
+                mRxSyscallCount++;
+                if (!armRx() || (0 > mpRxRing->enter(0U))) {
+                    mErrorFlag = true;
+                    return -1;
+                }
+            }
+
+            return 0;
+        }
+
+        if (URING_WAKEUP_USER_DATA == cqe.user_data) {
+            // The endpoint stops
+            continue;
+        }
+
+        if (0U == (cqe.flags & IORING_CQE_F_MORE)) {
+            mRxArmed = false;
+        }
+
+        const bool hasBuffer = (0U != (cqe.flags & IORING_CQE_F_BUFFER));
+        const uint16_t bufferId = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        if (0 < cqe.res) {
+            if (!hasBuffer) {
+                mErrorFlag = true;
+                LOGE("io_uring completion without buffer!!!\n");
+                return -1;
+            }
+
+            mRxReceived = true;
+            mRxBufferId = bufferId;
+            mRxBufferOffset = 0UL;
+            mRxBufferPending = static_cast<size_t>(cqe.res);
+            LOGD("Received %d bytes.\n", cqe.res);
+        } else {
+            if (hasBuffer) {
+                mpRxRing->recycleBuffer(bufferId);
+            }
+
+            if (0 == cqe.res) {
+                // Potential: the peer has performed an orderly shutdown.
+                mErrorFlag = true;
+                return 0;
+            } else if ((-EINVAL == cqe.res) && !mRxReceived) {
+                // Multishot receive is not supported (before Linux 6.0)
+                LOGW("Multishot receive is not supported, fall back to socket I/O (Rx)!\n");
+                mpRxRing.reset();
+                return 0;
+            } else if (-ENOBUFS != cqe.res) {
+                mErrorFlag = true;
+                LOGE("Failed to read from Socket: %d!!!\n", -cqe.res);
+                return -1;
+            } else {
+                // Provided buffers ran out, the receive is re-armed once they are recycled
+            }
+        }
+    }
+
+    const size_t byteCount = (limit < mRxBufferPending) ? limit : mRxBufferPending;
+    memcpy(pBuffer, mpRxRing->getBuffer(mRxBufferId) + mRxBufferOffset, byteCount);
+    mRxBufferOffset += byteCount;
+    mRxBufferPending -= byteCount;
+    if (0UL == mRxBufferPending) {
+        mpRxRing->recycleBuffer(mRxBufferId);
+    }
+
+    return static_cast<ssize_t>(byteCount);
+}
+
+ssize_t IP_Endpoint::lwritevRing(const IoSegment* const pSegments, const size_t& count) {
+    if (mTxSlotCapacity < count) {
+        // Larger than any Tx batch: written directly, after queued writes
+        return (0 > lflush()) ? -1 : sendSegments(pSegments, count);
+    }
+
+    // Bytes must leave in order: nothing is queued while older bytes are pending
+    if (hasPendingTx() && (0 > lflushPendingTx())) {
+        return -1;
+    }
+
+    if (hasPendingTx()) {
+        return mStreamSocket ? keepPendingTx(pSegments, count, 0UL) : keepPendingDatagram(pSegments, count);
+    }
+
+    if ((URING_TX_DEPTH <= mTxQueued) && (0 > lflush())) {
+        return -1;
+    }
+
+    struct io_uring_sqe* const pSqe = mpTxRing->getSqe();
+    if (nullptr == pSqe) {
+        mErrorFlag = true;
+        LOGE("io_uring submission queue is full!!!\n");
+        return -1;
+    }
+
+    TxSlot& slot = mpTxSlots[mTxQueued];
+    size_t size = 0UL;
+    for (size_t i = 0; i < count; i++) {
+        if (URING_TX_COPY_LIMIT >= pSegments[i].size) {
+            uint8_t* const pCopy = slot.pCopies.get() + (i * URING_TX_COPY_LIMIT);
+            memcpy(pCopy, pSegments[i].pData, pSegments[i].size);
+            slot.pIov[i].iov_base = pCopy;
+        } else {
+            slot.pIov[i].iov_base = const_cast<uint8_t*>(pSegments[i].pData);
+        }
+        slot.pIov[i].iov_len = pSegments[i].size;
+        size += pSegments[i].size;
+    }
+
+    memset(&slot.message, 0, sizeof(slot.message));
+    slot.message.msg_name = &mPeerSockAddr;
+    slot.message.msg_namelen = sizeof(mPeerSockAddr);
+    slot.message.msg_iov = slot.pIov.get();
+    slot.message.msg_iovlen = count;
+    slot.size = size;
+    slot.completed = false;
+
+    // Never waits for room in the socket buffer. Stream sockets: a partial write completes short & breaks the link
+    pSqe->opcode = IORING_OP_SENDMSG;
+    pSqe->fd = mSocketFd;
+    pSqe->addr = reinterpret_cast<uint64_t>(&slot.message);
+    pSqe->msg_flags = mStreamSocket ? (MSG_DONTWAIT | MSG_WAITALL) : MSG_DONTWAIT;
+    pSqe->user_data = mTxQueued;
+
+    // Linked writes are performed in order
+    if (nullptr != mpLastTxSqe) {
+        mpLastTxSqe->flags |= IOSQE_IO_LINK;
+    }
+    mpLastTxSqe = pSqe;
+    mTxQueued++;
+
+    return static_cast<ssize_t>(size);
+}
+
+ssize_t IP_Endpoint::lflush() {
+    if (mpTxDatagrams) {
+        return sendDatagrams();
+    }
+
+    return flushTxRing();
+}
+
+ssize_t IP_Endpoint::flushTxRing() {
+    if ((!mpTxRing) || (0U == mTxQueued)) {
+        return 0;
+    }
+
+    // All queued writes are submitted & reaped with a single system call (unless they do not complete in time)
+    const unsigned queuedCount = mTxQueued;
+    unsigned pendingCount = mTxQueued;
+    mTxQueued = 0U;
+    mpLastTxSqe = nullptr;
+
+    bool cancelled = false;
+    while (0U < pendingCount) {
+        mTxSyscallCount++;
+        const int ret = mpTxRing->enter(pendingCount, TX_POLL_TIMEOUT_MS);
+        if (0 > ret) {
+            mErrorFlag = true;
+            LOGE("Failed to submit io_uring requests: %d!!!\n", -ret);
+            return -1;
+        }
+
+        struct io_uring_cqe cqe;
+        while (mpTxRing->popCqe(cqe)) {
+            if (URING_TX_CANCEL_USER_DATA == cqe.user_data) {
+                // Cancellation: its target completes on its own
+                continue;
+            }
+
+            TxSlot& slot = mpTxSlots[cqe.user_data];
+            slot.result = cqe.res;
+            slot.completed = true;
+            pendingCount--;
+        }
+
+        if ((0U < pendingCount) && !cancelled) {
+            // Writes may only refer to the callers' data until this returns: those still in flight are cancelled
+            LOGW("%u writes did not complete in time, cancelling!\n", pendingCount);
+            for (unsigned i = 0; i < queuedCount; i++) {
+                struct io_uring_sqe* const pSqe = mpTxSlots[i].completed ? nullptr : mpTxRing->getSqe();
+                if (nullptr != pSqe) {
+                    pSqe->opcode = IORING_OP_ASYNC_CANCEL;
+                    pSqe->addr = i;
+                    pSqe->user_data = URING_TX_CANCEL_USER_DATA;
+                }
+            }
+            cancelled = true;
+        }
+    }
+
+    // Writes are linked: once one is short, the following ones are cancelled & kept whole
+    ssize_t byteCount = 0;
+    int errorCode = 0;
+    bool keeping = false;
+    for (unsigned i = 0; (i < queuedCount) && (0 == errorCode); i++) {
+        const TxSlot& slot = mpTxSlots[i];
+        const size_t writtenCount = (0 < slot.result) ? static_cast<size_t>(slot.result) : 0UL;
+        if ((0 > slot.result) && (-EAGAIN != slot.result) && (-ECANCELED != slot.result) && (-EINTR != slot.result)) {
+            errorCode = -slot.result;
+        } else if (keeping && (0UL < writtenCount)) {
+            // Should not happen!!! Bytes would leave out of order
+            errorCode = EPROTO;
+        } else if (keeping || (writtenCount < slot.size)) {
+            // A short write must not drop the tail of a frame: unsent bytes are kept until the socket becomes writable
+            LOGD("Wrote %zu/%zu bytes.\n", writtenCount, slot.size);
+            byteCount += keepTxSlot(slot, writtenCount);
+            keeping = true;
+        } else {
+            byteCount += slot.size;
+        }
+    }
+
+    if (0 != errorCode) {
+        mErrorFlag = true;
+        LOGE("Failed to write to Socket: %d!!!\n", errorCode);
+        return -1;
+    }
+
+    LOGD("Transmitted %zd bytes.\n", byteCount);
+
+    return byteCount;
+}
+
+ssize_t IP_Endpoint::keepTxSlot(const TxSlot& slot, const size_t& writtenCount) {
+    IoSegment segments[MAX_IO_SEGMENTS];
+    for (size_t i = 0; i < slot.message.msg_iovlen; i++) {
+        segments[i].pData = static_cast<const uint8_t*>(slot.pIov[i].iov_base);
+        segments[i].size = slot.pIov[i].iov_len;
+    }
+
+    // Datagrams are sent whole or not at all
+    return mStreamSocket ? keepPendingTx(segments, slot.message.msg_iovlen, writtenCount)
+                         : keepPendingDatagram(segments, slot.message.msg_iovlen);
+}
 }  // namespace comm
@@ -26,13 +26,78 @@ int IP_Endpoint::configureSocket(const SOCKET socketFd) {
     return 0;
 }
 
-ssize_t IP_Endpoint::lread(const std::unique_ptr<uint8_t[]>& pBuffer, const size_t& limit) {
+int IP_Endpoint::lwaitTx(const int& timeoutMs) {
+    mTxSyscallCount++;
+    WSAPOLLFD pollFd = {mSocketFd, POLLWRNORM, 0};
+    int ret = WSAPoll(&pollFd, 1, timeoutMs);
+    if (SOCKET_ERROR == ret) {
+        ret = -1;
+        mErrorFlag = true;
+        LOGE("Failed to poll Socket: %d!!!\n", WSAGetLastError());
+    }
+
+    return ret;
+}
+
+ssize_t IP_Endpoint::lflushPendingTx() {
+    ssize_t byteCount = 0;
+    while (hasPendingTx()) {
+        mTxSyscallCount++;
+        int ret;
+        if (mStreamSocket) {
+            ret = ::send(mSocketFd, (const char*)(mPendingTx.data() + mPendingTxOffset), (int)(mPendingTx.size() - mPendingTxOffset), 0);
+        } else {
+            // Datagrams are sent whole, one by one
+            ret = sendto(mSocketFd, (const char*)(mPendingTx.data() + mPendingTxOffset), (int)(mPendingDatagramSizes[mPendingDatagramIndex]), 0,
+                         (const struct sockaddr*)(&mPeerSockAddr), sizeof(mPeerSockAddr));
+            if (0 < ret) {
+                mPendingDatagramIndex++;
+            }
+        }
+
+        if (0 < ret) {
+            mPendingTxOffset += ret;
+            byteCount += ret;
+        } else if ((SOCKET_ERROR == ret) && (WSAEWOULDBLOCK == WSAGetLastError())) {
+            break;
+        } else {
+            mErrorFlag = true;
+            LOGE("Failed to write to Socket: %d!!!\n", WSAGetLastError());
+            return -1;
+        }
+    }
+
+    if (!hasPendingTx()) {
+        mPendingTx.clear();
+        mPendingTxOffset = 0UL;
+        mPendingDatagramSizes.clear();
+        mPendingDatagramIndex = 0UL;
+    }
+
+    return byteCount;
+}
+
+int IP_Endpoint::lwaitRx(const int& timeoutMs) {
+    mRxSyscallCount++;
+    WSAPOLLFD pollFd = {mSocketFd, POLLRDNORM, 0};
+    int ret = WSAPoll(&pollFd, 1, timeoutMs);
+    if (SOCKET_ERROR == ret) {
+        ret = -1;
+        mErrorFlag = true;
+        LOGE("Failed to poll Socket: %d!!!\n", WSAGetLastError());
+    }
+
+    return ret;
+}
+
+ssize_t IP_Endpoint::lread(uint8_t* const pBuffer, const size_t& limit) {
     WSABUF bufferWrapper = {
         .len = (ULONG)limit,
-        .buf = (CHAR*)(pBuffer.get())};
+        .buf = (CHAR*)(pBuffer)};
 
     ssize_t byteCount = 0;
     DWORD flags = 0;
+    mRxSyscallCount++;
     int ret = WSARecvFrom(
         mSocketFd,
         &bufferWrapper, 1,
@@ -64,17 +129,72 @@ ssize_t IP_Endpoint::lread(const std::unique_ptr<uint8_t[]>& pBuffer, const size
 }
 
 ssize_t IP_Endpoint::lwrite(const std::unique_ptr<uint8_t[]>& pData, const size_t& size) {
-    WSABUF dataWrapper = {
-        .len = (ULONG)size,
-        .buf = (CHAR*)(pData.get())};
+    const IoSegment segment = {pData.get(), size};
+    return lwritev(&segment, 1UL);
+}
+
+ssize_t IP_Endpoint::lwritev(const IoSegment* const pSegments, const size_t& count) {
+    if (MAX_IO_SEGMENTS < count) {
+        LOGE("Too many segments: %zu!!!\n", count);
+        return -1;
+    }
+
+    WSABUF dataWrappers[MAX_IO_SEGMENTS];
+    for (size_t i = 0; i < count; i++) {
+        dataWrappers[i].len = (ULONG)(pSegments[i].size);
+        dataWrappers[i].buf = (CHAR*)(pSegments[i].pData);
+    }
 
     int ret;
     ssize_t byteCount = 0;
+    if (mStreamSocket) {
+        // Bytes must leave in order: nothing is written directly while older bytes are pending
+        if (hasPendingTx() && (0 > lflushPendingTx())) {
+            return -1;
+        }
+
+        if (!hasPendingTx()) {
+            mTxSyscallCount++;
+            ret = WSASend(
+                mSocketFd,
+                dataWrappers,           // lpBuffers
+                (DWORD)count,           // dwBufferCount
+                (LPDWORD)(&byteCount),  // lpNumberOfBytesSent
+                0,                      // dwFlags
+                NULL,                   // lpOverlapped: NULL for Non-overlapped
+                NULL                    // lpCompletionRoutine: NULL for Non-overlapped
+            );
+
+            if (SOCKET_ERROR == ret) {
+                if (WSAEWOULDBLOCK == WSAGetLastError()) {
+                    byteCount = 0;
+                } else {
+                    mErrorFlag = true;
+                    LOGE("Failed to write to Socket: %d!!!\n", WSAGetLastError());
+                    return -1;
+                }
+            }
+        }
+
+        // A short write must not drop the tail of a frame: unsent bytes are kept until the socket becomes writable
+        return keepPendingTx(pSegments, count, static_cast<size_t>(byteCount));
+    }
+
+    // Datagrams are sent whole or not at all, in order: nothing is written directly while older datagrams are pending
+    if (hasPendingTx() && (0 > lflushPendingTx())) {
+        return -1;
+    }
+
+    if (hasPendingTx()) {
+        return keepPendingDatagram(pSegments, count);
+    }
+
     for (int i = 0; (i < TX_RETRY_LIMIT); i++) {
+        mTxSyscallCount++;
         ret = WSASendTo(
             mSocketFd,
-            &dataWrapper,                            // lpBuffers
-            1,                                       // dwBufferCount
+            dataWrappers,                            // lpBuffers
+            (DWORD)count,                            // dwBufferCount
             (LPDWORD)(&byteCount),                   // lpNumberOfBytesSent
             0,                                       // dwFlags
             (const struct sockaddr*)&mPeerSockAddr,  // lpTo
@@ -99,9 +219,18 @@ ssize_t IP_Endpoint::lwrite(const std::unique_ptr<uint8_t[]>& pData, const size_
             }
         } else {
             if (WSAEWOULDBLOCK == WSAGetLastError()) {
-                // Ignore & retry
                 byteCount = 0;
                 LOGD("`WSASendMsg()` returned `WSAEWOULDBLOCK`.\n");
+                if (mConfig.pReactor) {
+                    // I/O threads must never block: the datagram is sent once the socket becomes writable
+                    return keepPendingDatagram(pSegments, count);
+                }
+
+                // Dedicated Tx thread: wait for room in the socket buffer & retry
+                if (0 > lwaitTx(TX_POLL_TIMEOUT_MS)) {
+                    return -1;
+                }
+                continue;
             } else {
                 byteCount = -1;
                 mErrorFlag = true;
@@ -0,0 +1,342 @@
+#include "IoUring.hpp"
+
+#include "common.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace comm {
+
+static inline unsigned load_acquire(const unsigned* const p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void store_release(unsigned* const p, const unsigned value) {
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+IoUring::~IoUring() {
+    // Closing the ring cancels requests in flight, buffers are released afterwards
+    if (0 <= mRingFd) {
+        ::close(mRingFd);
+    }
+
+    if (nullptr != mpSqes) {
+        munmap(mpSqes, mSqesSize);
+    }
+
+    if (nullptr != mpRingMemory) {
+        munmap(mpRingMemory, mRingMemorySize);
+    }
+
+    if (nullptr != mpBufferRing) {
+        munmap(mpBufferRing, mBufferRingSize);
+    }
+}
+
+std::unique_ptr<IoUring> IoUring::create(const unsigned& sqEntries, const unsigned& cqEntries) {
+    std::unique_ptr<IoUring> pRing(new IoUring());
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CLAMP;
+    if (0U < cqEntries) {
+        params.flags |= IORING_SETUP_CQSIZE;
+        params.cq_entries = cqEntries;
+    }
+
+    pRing->mRingFd = static_cast<int>(syscall(__NR_io_uring_setup, sqEntries, &params));
+    if (0 > pRing->mRingFd) {
+        LOGW("io_uring is unavailable: %d!\n", errno);
+        return nullptr;
+    }
+
+    // Single mapping of both rings (5.4) & waiting with a timeout (5.11)
+    if ((0U == (params.features & IORING_FEAT_SINGLE_MMAP)) || (0U == (params.features & IORING_FEAT_EXT_ARG))) {
+        LOGW("io_uring features are not supported: 0x%x!\n", params.features);
+        return nullptr;
+    }
+
+    const size_t sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    const size_t cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    pRing->mRingMemorySize = (sqRingSize > cqRingSize) ? sqRingSize : cqRingSize;
+
+    void* pMemory = mmap(nullptr, pRing->mRingMemorySize, (PROT_READ | PROT_WRITE), (MAP_SHARED | MAP_POPULATE),
+                         pRing->mRingFd, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == pMemory) {
+        LOGE("Failed to map io_uring rings: %d!!!\n", errno);
+        return nullptr;
+    }
+    pRing->mpRingMemory = pMemory;
+
+    pRing->mSqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    pMemory = mmap(nullptr, pRing->mSqesSize, (PROT_READ | PROT_WRITE), (MAP_SHARED | MAP_POPULATE),
+                   pRing->mRingFd, IORING_OFF_SQES);
+    if (MAP_FAILED == pMemory) {
+        LOGE("Failed to map io_uring submission entries: %d!!!\n", errno);
+        return nullptr;
+    }
+    pRing->mpSqes = static_cast<struct io_uring_sqe*>(pMemory);
+
+    uint8_t* const pBase = static_cast<uint8_t*>(pRing->mpRingMemory);
+    pRing->mpSqHead = reinterpret_cast<unsigned*>(pBase + params.sq_off.head);
+    pRing->mpSqTail = reinterpret_cast<unsigned*>(pBase + params.sq_off.tail);
+    pRing->mSqMask = *reinterpret_cast<unsigned*>(pBase + params.sq_off.ring_mask);
+    pRing->mSqEntries = params.sq_entries;
+    pRing->mSqTail = *pRing->mpSqTail;
+
+    // Slots of the submission queue are used in order, the indirection array is set up once
+    unsigned* const pSqArray = reinterpret_cast<unsigned*>(pBase + params.sq_off.array);
+    for (unsigned i = 0; i < params.sq_entries; i++) {
+        pSqArray[i] = i;
+    }
+
+    pRing->mpCqHead = reinterpret_cast<unsigned*>(pBase + params.cq_off.head);
+    pRing->mpCqTail = reinterpret_cast<unsigned*>(pBase + params.cq_off.tail);
+    pRing->mCqMask = *reinterpret_cast<unsigned*>(pBase + params.cq_off.ring_mask);
+    pRing->mpCqes = reinterpret_cast<struct io_uring_cqe*>(pBase + params.cq_off.cqes);
+
+    return pRing;
+}
+
+bool IoUring::setupBufferRing(const uint16_t& groupId, const uint16_t& count, const size_t& bufferSize) {
+    if ((0U == count) || (0U != (count & (count - 1U))) || (0UL == bufferSize) || (nullptr != mpBuffers)) {
+        LOGE("Invalid buffer ring: %u x %zu!!!\n", count, bufferSize);
+        return false;
+    }
+
+    mpBuffers.reset(new uint8_t[count * bufferSize]);
+    mBufferSize = bufferSize;
+    mBufferGroupId = groupId;
+    mBufferMask = static_cast<uint16_t>(count - 1U);
+    mBufferTail = 0U;
+
+    if (isBufferRingSupported() && registerBufferRing(count)) {
+        for (uint16_t i = 0; i < count; i++) {
+            recycleBuffer(i);
+        }
+
+        return true;
+    }
+
+    // Legacy provided buffers (5.7): handed over by `IORING_OP_PROVIDE_BUFFERS` requests
+    mLegacyBuffers = true;
+    struct io_uring_sqe* const pSqe = getSqe();
+    if (nullptr == pSqe) {
+        return false;
+    }
+
+    pSqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+    pSqe->fd = count;
+    pSqe->addr = reinterpret_cast<uint64_t>(mpBuffers.get());
+    pSqe->len = static_cast<uint32_t>(mBufferSize);
+    pSqe->buf_group = mBufferGroupId;
+    pSqe->off = 0U;  // First buffer ID
+    pSqe->user_data = INTERNAL_USER_DATA;
+
+    struct io_uring_cqe cqe;
+    if ((0 > enter(1U)) || !popRawCqe(cqe) || (0 > cqe.res)) {
+        LOGW("Provided buffers are not supported!\n");
+        return false;
+    }
+
+    return true;
+}
+
+void IoUring::recycleBuffer(const uint16_t& bufferId) {
+    uint8_t* const pBuffer = mpBuffers.get() + (static_cast<size_t>(bufferId) * mBufferSize);
+
+    if (mLegacyBuffers) {
+        // Submitted by the next call to `enter()`, only failures complete
+        struct io_uring_sqe* const pSqe = getSqe();
+        if (nullptr == pSqe) {
+            LOGE("Could not recycle buffer %u!!!\n", bufferId);
+            return;
+        }
+
+        pSqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+        pSqe->flags = IOSQE_CQE_SKIP_SUCCESS;
+        pSqe->fd = 1;
+        pSqe->addr = reinterpret_cast<uint64_t>(pBuffer);
+        pSqe->len = static_cast<uint32_t>(mBufferSize);
+        pSqe->buf_group = mBufferGroupId;
+        pSqe->off = bufferId;
+        pSqe->user_data = INTERNAL_USER_DATA;
+        return;
+    }
+
+    // The ring tail overlays `bufs[0].resv`, so entries are written field by field
+    struct io_uring_buf* const pEntry = &mpBufferRing->bufs[mBufferTail & mBufferMask];
+    pEntry->addr = reinterpret_cast<uint64_t>(pBuffer);
+    pEntry->len = static_cast<uint32_t>(mBufferSize);
+    pEntry->bid = bufferId;
+
+    mBufferTail++;
+    __atomic_store_n(&mpBufferRing->tail, mBufferTail, __ATOMIC_RELEASE);
+}
+
+bool IoUring::registerBufferRing(const uint16_t& count) {
+    mBufferRingSize = count * sizeof(struct io_uring_buf);
+    void* pMemory = mmap(nullptr, mBufferRingSize, (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+    if (MAP_FAILED == pMemory) {
+        LOGE("Failed to allocate buffer ring: %d!!!\n", errno);
+        return false;
+    }
+    mpBufferRing = static_cast<struct io_uring_buf_ring*>(pMemory);
+
+    struct io_uring_buf_reg registration;
+    memset(&registration, 0, sizeof(registration));
+    registration.ring_addr = reinterpret_cast<uint64_t>(mpBufferRing);
+    registration.ring_entries = count;
+    registration.bgid = mBufferGroupId;
+    if (0 > syscall(__NR_io_uring_register, mRingFd, IORING_REGISTER_PBUF_RING, &registration, 1)) {
+        munmap(mpBufferRing, mBufferRingSize);
+        mpBufferRing = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+bool IoUring::isBufferRingSupported() {
+    static std::atomic<int> sSupport{0};  // 0: unknown, 1: supported, -1: not supported
+
+    int support = sSupport;
+    if (0 == support) {
+        support = probeBufferRing() ? 1 : -1;
+        sSupport = support;
+        if (0 > support) {
+            LOGW("Provided buffer rings are not supported, fall back to legacy provided buffers!\n");
+        }
+    }
+
+    return (0 < support);
+}
+
+bool IoUring::probeBufferRing() {
+    // Some kernels accept the registration (5.19) but never select from the ring: read 1 byte from a pipe
+    std::unique_ptr<IoUring> pRing = create(2U);
+    if (!pRing) {
+        return false;
+    }
+
+    pRing->mpBuffers.reset(new uint8_t[1]);
+    pRing->mBufferSize = 1UL;
+    if (!pRing->registerBufferRing(1U)) {
+        return false;
+    }
+    pRing->recycleBuffer(0U);
+
+    int pipeFds[2];
+    if (0 != pipe(pipeFds)) {
+        return false;
+    }
+
+    bool result = false;
+    const uint8_t data = 0U;
+    struct io_uring_sqe* const pSqe = pRing->getSqe();
+    if ((1 == write(pipeFds[1], &data, 1)) && (nullptr != pSqe)) {
+        pSqe->opcode = IORING_OP_READ;
+        pSqe->flags = IOSQE_BUFFER_SELECT;
+        pSqe->fd = pipeFds[0];
+        pSqe->len = 1U;
+        pSqe->buf_group = pRing->mBufferGroupId;
+
+        struct io_uring_cqe cqe;
+        result = (0 <= pRing->enter(1U, 100)) && pRing->popRawCqe(cqe) && (1 == cqe.res);
+    }
+
+    ::close(pipeFds[0]);
+    ::close(pipeFds[1]);
+
+    return result;
+}
+
+struct io_uring_sqe* IoUring::getSqe() {
+    if (mSqEntries <= (mSqTail - load_acquire(mpSqHead))) {
+        return nullptr;
+    }
+
+    struct io_uring_sqe* const pSqe = &mpSqes[mSqTail & mSqMask];
+    memset(pSqe, 0, sizeof(*pSqe));
+    mSqTail++;
+
+    return pSqe;
+}
+
+int IoUring::enter(const unsigned& waitCount, const int& timeoutMs) {
+    store_release(mpSqTail, mSqTail);
+    const unsigned submitCount = mSqTail - load_acquire(mpSqHead);
+
+    unsigned flags = 0U;
+    struct __kernel_timespec timeout = {0, 0};
+    struct io_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+
+    if (0U < waitCount) {
+        flags |= IORING_ENTER_GETEVENTS;
+        if (0 <= timeoutMs) {
+            timeout.tv_sec = timeoutMs / 1000;
+            timeout.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000LL;
+            arg.sigmask_sz = _NSIG / 8;
+            arg.ts = reinterpret_cast<uint64_t>(&timeout);
+            flags |= IORING_ENTER_EXT_ARG;
+        }
+    }
+
+    const long ret = (0U != (flags & IORING_ENTER_EXT_ARG))
+                         ? syscall(__NR_io_uring_enter, mRingFd, submitCount, waitCount, flags, &arg, sizeof(arg))
+                         : syscall(__NR_io_uring_enter, mRingFd, submitCount, waitCount, flags, nullptr, 0);
+    if (0 > ret) {
+        if ((ETIME == errno) || (EINTR == errno)) {
+            return 0;
+        }
+
+        return -errno;
+    }
+
+    return static_cast<int>(ret);
+}
+
+bool IoUring::hasCqe() {
+    // Completions of internal requests (failures only) are consumed here
+    struct io_uring_cqe* pCqe;
+    while (nullptr != (pCqe = peekRawCqe())) {
+        if (INTERNAL_USER_DATA != pCqe->user_data) {
+            return true;
+        }
+
+        LOGE("Internal io_uring request failed: %d!!!\n", -pCqe->res);
+        store_release(mpCqHead, *mpCqHead + 1U);
+    }
+
+    return false;
+}
+
+bool IoUring::popCqe(struct io_uring_cqe& cqe) {
+    return hasCqe() && popRawCqe(cqe);
+}
+
+struct io_uring_cqe* IoUring::peekRawCqe() {
+    const unsigned head = *mpCqHead;
+    return (head == load_acquire(mpCqTail)) ? nullptr : &mpCqes[head & mCqMask];
+}
+
+bool IoUring::popRawCqe(struct io_uring_cqe& cqe) {
+    struct io_uring_cqe* const pCqe = peekRawCqe();
+    if (nullptr == pCqe) {
+        return false;
+    }
+
+    cqe = *pCqe;
+    store_release(mpCqHead, *mpCqHead + 1U);
+
+    return true;
+}
+
+}  // namespace comm
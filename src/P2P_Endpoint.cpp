@@ -4,74 +4,326 @@ namespace comm {
 
 void P2P_Endpoint::runRx() {
     mRxAliveFlag = true;
-    static std::unique_ptr<uint8_t[]> mpRxBuffer(new uint8_t[MAX_FRAME_SIZE]);
 
+    ssize_t byteCount = 0;
     while (!mExitFlag) {
         if (!checkRxPipe()) {
             LOGE("Rx Pipe was broken!!!\n");
             break;
         }
 
-        ssize_t byteCount = lread(mpRxBuffer, MAX_FRAME_SIZE);
+        if (0 == byteCount) {
+            // Rx buffer was drained, busy-poll (per the wait policy) then wait until new data arrives
+            byteCount = spinRx();
+            if (0 > byteCount) {
+                break;
+            } else if (0 < byteCount) {
+                continue;
+            }
+
+            const int ret = waitRx();
+            if (0 > ret) {
+                LOGE("Could not wait for lower layer!!!\n");
+                break;
+            } else if (0 == ret) {
+                continue;
+            }
+        }
+
+        byteCount = receive();
         if (0 > byteCount) {
-            LOGE("Could not read from lower layer!!!\n");
             break;
-        } else if (0 < byteCount) {
-            mDecoder.feed(mpRxBuffer, byteCount);
-        } else {
-            // Do nothing
         }
     }
 
+    mpRxSlab.reset();
     mRxAliveFlag = false;
 }
 
 void P2P_Endpoint::runTx() {
     mTxAliveFlag = true;
 
-    std::unique_ptr<uint8_t[]> pEncodedData;
-    size_t encodedSize;
-    ssize_t byteCount = 0;
-
     while (!mExitFlag) {
         if (!checkTxPipe()) {
             LOGE("Tx Pipe was broken!!!\n");
             break;
         }
 
-        std::deque<std::unique_ptr<Packet>> pTxPackets;
-        if (!mTxQueue.dequeue(pTxPackets) || (0 >= pTxPackets.size())) {
-            // Tx queue is empty!
+        bool pending;
+        {
+            std::unique_lock<std::mutex> lock = lockTx();
+            pending = hasPendingTx();
+        }
+
+        if (pending) {
+            // Backpressure: no more packets are dequeued until pending bytes have been written
+            const int ret = lwaitTx(TX_POLL_TIMEOUT_MS);
+            if (0 > ret) {
+                LOGE("Could not wait for lower layer!!!\n");
+                break;
+            } else if (0 < ret) {
+                std::unique_lock<std::mutex> lock = lockTx();
+                if (0 > lflushPendingTx()) {
+                    LOGE("Could not write to lower layer!!!\n");
+                    break;
+                }
+            }
+
             continue;
         }
 
-        LOGD("%zu packets in Tx queue.\n", pTxPackets.size());
+        if (0 > waitTransmit()) {
+            break;
+        }
+    }
 
-        for (auto& pPacket : pTxPackets) {
-            encode(
-                pPacket->getPayload(), pPacket->getPayloadSize(), mTransactionId++,
-                pEncodedData, encodedSize);
+    mTxAliveFlag = false;
+}
 
-            if ((!pEncodedData) || (0 == encodedSize)) {
-                LOGE("Could not encode data!!!\n");
-                continue;
-            }
+ssize_t P2P_Endpoint::spinRx() {
+    if (E_WAIT_BLOCK == mConfig.waitPolicy) {
+        return 0;
+    }
 
-            byteCount = lwrite(pEncodedData, encodedSize);
-            if (0 > byteCount) {
-                LOGE("Could not write to lower layer!!!\n");
-                break;
-            } else {
-                LOGD("Wrote %zd bytes.\n", byteCount);  // [TODO] byteCount < encodedSize
+    // Non-blocking reads in user space, no system call is spent on waiting
+    const auto t0 = monotonic_now();
+    do {
+        const ssize_t byteCount = receive();
+        if (0 != byteCount) {
+            return byteCount;
+        }
+
+        if (!checkRxPipe()) {
+            // e.g. the peer has performed an orderly shutdown, reported by the caller
+            return 0;
+        }
+
+        cpu_relax();
+    } while ((!mExitFlag) && ((E_WAIT_SPIN == mConfig.waitPolicy) || (mConfig.spinUs > get_elapsed_realtime_us(t0))));
+
+    return 0;
+}
+
+int P2P_Endpoint::waitRx() {
+    if (E_WAIT_SPIN == mConfig.waitPolicy) {
+        // Only reached once the exit flag is set
+        return 0;
+    }
+
+    return lwaitRx(RX_POLL_TIMEOUT_MS);
+}
+
+ssize_t P2P_Endpoint::waitTransmit() {
+    if (E_WAIT_BLOCK != mConfig.waitPolicy) {
+        // The lock of the Tx queue is only taken once packets are visible
+        const auto t0 = monotonic_now();
+        do {
+            if (!mpTxQueue->isEmpty()) {
+                return transmit(false);
             }
+
+            cpu_relax();
+        } while ((!mExitFlag) && ((E_WAIT_SPIN == mConfig.waitPolicy) || (mConfig.spinUs > get_elapsed_realtime_us(t0))));
+
+        if (E_WAIT_SPIN == mConfig.waitPolicy) {
+            return 0;
         }
+    }
 
-        if (0 > byteCount) {
+    return transmit(true);
+}
+
+ssize_t P2P_Endpoint::receive() {
+    uint8_t* pBuffer = mpRxBuffer.get();
+    size_t limit = mRxBufferSize;
+
+    if (mConfig.zeroCopyRx) {
+        // The slab is filled up by consecutive reads, only frames lying within one slab can be referred to
+        const size_t slabSize = mpRxSlabPool->getSlabSize();
+        if ((!mpRxSlab) || (MAX_FRAME_SIZE > (slabSize - mRxSlabOffset))) {
+            mpRxSlab = mpRxSlabPool->acquire();
+            mRxSlabOffset = 0UL;
+        }
+
+        pBuffer = mpRxSlab.get() + mRxSlabOffset;
+        limit = slabSize - mRxSlabOffset;
+    }
+
+    const ssize_t byteCount = lread(pBuffer, limit);
+    if (0 > byteCount) {
+        LOGE("Could not read from lower layer!!!\n");
+    } else if (0 < byteCount) {
+        if (mConfig.zeroCopyRx) {
+            mDecoder.feed(pBuffer, byteCount, mpRxSlab);
+            mRxSlabOffset += byteCount;
+        } else {
+            mDecoder.feed(pBuffer, byteCount);
+        }
+    } else {
+        // Do nothing
+    }
+
+    return byteCount;
+}
+
+ssize_t P2P_Endpoint::transmit(const bool wait) {
+    std::deque<std::unique_ptr<Packet>> pTxPackets;
+    if (!mpTxQueue->dequeue(pTxPackets, wait) || (0 >= pTxPackets.size())) {
+        // Tx queue is empty!
+        return 0;
+    }
+
+    LOGD("%zu packets in Tx queue.\n", pTxPackets.size());
+
+    // Frames of dequeued packets are coalesced & written at once, within configured limits
+    std::unique_lock<std::mutex> lock = lockTx();
+    TxRound round;
+    ssize_t byteCount = 0;
+    for (auto& pPacket : pTxPackets) {
+        if (0 > encodeTxPacket(pPacket.get(), round)) {
+            byteCount = -1;
             break;
         }
     }
 
-    mTxAliveFlag = false;
+    if (0 <= byteCount) {
+        byteCount = completeTxRound(round);
+    }
+
+    if (mConfig.directSend) {
+        mTxBacklog -= pTxPackets.size();
+    }
+
+    return byteCount;
+}
+
+int P2P_Endpoint::encodeTxPacket(Packet* const pPacket, TxRound& round) {
+    const size_t payloadSize = pPacket->getPayloadSize();
+    if ((nullptr == pPacket->getPayload()) || !validate_payload_size(payloadSize)) {
+        LOGE("Could not encode data!!!\n");
+        return 0;
+    }
+
+    const size_t frameSize = FRAME_HEADER_SIZE + payloadSize + EF_SIZE;
+    if ((0 < round.numberOfPackets) &&
+        ((mConfig.txBatchPacketLimit <= round.numberOfPackets) || (mConfig.txBatchByteLimit < (round.numberOfBytes + frameSize)))) {
+        const ssize_t byteCount = flushTxBatch(mpTxSegments.get(), round.numberOfPackets, round.numberOfBytes);
+        round.numberOfPackets = 0UL;
+        round.numberOfBytes = 0UL;
+
+        if (0 > byteCount) {
+            return -1;
+        }
+        round.byteCount += byteCount;
+    }
+
+    // Only headers & trailers are encoded, payloads are written straight from the packets
+    uint8_t* const pHeader = mpTxHeaders.get() + (round.numberOfPackets * FRAME_HEADER_SIZE);
+    encodeHeader(payloadSize, mTransactionId++, pHeader);
+
+    IoSegment* const pFrameSegments = mpTxSegments.get() + (round.numberOfPackets * SEGMENTS_PER_FRAME);
+    pFrameSegments[0] = {pHeader, FRAME_HEADER_SIZE};
+    pFrameSegments[1] = {pPacket->getPayload(), payloadSize};
+    pFrameSegments[2] = {&EF, EF_SIZE};
+
+    round.numberOfPackets++;
+    round.numberOfBytes += frameSize;
+
+    return 0;
+}
+
+ssize_t P2P_Endpoint::completeTxRound(TxRound& round) {
+    if (0 < round.numberOfPackets) {
+        const ssize_t byteCount = flushTxBatch(mpTxSegments.get(), round.numberOfPackets, round.numberOfBytes);
+        round.numberOfPackets = 0UL;
+        round.numberOfBytes = 0UL;
+
+        if (0 > byteCount) {
+            return -1;
+        }
+        round.byteCount += byteCount;
+    }
+
+    // Writes may be deferred by the lower layer, they must complete while Tx packets are still alive
+    if (0 > lflush()) {
+        LOGE("Could not flush lower layer!!!\n");
+        return -1;
+    }
+
+    return round.byteCount;
+}
+
+int P2P_Endpoint::sendDirect(std::unique_ptr<Packet>& pPacket) {
+    // Packets queued before go first: they are written by the Tx side
+    if ((0UL != mTxBacklog) || !mTxAliveFlag) {
+        return 0;
+    }
+
+    std::unique_lock<std::mutex> lock(mTxMutex, std::try_to_lock);
+    if ((!lock.owns_lock()) || (0UL != mTxBacklog) || hasPendingTx() || !checkTxPipe()) {
+        return 0;
+    }
+
+    TxRound round;
+    if ((0 > encodeTxPacket(pPacket.get(), round)) || (0 > completeTxRound(round))) {
+        return -1;
+    }
+
+    // Unwritten bytes (if any) have been taken over by the lower layer, to be written by the Tx side
+    const bool pending = hasPendingTx();
+    lock.unlock();
+    pPacket.reset();
+
+    if (pending && mConfig.pReactor) {
+        mConfig.pReactor->notifyTx(this);
+    }
+
+    return 1;
+}
+
+ssize_t P2P_Endpoint::flushTxBatch(const IoSegment* const pSegments, const size_t& numberOfPackets, const size_t& numberOfBytes) {
+    ssize_t byteCount = lwritev(pSegments, numberOfPackets * SEGMENTS_PER_FRAME);
+    if (0 > byteCount) {
+        LOGE("Could not write to lower layer!!!\n");
+    } else {
+        LOGD("Wrote %zd/%zu bytes (%zu packets).\n", byteCount, numberOfBytes, numberOfPackets);
+        mTxBatchCount++;
+        mTxPacketCount += numberOfPackets;
+        mTxByteCount += byteCount;
+    }
+
+    return byteCount;
+}
+
+size_t broadcast(const std::vector<P2P_Endpoint*>& pEndpoints, std::unique_ptr<Packet>&& pPacket) {
+    if (!pPacket) {
+        return 0UL;
+    }
+
+    // Packets are allocated on their own: inline payloads of small packets do not move either
+    return broadcast(pEndpoints, std::shared_ptr<Packet>(std::move(pPacket)));
+}
+
+size_t broadcast(const std::vector<P2P_Endpoint*>& pEndpoints, const std::shared_ptr<Packet>& pPacket) {
+    size_t count = 0UL;
+    if (!pPacket) {
+        return count;
+    }
+
+    const uint8_t* const pPayload = pPacket->getPayload();
+    const size_t payloadSize = pPacket->getPayloadSize();
+    const int64_t timestampUs = pPacket->getTimestampUs();
+    const bool copy = (Packet::SMALL_PAYLOAD_SIZE >= payloadSize);
+
+    for (auto& pEndpoint : pEndpoints) {
+        std::unique_ptr<Packet> pCopy = copy ? Packet::create(pPayload, payloadSize, timestampUs)
+                                             : Packet::createView(pPayload, payloadSize, pPacket, timestampUs);
+        if (pEndpoint->send(pCopy)) {
+            count++;
+        }
+    }
+
+    return count;
 }
 
 }  // namespace comm
@@ -0,0 +1,239 @@
+#include "PacketPool.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace comm {
+
+static_assert(0 == (PacketPool::MAX_BLOCK_SIZE % PacketPool::MIN_BLOCK_SIZE), "Invalid size classes!");
+
+static constexpr size_t NUMBER_OF_SIZE_CLASSES = 5UL;  // 64, 128, 256, 512, 1024
+static_assert((PacketPool::MIN_BLOCK_SIZE << (NUMBER_OF_SIZE_CLASSES - 1)) == PacketPool::MAX_BLOCK_SIZE, "Invalid size classes!");
+
+static constexpr size_t THREAD_CACHE_CAP_LIMIT = 256UL;  // Blocks per size class
+static constexpr size_t TRANSFER_BATCH_SIZE = 64UL;      // Blocks moved between a thread cache & the shared pool at once
+static constexpr size_t SHARED_POOL_CAP_LIMIT = 4096UL;  // Blocks per size class
+
+/**
+ * @brief Returns the size class of a block, or NUMBER_OF_SIZE_CLASSES if it is too large.
+ */
+static inline size_t get_size_class(const size_t& size) {
+    size_t sizeClass = 0UL;
+    size_t blockSize = PacketPool::MIN_BLOCK_SIZE;
+    while ((blockSize < size) && (NUMBER_OF_SIZE_CLASSES > sizeClass)) {
+        blockSize <<= 1;
+        sizeClass++;
+    }
+
+    return sizeClass;
+}
+
+static inline size_t get_block_size(const size_t& sizeClass) {
+    return PacketPool::MIN_BLOCK_SIZE << sizeClass;
+}
+
+struct ThreadCache;
+
+struct SharedPool {
+    std::mutex mMutex;
+    std::vector<void*> mFreeBlocks[NUMBER_OF_SIZE_CLASSES];
+
+    /**
+     * @brief Counters are kept per thread, those of exited threads are accumulated here.
+     */
+    std::vector<ThreadCache*> mThreadCaches;
+    uint64_t mRetiredHits = 0ULL;
+    uint64_t mRetiredMisses = 0ULL;
+};  // struct SharedPool
+
+/**
+ * @brief Returns the shared pool, created on first use: packets may be allocated by static initializers of other
+ * translation units. It is never destroyed: blocks may be released by threads outliving static objects.
+ */
+static inline SharedPool& get_shared_pool() {
+    static SharedPool* const pSharedPool = new SharedPool();
+    return *pSharedPool;
+}
+
+struct ThreadCache {
+    struct FreeList {
+        void* mBlocks[THREAD_CACHE_CAP_LIMIT];
+        size_t mCount;
+    };  // struct FreeList
+
+    FreeList mFreeLists[NUMBER_OF_SIZE_CLASSES];
+
+    /**
+     * @brief Only written by the owner thread (no read-modify-write), read by `PacketPool::getStats()`.
+     */
+    std::atomic<uint64_t> mHits;
+    std::atomic<uint64_t> mMisses;
+
+    ThreadCache();
+    ~ThreadCache();
+};  // struct ThreadCache
+
+static thread_local bool threadCacheDestroyed = false;
+static thread_local ThreadCache threadCache;
+
+/**
+ * @brief Returns the cache of the calling thread, or nullptr if it has already been destroyed (thread exit).
+ */
+static inline ThreadCache* get_thread_cache() {
+    return threadCacheDestroyed ? nullptr : &threadCache;
+}
+
+static inline void increase(std::atomic<uint64_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1ULL, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns a block to the shared pool, or frees it if the shared pool is full (shared pool's lock must be held).
+ */
+static inline void release_to_shared_pool(void* const pBlock, const size_t& sizeClass) {
+    std::vector<void*>& sharedBlocks = get_shared_pool().mFreeBlocks[sizeClass];
+    if (SHARED_POOL_CAP_LIMIT > sharedBlocks.size()) {
+        sharedBlocks.push_back(pBlock);
+    } else {
+        free(pBlock);
+    }
+}
+
+ThreadCache::ThreadCache() : mHits(0ULL), mMisses(0ULL) {
+    for (auto& freeList : mFreeLists) {
+        freeList.mCount = 0UL;
+    }
+
+    SharedPool& sharedPool = get_shared_pool();
+    std::lock_guard<std::mutex> lock(sharedPool.mMutex);
+    sharedPool.mThreadCaches.push_back(this);
+}
+
+ThreadCache::~ThreadCache() {
+    threadCacheDestroyed = true;
+
+    SharedPool& sharedPool = get_shared_pool();
+    std::lock_guard<std::mutex> lock(sharedPool.mMutex);
+    for (size_t i = 0; i < NUMBER_OF_SIZE_CLASSES; i++) {
+        while (0 < mFreeLists[i].mCount) {
+            release_to_shared_pool(mFreeLists[i].mBlocks[--mFreeLists[i].mCount], i);
+        }
+    }
+
+    sharedPool.mRetiredHits += mHits;
+    sharedPool.mRetiredMisses += mMisses;
+    for (auto it = sharedPool.mThreadCaches.begin(); it != sharedPool.mThreadCaches.end(); ++it) {
+        if (this == *it) {
+            sharedPool.mThreadCaches.erase(it);
+            break;
+        }
+    }
+}
+
+void* PacketPool::allocate(const size_t& size) {
+    const size_t sizeClass = get_size_class(size);
+    if (NUMBER_OF_SIZE_CLASSES <= sizeClass) {
+        void* pBlock = malloc(size);
+        if (nullptr == pBlock) {
+            throw std::bad_alloc();
+        }
+
+        return pBlock;
+    }
+
+    ThreadCache* const pThreadCache = get_thread_cache();
+    void* pBlock = nullptr;
+
+    if (nullptr == pThreadCache) {
+        SharedPool& sharedPool = get_shared_pool();
+        std::lock_guard<std::mutex> lock(sharedPool.mMutex);
+        std::vector<void*>& sharedBlocks = sharedPool.mFreeBlocks[sizeClass];
+        if (sharedBlocks.empty()) {
+            sharedPool.mRetiredMisses++;
+        } else {
+            sharedPool.mRetiredHits++;
+            pBlock = sharedBlocks.back();
+            sharedBlocks.pop_back();
+        }
+    } else {
+        ThreadCache::FreeList& freeList = pThreadCache->mFreeLists[sizeClass];
+        if (0 == freeList.mCount) {
+            // Refill the thread cache in bulk
+            SharedPool& sharedPool = get_shared_pool();
+            std::lock_guard<std::mutex> lock(sharedPool.mMutex);
+            std::vector<void*>& sharedBlocks = sharedPool.mFreeBlocks[sizeClass];
+            while ((TRANSFER_BATCH_SIZE > freeList.mCount) && !sharedBlocks.empty()) {
+                freeList.mBlocks[freeList.mCount++] = sharedBlocks.back();
+                sharedBlocks.pop_back();
+            }
+        }
+
+        if (0 < freeList.mCount) {
+            increase(pThreadCache->mHits);
+            pBlock = freeList.mBlocks[--freeList.mCount];
+        } else {
+            increase(pThreadCache->mMisses);
+        }
+    }
+
+    if (nullptr == pBlock) {
+        pBlock = malloc(get_block_size(sizeClass));
+        if (nullptr == pBlock) {
+            throw std::bad_alloc();
+        }
+    }
+
+    return pBlock;
+}
+
+void PacketPool::deallocate(void* const pBlock, const size_t& size) {
+    if (nullptr == pBlock) {
+        return;
+    }
+
+    const size_t sizeClass = get_size_class(size);
+    if (NUMBER_OF_SIZE_CLASSES <= sizeClass) {
+        free(pBlock);
+        return;
+    }
+
+    ThreadCache* const pThreadCache = get_thread_cache();
+    if (nullptr == pThreadCache) {
+        SharedPool& sharedPool = get_shared_pool();
+        std::lock_guard<std::mutex> lock(sharedPool.mMutex);
+        release_to_shared_pool(pBlock, sizeClass);
+        return;
+    }
+
+    ThreadCache::FreeList& freeList = pThreadCache->mFreeLists[sizeClass];
+    if (THREAD_CACHE_CAP_LIMIT <= freeList.mCount) {
+        // Drain the thread cache in bulk, e.g. packets decoded by Rx threads are destroyed by application threads
+        SharedPool& sharedPool = get_shared_pool();
+        std::lock_guard<std::mutex> lock(sharedPool.mMutex);
+        for (size_t i = 0; i < TRANSFER_BATCH_SIZE; i++) {
+            release_to_shared_pool(freeList.mBlocks[--freeList.mCount], sizeClass);
+        }
+    }
+
+    freeList.mBlocks[freeList.mCount++] = pBlock;
+}
+
+PoolStats PacketPool::getStats() {
+    PoolStats stats;
+
+    SharedPool& sharedPool = get_shared_pool();
+    std::lock_guard<std::mutex> lock(sharedPool.mMutex);
+    stats.hits = sharedPool.mRetiredHits;
+    stats.misses = sharedPool.mRetiredMisses;
+    for (auto& pThreadCache : sharedPool.mThreadCaches) {
+        stats.hits += pThreadCache->mHits.load(std::memory_order_relaxed);
+        stats.misses += pThreadCache->mMisses.load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
+
+}  // namespace comm
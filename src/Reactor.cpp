@@ -0,0 +1,343 @@
+#include "Reactor.hpp"
+
+#include "P2P_Endpoint.hpp"
+#include "common.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace comm {
+
+struct Reactor::IoThread {
+    int epollFd = -1;
+    int eventFd = -1;  // Wakes up the thread: Tx requests, detach requests & termination
+    std::unique_ptr<Thread> pThread;
+    std::thread::id threadId;  // Set by the thread itself (under `mutex`)
+    std::atomic<size_t> numberOfEndpoints{0UL};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<P2P_Endpoint*> pendingTxEndpoints;
+    uint64_t loopCount = 0ULL;  // Number of completed iterations, see `detach()`
+};  // struct Reactor::IoThread
+
+Reactor::Reactor() {}
+
+Reactor::~Reactor() {
+    mExitFlag = true;
+
+    for (auto& pIoThread : mIoThreads) {
+        if (pIoThread->pThread) {
+            wakeUp(pIoThread.get());
+            pIoThread->pThread->join();
+        }
+
+        if (0 <= pIoThread->eventFd) {
+            ::close(pIoThread->eventFd);
+        }
+
+        if (0 <= pIoThread->epollFd) {
+            ::close(pIoThread->epollFd);
+        }
+    }
+
+    LOGI("Finalized.\n");
+}
+
+std::shared_ptr<Reactor> Reactor::create(const size_t& numberOfThreads, const ThreadConfig& threadConfig) {
+    std::shared_ptr<Reactor> pReactor(new Reactor());
+
+    size_t count = numberOfThreads;
+    if (0UL == count) {
+        count = std::thread::hardware_concurrency();
+        if (0UL == count) {
+            count = 1UL;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        std::unique_ptr<IoThread> pIoThread(new IoThread());
+
+        pIoThread->epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (0 > pIoThread->epollFd) {
+            LOGE("Could not create epoll instance: %d!!!\n", errno);
+            return nullptr;
+        }
+
+        pIoThread->eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (0 > pIoThread->eventFd) {
+            LOGE("Could not create eventfd: %d!!!\n", errno);
+            ::close(pIoThread->epollFd);
+            return nullptr;
+        }
+
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;  // nullptr stands for the eventfd
+        if (0 > epoll_ctl(pIoThread->epollFd, EPOLL_CTL_ADD, pIoThread->eventFd, &event)) {
+            LOGE("Could not register eventfd: %d!!!\n", errno);
+            ::close(pIoThread->eventFd);
+            ::close(pIoThread->epollFd);
+            return nullptr;
+        }
+
+        pReactor->mIoThreads.push_back(std::move(pIoThread));
+    }
+
+    for (auto& pIoThread : pReactor->mIoThreads) {
+        Reactor* const pSelf = pReactor.get();
+        IoThread* const pSelfIoThread = pIoThread.get();
+        pIoThread->pThread = Thread::start(threadConfig, [pSelf, pSelfIoThread]() { pSelf->run(pSelfIoThread); });
+        if (!pIoThread->pThread) {
+            // Started threads are stopped by the destructor
+            LOGE("Could not start I/O thread!!!\n");
+            return nullptr;
+        }
+    }
+
+    LOGI("Started %zu I/O threads.\n", count);
+
+    return pReactor;
+}
+
+size_t Reactor::getNumberOfEndpoints() const {
+    size_t count = 0UL;
+    for (auto& pIoThread : mIoThreads) {
+        count += pIoThread->numberOfEndpoints;
+    }
+
+    return count;
+}
+
+bool Reactor::attach(P2P_Endpoint* const pEndpoint) {
+    const SOCKET handle = pEndpoint->getHandle();
+    if (INVALID_HANDLE == handle) {
+        LOGE("Endpoint does not have any handle!!!\n");
+        return false;
+    }
+
+    // Least loaded I/O thread
+    size_t index = 0UL;
+    for (size_t i = 1; i < mIoThreads.size(); i++) {
+        if (mIoThreads[i]->numberOfEndpoints < mIoThreads[index]->numberOfEndpoints) {
+            index = i;
+        }
+    }
+
+    IoThread* const pIoThread = mIoThreads[index].get();
+    pEndpoint->mIoThreadIndex = index;
+    pEndpoint->mTxWatched = false;
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = pEndpoint;
+    if (0 > epoll_ctl(pIoThread->epollFd, EPOLL_CTL_ADD, handle, &event)) {
+        LOGE("Could not register socket %d: %d!!!\n", handle, errno);
+        return false;
+    }
+
+    pIoThread->numberOfEndpoints++;
+
+    // Packets may have been queued before the registration
+    notifyTx(pEndpoint);
+
+    return true;
+}
+
+void Reactor::detach(P2P_Endpoint* const pEndpoint) {
+    IoThread* const pIoThread = mIoThreads[pEndpoint->mIoThreadIndex].get();
+
+    // Fails (ENOENT) if the endpoint has already been retired by the I/O thread
+    if (0 == epoll_ctl(pIoThread->epollFd, EPOLL_CTL_DEL, pEndpoint->getHandle(), nullptr)) {
+        pIoThread->numberOfEndpoints--;
+    }
+
+    std::unique_lock<std::mutex> lock(pIoThread->mutex);
+    for (auto it = pIoThread->pendingTxEndpoints.begin(); it != pIoThread->pendingTxEndpoints.end(); ++it) {
+        if (pEndpoint == *it) {
+            pIoThread->pendingTxEndpoints.erase(it);
+            break;
+        }
+    }
+
+    if (std::this_thread::get_id() == pIoThread->threadId) {
+        return;
+    }
+
+    // Events of the endpoint may have been picked up by the ongoing iteration, wait until it completes
+    const uint64_t loopCount = pIoThread->loopCount;
+    wakeUp(pIoThread);
+    pIoThread->cv.wait(lock, [pIoThread, loopCount]() { return loopCount < pIoThread->loopCount; });
+}
+
+void Reactor::notifyTx(P2P_Endpoint* const pEndpoint) {
+    if (pEndpoint->mTxNotified.exchange(true)) {
+        // Already requested
+        return;
+    }
+
+    IoThread* const pIoThread = mIoThreads[pEndpoint->mIoThreadIndex].get();
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(pIoThread->mutex);
+        wasEmpty = pIoThread->pendingTxEndpoints.empty();
+        pIoThread->pendingTxEndpoints.push_back(pEndpoint);
+    }
+
+    if (wasEmpty) {
+        wakeUp(pIoThread);
+    }
+}
+
+void Reactor::wakeUp(IoThread* const pIoThread) {
+    const uint64_t value = 1ULL;
+    if (sizeof(value) != ::write(pIoThread->eventFd, &value, sizeof(value))) {
+        // EAGAIN: the counter is saturated, the thread will wake up anyway
+        LOGD("Could not write to eventfd: %d.\n", errno);
+    }
+}
+
+void Reactor::run(IoThread* const pIoThread) {
+    {
+        std::lock_guard<std::mutex> lock(pIoThread->mutex);
+        pIoThread->threadId = std::this_thread::get_id();
+    }
+
+    struct epoll_event events[MAX_EVENTS];
+    std::vector<P2P_Endpoint*> pTxEndpoints;
+
+    while (!mExitFlag) {
+        const int count = epoll_wait(pIoThread->epollFd, events, MAX_EVENTS, WAIT_TIMEOUT_MS);
+        if ((0 > count) && (EINTR != errno)) {
+            LOGE("Failed to wait for events: %d!!!\n", errno);
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            P2P_Endpoint* const pEndpoint = static_cast<P2P_Endpoint*>(events[i].data.ptr);
+            if (nullptr == pEndpoint) {
+                uint64_t value;
+                if (sizeof(value) != ::read(pIoThread->eventFd, &value, sizeof(value))) {
+                    LOGD("Could not read from eventfd: %d.\n", errno);
+                }
+            } else {
+                // Readable, error or hang-up: served by reads. Writable: pending Tx bytes can be flushed.
+                bool alive = true;
+                if (0U != (events[i].events & ~static_cast<uint32_t>(EPOLLOUT))) {
+                    alive = serveRx(pEndpoint);
+                }
+
+                if (alive && (0U != (events[i].events & EPOLLOUT))) {
+                    alive = serveTx(pEndpoint) && watchTx(pIoThread, pEndpoint);
+                }
+
+                if (!alive) {
+                    retire(pIoThread, pEndpoint);
+                }
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(pIoThread->mutex);
+            pTxEndpoints.swap(pIoThread->pendingTxEndpoints);
+        }
+
+        for (auto& pEndpoint : pTxEndpoints) {
+            pEndpoint->mTxNotified = false;
+            if (pEndpoint->mTxAliveFlag && !(serveTx(pEndpoint) && watchTx(pIoThread, pEndpoint))) {
+                retire(pIoThread, pEndpoint);
+            }
+        }
+        pTxEndpoints.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(pIoThread->mutex);
+            pIoThread->loopCount++;
+        }
+        pIoThread->cv.notify_all();
+    }
+
+    // Release waiting `detach()` calls
+    std::lock_guard<std::mutex> lock(pIoThread->mutex);
+    pIoThread->loopCount = UINT64_MAX;
+    pIoThread->cv.notify_all();
+}
+
+bool Reactor::serveRx(P2P_Endpoint* const pEndpoint) {
+    if (!pEndpoint->mRxAliveFlag) {
+        return false;
+    }
+
+    for (size_t i = 0; i < RX_READS_PER_EVENT; i++) {
+        if (!pEndpoint->checkRxPipe()) {
+            LOGE("Rx Pipe was broken!!!\n");
+            return false;
+        }
+
+        const ssize_t byteCount = pEndpoint->receive();
+        if (0 > byteCount) {
+            return false;
+        } else if (0 == byteCount) {
+            break;
+        }
+    }
+
+    return pEndpoint->checkRxPipe();
+}
+
+bool Reactor::serveTx(P2P_Endpoint* const pEndpoint) {
+    if (!pEndpoint->checkTxPipe()) {
+        LOGE("Tx Pipe was broken!!!\n");
+        return false;
+    }
+
+    {
+        // Queued packets wait until pending bytes have been written
+        std::unique_lock<std::mutex> lock = pEndpoint->lockTx();
+        if (pEndpoint->hasPendingTx() && (0 > pEndpoint->lflushPendingTx())) {
+            return false;
+        }
+
+        if (pEndpoint->hasPendingTx()) {
+            return true;
+        }
+    }
+
+    return (0 <= pEndpoint->transmit(false));
+}
+
+bool Reactor::watchTx(IoThread* const pIoThread, P2P_Endpoint* const pEndpoint) {
+    bool watched;
+    {
+        std::unique_lock<std::mutex> lock = pEndpoint->lockTx();
+        watched = pEndpoint->hasPendingTx();
+    }
+
+    if (watched == pEndpoint->mTxWatched) {
+        return true;
+    }
+
+    struct epoll_event event;
+    event.events = watched ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    event.data.ptr = pEndpoint;
+    if (0 > epoll_ctl(pIoThread->epollFd, EPOLL_CTL_MOD, pEndpoint->getHandle(), &event)) {
+        LOGE("Could not update socket %d: %d!!!\n", pEndpoint->getHandle(), errno);
+        return false;
+    }
+    pEndpoint->mTxWatched = watched;
+
+    return true;
+}
+
+void Reactor::retire(IoThread* const pIoThread, P2P_Endpoint* const pEndpoint) {
+    if (0 == epoll_ctl(pIoThread->epollFd, EPOLL_CTL_DEL, pEndpoint->getHandle(), nullptr)) {
+        pIoThread->numberOfEndpoints--;
+    }
+
+    pEndpoint->mpRxSlab.reset();
+    pEndpoint->mRxAliveFlag = false;
+    pEndpoint->mTxAliveFlag = false;
+}
+
+}  // namespace comm
@@ -0,0 +1,343 @@
+#include "Reactor.hpp"
+
+#include "P2P_Endpoint.hpp"
+#include "common.hpp"
+
+#include <cstring>
+
+namespace comm {
+
+// Windows does not provide epoll: each I/O thread polls its endpoints with `WSAPoll()`,
+// a UDP socket connected to itself is used to wake it up.
+struct Reactor::IoThread {
+    SOCKET wakeUpSocket = INVALID_SOCKET;
+    std::unique_ptr<Thread> pThread;
+    std::thread::id threadId;  // Set by the thread itself (under `mutex`)
+    std::atomic<size_t> numberOfEndpoints{0UL};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<P2P_Endpoint*> pEndpoints;
+    std::vector<P2P_Endpoint*> pendingTxEndpoints;
+    uint64_t loopCount = 0ULL;  // Number of completed iterations, see `detach()`
+};  // struct Reactor::IoThread
+
+Reactor::Reactor() {}
+
+Reactor::~Reactor() {
+    mExitFlag = true;
+
+    for (auto& pIoThread : mIoThreads) {
+        if (pIoThread->pThread) {
+            wakeUp(pIoThread.get());
+            pIoThread->pThread->join();
+        }
+
+        if (INVALID_SOCKET != pIoThread->wakeUpSocket) {
+            closesocket(pIoThread->wakeUpSocket);
+        }
+    }
+
+    LOGI("Finalized.\n");
+}
+
+std::shared_ptr<Reactor> Reactor::create(const size_t& numberOfThreads, const ThreadConfig& threadConfig) {
+    std::shared_ptr<Reactor> pReactor(new Reactor());
+
+    size_t count = numberOfThreads;
+    if (0UL == count) {
+        count = std::thread::hardware_concurrency();
+        if (0UL == count) {
+            count = 1UL;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        std::unique_ptr<IoThread> pIoThread(new IoThread());
+
+        pIoThread->wakeUpSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (INVALID_SOCKET == pIoThread->wakeUpSocket) {
+            LOGE("Could not create wake-up socket: %d!!!\n", WSAGetLastError());
+            return nullptr;
+        }
+
+        struct sockaddr_in address;
+        int addressLength = sizeof(address);
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        unsigned long nonBlocking = 1;
+        if ((SOCKET_ERROR == bind(pIoThread->wakeUpSocket, (const struct sockaddr*)(&address), sizeof(address))) ||
+            (SOCKET_ERROR == getsockname(pIoThread->wakeUpSocket, (struct sockaddr*)(&address), &addressLength)) ||
+            (SOCKET_ERROR == connect(pIoThread->wakeUpSocket, (const struct sockaddr*)(&address), sizeof(address))) ||
+            (SOCKET_ERROR == ioctlsocket(pIoThread->wakeUpSocket, FIONBIO, &nonBlocking))) {
+            LOGE("Could not configure wake-up socket: %d!!!\n", WSAGetLastError());
+            closesocket(pIoThread->wakeUpSocket);
+            return nullptr;
+        }
+
+        pReactor->mIoThreads.push_back(std::move(pIoThread));
+    }
+
+    for (auto& pIoThread : pReactor->mIoThreads) {
+        Reactor* const pSelf = pReactor.get();
+        IoThread* const pSelfIoThread = pIoThread.get();
+        pIoThread->pThread = Thread::start(threadConfig, [pSelf, pSelfIoThread]() { pSelf->run(pSelfIoThread); });
+        if (!pIoThread->pThread) {
+            // Started threads are stopped by the destructor
+            LOGE("Could not start I/O thread!!!\n");
+            return nullptr;
+        }
+    }
+
+    LOGI("Started %zu I/O threads.\n", count);
+
+    return pReactor;
+}
+
+size_t Reactor::getNumberOfEndpoints() const {
+    size_t count = 0UL;
+    for (auto& pIoThread : mIoThreads) {
+        count += pIoThread->numberOfEndpoints;
+    }
+
+    return count;
+}
+
+bool Reactor::attach(P2P_Endpoint* const pEndpoint) {
+    if (INVALID_HANDLE == pEndpoint->getHandle()) {
+        LOGE("Endpoint does not have any handle!!!\n");
+        return false;
+    }
+
+    // Least loaded I/O thread
+    size_t index = 0UL;
+    for (size_t i = 1; i < mIoThreads.size(); i++) {
+        if (mIoThreads[i]->numberOfEndpoints < mIoThreads[index]->numberOfEndpoints) {
+            index = i;
+        }
+    }
+
+    IoThread* const pIoThread = mIoThreads[index].get();
+    pEndpoint->mIoThreadIndex = index;
+    {
+        std::lock_guard<std::mutex> lock(pIoThread->mutex);
+        pIoThread->pEndpoints.push_back(pEndpoint);
+        pIoThread->numberOfEndpoints++;
+    }
+
+    // Rebuild the poll list, packets may have been queued before the registration
+    notifyTx(pEndpoint);
+    wakeUp(pIoThread);
+
+    return true;
+}
+
+void Reactor::detach(P2P_Endpoint* const pEndpoint) {
+    IoThread* const pIoThread = mIoThreads[pEndpoint->mIoThreadIndex].get();
+
+    std::unique_lock<std::mutex> lock(pIoThread->mutex);
+    for (auto it = pIoThread->pEndpoints.begin(); it != pIoThread->pEndpoints.end(); ++it) {
+        if (pEndpoint == *it) {
+            pIoThread->pEndpoints.erase(it);
+            pIoThread->numberOfEndpoints--;
+            break;
+        }
+    }
+
+    for (auto it = pIoThread->pendingTxEndpoints.begin(); it != pIoThread->pendingTxEndpoints.end(); ++it) {
+        if (pEndpoint == *it) {
+            pIoThread->pendingTxEndpoints.erase(it);
+            break;
+        }
+    }
+
+    if (std::this_thread::get_id() == pIoThread->threadId) {
+        return;
+    }
+
+    // The endpoint may be polled by the ongoing iteration, wait until it completes
+    const uint64_t loopCount = pIoThread->loopCount;
+    wakeUp(pIoThread);
+    pIoThread->cv.wait(lock, [pIoThread, loopCount]() { return loopCount < pIoThread->loopCount; });
+}
+
+void Reactor::notifyTx(P2P_Endpoint* const pEndpoint) {
+    if (pEndpoint->mTxNotified.exchange(true)) {
+        // Already requested
+        return;
+    }
+
+    IoThread* const pIoThread = mIoThreads[pEndpoint->mIoThreadIndex].get();
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(pIoThread->mutex);
+        wasEmpty = pIoThread->pendingTxEndpoints.empty();
+        pIoThread->pendingTxEndpoints.push_back(pEndpoint);
+    }
+
+    if (wasEmpty) {
+        wakeUp(pIoThread);
+    }
+}
+
+void Reactor::wakeUp(IoThread* const pIoThread) {
+    const char value = 1;
+    if (SOCKET_ERROR == send(pIoThread->wakeUpSocket, &value, sizeof(value), 0)) {
+        // WSAEWOULDBLOCK: pending wake-ups, the thread will wake up anyway
+        LOGD("Could not write to wake-up socket: %d.\n", WSAGetLastError());
+    }
+}
+
+void Reactor::run(IoThread* const pIoThread) {
+    {
+        std::lock_guard<std::mutex> lock(pIoThread->mutex);
+        pIoThread->threadId = std::this_thread::get_id();
+    }
+
+    std::vector<WSAPOLLFD> pollFds;
+    std::vector<P2P_Endpoint*> pEndpoints;
+    std::vector<P2P_Endpoint*> pTxEndpoints;
+
+    while (!mExitFlag) {
+        {
+            std::lock_guard<std::mutex> lock(pIoThread->mutex);
+            pEndpoints = pIoThread->pEndpoints;
+        }
+
+        pollFds.resize(pEndpoints.size() + 1);
+        pollFds[0] = {pIoThread->wakeUpSocket, POLLRDNORM, 0};
+        for (size_t i = 0; i < pEndpoints.size(); i++) {
+            // Endpoints with pending Tx bytes also wait for their socket to become writable
+            bool pending;
+            {
+                std::unique_lock<std::mutex> lock = pEndpoints[i]->lockTx();
+                pending = pEndpoints[i]->hasPendingTx();
+            }
+            const SHORT events = pending ? (POLLRDNORM | POLLWRNORM) : POLLRDNORM;
+            pollFds[i + 1] = {pEndpoints[i]->getHandle(), events, 0};
+        }
+
+        const int count = WSAPoll(pollFds.data(), (ULONG)(pollFds.size()), WAIT_TIMEOUT_MS);
+        if (SOCKET_ERROR == count) {
+            LOGE("Failed to wait for events: %d!!!\n", WSAGetLastError());
+            break;
+        }
+
+        if (0 != pollFds[0].revents) {
+            char buffer[64];
+            while (0 < recv(pIoThread->wakeUpSocket, buffer, sizeof(buffer), 0)) {
+            }
+        }
+
+        for (size_t i = 0; (0 < count) && (i < pEndpoints.size()); i++) {
+            const SHORT revents = pollFds[i + 1].revents;
+            bool alive = true;
+            if (0 != (revents & ~POLLWRNORM)) {
+                alive = serveRx(pEndpoints[i]);
+            }
+
+            if (alive && (0 != (revents & POLLWRNORM))) {
+                alive = serveTx(pEndpoints[i]);
+            }
+
+            if (!alive) {
+                retire(pIoThread, pEndpoints[i]);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(pIoThread->mutex);
+            pTxEndpoints.swap(pIoThread->pendingTxEndpoints);
+        }
+
+        for (auto& pEndpoint : pTxEndpoints) {
+            pEndpoint->mTxNotified = false;
+            if (pEndpoint->mTxAliveFlag && !serveTx(pEndpoint)) {
+                retire(pIoThread, pEndpoint);
+            }
+        }
+        pTxEndpoints.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(pIoThread->mutex);
+            pIoThread->loopCount++;
+        }
+        pIoThread->cv.notify_all();
+    }
+
+    // Release waiting `detach()` calls
+    std::lock_guard<std::mutex> lock(pIoThread->mutex);
+    pIoThread->loopCount = UINT64_MAX;
+    pIoThread->cv.notify_all();
+}
+
+bool Reactor::serveRx(P2P_Endpoint* const pEndpoint) {
+    if (!pEndpoint->mRxAliveFlag) {
+        return false;
+    }
+
+    for (size_t i = 0; i < RX_READS_PER_EVENT; i++) {
+        if (!pEndpoint->checkRxPipe()) {
+            LOGE("Rx Pipe was broken!!!\n");
+            return false;
+        }
+
+        const ssize_t byteCount = pEndpoint->receive();
+        if (0 > byteCount) {
+            return false;
+        } else if (0 == byteCount) {
+            break;
+        }
+    }
+
+    return pEndpoint->checkRxPipe();
+}
+
+bool Reactor::serveTx(P2P_Endpoint* const pEndpoint) {
+    if (!pEndpoint->checkTxPipe()) {
+        LOGE("Tx Pipe was broken!!!\n");
+        return false;
+    }
+
+    {
+        // Queued packets wait until pending bytes have been written
+        std::unique_lock<std::mutex> lock = pEndpoint->lockTx();
+        if (pEndpoint->hasPendingTx() && (0 > pEndpoint->lflushPendingTx())) {
+            return false;
+        }
+
+        if (pEndpoint->hasPendingTx()) {
+            return true;
+        }
+    }
+
+    return (0 <= pEndpoint->transmit(false));
+}
+
+bool Reactor::watchTx(IoThread* const pIoThread, P2P_Endpoint* const pEndpoint) {
+    // The poll list is rebuilt by every iteration
+    (void)pIoThread;
+    (void)pEndpoint;
+    return true;
+}
+
+void Reactor::retire(IoThread* const pIoThread, P2P_Endpoint* const pEndpoint) {
+    {
+        std::lock_guard<std::mutex> lock(pIoThread->mutex);
+        for (auto it = pIoThread->pEndpoints.begin(); it != pIoThread->pEndpoints.end(); ++it) {
+            if (pEndpoint == *it) {
+                pIoThread->pEndpoints.erase(it);
+                pIoThread->numberOfEndpoints--;
+                break;
+            }
+        }
+    }
+
+    pEndpoint->mpRxSlab.reset();
+    pEndpoint->mRxAliveFlag = false;
+    pEndpoint->mTxAliveFlag = false;
+}
+
+}  // namespace comm
@@ -0,0 +1,232 @@
+#include "ShardedTcpServer.hpp"
+
+#include "common.hpp"
+
+#include <string>
+#include <thread>
+
+namespace comm {
+
+struct ShardedTcpServer::Shard {
+    std::shared_ptr<Reactor> pReactor;  // Declared first: outlives the clients it serves
+    std::unique_ptr<TcpServer> pServer;
+    EndpointConfig config;
+    ClientPacketHandler packetHandler;
+
+    mutable std::mutex mutex;  // Guards `pClients` (counted by other threads)
+    std::vector<std::unique_ptr<P2P_Endpoint>> pClients;
+
+    std::unique_ptr<Thread> pThread;  // Accepting thread
+};  // struct ShardedTcpServer::Shard
+
+/**
+ * @brief Endpoint of a client, for its packet handler: packets may be received before `tryAccept()` returns.
+ */
+struct ShardedTcpServer::ClientSlot {
+    std::atomic<P2P_Endpoint*> pEndpoint{nullptr};
+    std::mutex mutex;  // Held by the accepting thread until `pEndpoint` is set
+};  // struct ShardedTcpServer::ClientSlot
+
+static ThreadConfig get_shard_thread_config(const size_t& shardIndex, const std::vector<int>& cpus) {
+    ThreadConfig threadConfig;
+    threadConfig.name = "shard" + std::to_string(shardIndex);
+    if (!cpus.empty()) {
+        threadConfig.cpus.push_back(cpus[shardIndex % cpus.size()]);
+    }
+
+    return threadConfig;
+}
+
+ShardedTcpServer::ShardedTcpServer() {}
+
+ShardedTcpServer::~ShardedTcpServer() {
+    mExitFlag = true;
+
+    for (auto& pShard : mShards) {
+        if (pShard->pThread) {
+            pShard->pThread->join();
+        }
+    }
+
+    mShards.clear();
+
+    LOGI("Finalized.\n");
+}
+
+std::unique_ptr<ShardedTcpServer> ShardedTcpServer::create(
+    const uint16_t localPort, const size_t& numberOfShards, const ClientPacketHandler& packetHandler,
+    const EndpointConfig& config, const std::vector<int>& cpus) {
+    if (!packetHandler) {
+        LOGE("Packet handler is missing!!!\n");
+        return nullptr;
+    }
+
+    size_t count = numberOfShards;
+    if (0UL == count) {
+        count = std::thread::hardware_concurrency();
+        if (0UL == count) {
+            count = 1UL;
+        }
+    }
+
+    std::unique_ptr<ShardedTcpServer> pShardedServer(new ShardedTcpServer());
+    for (size_t i = 0; i < count; i++) {
+        std::unique_ptr<Shard> pShard(new Shard());
+
+        ThreadConfig ioThreadConfig = get_shard_thread_config(i, cpus);
+        ioThreadConfig.name += "-io";
+        pShard->pReactor = Reactor::create(1UL, ioThreadConfig);
+        if (!pShard->pReactor) {
+            LOGE("Could not create the reactor of shard %zu!!!\n", i);
+            return nullptr;
+        }
+
+        pShard->config = config;
+        pShard->config.pReactor = pShard->pReactor;
+        pShard->config.rxPacketHandler = nullptr;
+        pShard->config.rxBatchHandler = nullptr;
+        pShard->packetHandler = packetHandler;
+
+        pShard->pServer = TcpServer::create(localPort, pShard->config, true);
+        if (!pShard->pServer) {
+            LOGE("Could not create the listening socket of shard %zu!!!\n", i);
+            return nullptr;
+        }
+
+        pShardedServer->mShards.push_back(std::move(pShard));
+    }
+
+    // Shards start accepting once all of them listen
+    for (size_t i = 0; i < count; i++) {
+        ShardedTcpServer* const pSelf = pShardedServer.get();
+        Shard* const pShard = pShardedServer->mShards[i].get();
+        pShard->pThread = Thread::start(get_shard_thread_config(i, cpus), [pSelf, pShard]() { pSelf->run(pShard); });
+        if (!pShard->pThread) {
+            // Started shards are stopped by the destructor
+            LOGE("Could not start the accepting thread of shard %zu!!!\n", i);
+            return nullptr;
+        }
+    }
+
+    LOGI("%zu shards are listening at port %u ...\n", count, localPort);
+
+    return pShardedServer;
+}
+
+size_t ShardedTcpServer::getNumberOfClients(const size_t& shardIndex) const {
+    if (mShards.size() <= shardIndex) {
+        return 0UL;
+    }
+
+    std::lock_guard<std::mutex> lock(mShards[shardIndex]->mutex);
+    return mShards[shardIndex]->pClients.size();
+}
+
+size_t ShardedTcpServer::getNumberOfClients() const {
+    size_t count = 0UL;
+    for (size_t i = 0; i < mShards.size(); i++) {
+        count += getNumberOfClients(i);
+    }
+
+    return count;
+}
+
+size_t ShardedTcpServer::broadcast(std::unique_ptr<Packet>&& pPacket) {
+    size_t count = 0UL;
+    if (!pPacket) {
+        return count;
+    }
+
+    const std::shared_ptr<Packet> pSharedPacket(std::move(pPacket));
+    std::vector<P2P_Endpoint*> pClients;
+    for (auto& pShard : mShards) {
+        // Clients cannot be destroyed meanwhile, `send()` does not block
+        std::lock_guard<std::mutex> lock(pShard->mutex);
+        pClients.clear();
+        for (auto& pClient : pShard->pClients) {
+            pClients.push_back(pClient.get());
+        }
+
+        count += comm::broadcast(pClients, pSharedPacket);
+    }
+
+    return count;
+}
+
+void ShardedTcpServer::run(Shard* const pShard) {
+    std::vector<std::unique_ptr<P2P_Endpoint>> pDeadClients;
+    auto lastCleanup = monotonic_now();
+
+    while (!mExitFlag) {
+        int errorCode = 0;
+        const int ret = pShard->pServer->waitForConnectionRequest(errorCode, ACCEPT_WAIT_MS);
+        if (0 < ret) {
+            acceptAll(pShard);
+        } else if (0 > ret) {
+            // Do not spin on a broken listening socket
+            sleep_for(ACCEPT_WAIT_MS * US_PER_MS);
+        }
+
+        if ((ACCEPT_WAIT_MS * US_PER_MS) > get_elapsed_realtime_us(lastCleanup)) {
+            continue;
+        }
+        lastCleanup = monotonic_now();
+
+        {
+            std::lock_guard<std::mutex> lock(pShard->mutex);
+            for (auto it = pShard->pClients.begin(); it != pShard->pClients.end();) {
+                if ((*it)->isAlive()) {
+                    ++it;
+                } else {
+                    pDeadClients.push_back(std::move(*it));
+                    it = pShard->pClients.erase(it);
+                }
+            }
+        }
+
+        // Destroyed without holding the lock
+        pDeadClients.clear();
+    }
+}
+
+void ShardedTcpServer::acceptAll(Shard* const pShard) {
+    while (!mExitFlag) {
+        std::shared_ptr<ClientSlot> pSlot = std::make_shared<ClientSlot>();
+        EndpointConfig config = pShard->config;
+
+        // Runs on the I/O thread of the shard, which the client never leaves
+        config.rxPacketHandler = [pSlot, pShard](std::unique_ptr<Packet>& pPacket) {
+            P2P_Endpoint* pClient = pSlot->pEndpoint.load();
+            if (nullptr == pClient) {
+                std::lock_guard<std::mutex> lock(pSlot->mutex);
+                pClient = pSlot->pEndpoint.load();
+            }
+
+            pShard->packetHandler(*pClient, pPacket);
+        };
+
+        int errorCode = 0;
+        std::unique_lock<std::mutex> slotLock(pSlot->mutex);
+        std::unique_ptr<P2P_Endpoint> pClient = pShard->pServer->tryAccept(errorCode, config);
+        if (TcpServer::ACCEPT_RETRY == errorCode) {
+            // Dropped request, the following ones are still pending
+            continue;
+        } else if (0 != errorCode) {
+            // e.g. EMFILE (reported by `tryAccept()`): the request stays queued & the listening socket readable, back off
+            slotLock.unlock();
+            sleep_for(ACCEPT_WAIT_MS * US_PER_MS);
+            return;
+        } else if (!pClient) {
+            // Nothing pending anymore
+            return;
+        }
+
+        pSlot->pEndpoint = pClient.get();
+        slotLock.unlock();
+
+        std::lock_guard<std::mutex> lock(pShard->mutex);
+        pShard->pClients.push_back(std::move(pClient));
+    }
+}
+
+}  // namespace comm
@@ -5,71 +5,135 @@
 #include <cstdint>
 #include <memory>
 #include <netinet/in.h>
+#include <poll.h>
 #include <string>
 
 namespace comm {
 
-std::unique_ptr<IP_Endpoint> IP_Endpoint::createTcpClient(const std::string& serverAddr, const uint16_t& remotePort) {
+std::unique_ptr<IP_Endpoint> IP_Endpoint::createTcpClient(
+    const std::string& serverAddr, const uint16_t& remotePort,
+    const EndpointConfig& config) {
     std::unique_ptr<IP_Endpoint> tcpClient;
 
-    if (serverAddr.empty()) {
-        LOGE("Server 's Address is invalid!!!\n");
+    SOCKET socketFd;
+    struct sockaddr_in remoteSocketAddr;
+    int ret = startConnect(serverAddr, remotePort, socketFd, remoteSocketAddr);
+    if (0 > ret) {
         return tcpClient;
     }
 
-    if (0 == remotePort) {
-        LOGE("Server 's Port must be a positive value!!!\n");
-        return tcpClient;
+    // Connection in progress: completed (or failed) once the socket becomes writable
+    int errorCode = 0;
+    const auto deadline = monotonic_now() + std::chrono::milliseconds(CONNECT_TIMEOUT_MS);
+    while ((0 == ret) && (0 == errorCode)) {
+        const long remaining_ms = static_cast<long>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - monotonic_now()).count());
+        if (0L >= remaining_ms) {
+            errorCode = ETIMEDOUT;
+            break;
+        }
+
+        struct pollfd pollFd = {socketFd, POLLOUT, 0};
+        if (0 < pollConnects(errorCode, &pollFd, 1UL, static_cast<int>(remaining_ms))) {
+            errorCode = getConnectError(socketFd);
+            ret = 1;
+        }
     }
 
-    SOCKET socketFd = socket(AF_INET, SOCK_STREAM, 0);
-    if (0 > socketFd) {
-        LOGE("Could not create TCP socket: %d!!!\n", errno);
+    if (0 != errorCode) {
+        closeSocket(socketFd);
+        LOGE("Failed to connect to %s/%u: %d!!!\n", serverAddr.c_str(), remotePort, errorCode);
         return tcpClient;
     }
 
-    if (0 > IP_Endpoint::configureSocket(socketFd)) {
-        ::close(socketFd);
-        return tcpClient;
+    tcpClient.reset(new IP_Endpoint(socketFd, remoteSocketAddr, config));
+
+    LOGI("Connected to %s/%u.\n", serverAddr.c_str(), remotePort);
+
+    return tcpClient;
+}
+
+int IP_Endpoint::startConnect(
+    const std::string& serverAddr, const uint16_t& remotePort,
+    SOCKET& socketFd, struct sockaddr_in& remoteSocketAddr) {
+    if (serverAddr.empty()) {
+        LOGE("Server 's Address is invalid!!!\n");
+        return -1;
+    }
+
+    if (0 == remotePort) {
+        LOGE("Server 's Port must be a positive value!!!\n");
+        return -1;
     }
 
-    struct sockaddr_in remoteSocketAddr;
     remoteSocketAddr.sin_family = AF_INET;
     in_addr_t ipv4_addr = inet_addr(serverAddr.c_str());
     if ((INADDR_NONE == ipv4_addr) || (INADDR_ANY == ipv4_addr)) {
-        ::close(socketFd);
         LOGE("Invalid server address: `%s`!!!\n", serverAddr.c_str());
-        return tcpClient;
+        return -1;
     }
     remoteSocketAddr.sin_addr.s_addr = ipv4_addr;
     remoteSocketAddr.sin_port = htons(remotePort);
 
-    int ret;
-    const auto deadline = monotonic_now() + std::chrono::seconds(RX_TIMEOUT_S);
-    do {
-        ret = connect(socketFd, (const struct sockaddr*)(&remoteSocketAddr), sizeof(remoteSocketAddr));
-        if (0 == ret) {
-            break;
-        } else {
-            if ((EINPROGRESS == errno) || (EAGAIN == errno)) {
-                sleep_for(CONNECT_RETRY_BREAK_US);
-            } else {
-                break;
-            }
-        }
-    } while (deadline > monotonic_now());
+    socketFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (0 > socketFd) {
+        LOGE("Could not create TCP socket: %d!!!\n", errno);
+        return -1;
+    }
 
-    if (0 != ret) {
+    if (0 > IP_Endpoint::configureSocket(socketFd)) {
         ::close(socketFd);
-        LOGE("Failed to connect to %s/%u: %d!!!\n", serverAddr.c_str(), remotePort, errno);
-        return tcpClient;
+        return -1;
     }
 
-    tcpClient.reset(new IP_Endpoint(socketFd, remoteSocketAddr));
+    if (0 == connect(socketFd, (const struct sockaddr*)(&remoteSocketAddr), sizeof(remoteSocketAddr))) {
+        return 1;
+    }
 
-    LOGI("Connected to %s/%u.\n", serverAddr.c_str(), remotePort);
+    if ((EINPROGRESS == errno) || (EINTR == errno)) {
+        // Completed in the background (also after an interrupted connect)
+        return 0;
+    }
 
-    return tcpClient;
+    LOGE("Failed to connect to %s/%u: %d!!!\n", serverAddr.c_str(), remotePort, errno);
+    ::close(socketFd);
+    return -1;
+}
+
+int IP_Endpoint::pollConnects(int& errorCode, struct pollfd* const pPollFds, const size_t& count, const int& timeoutMs) {
+    errorCode = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        pPollFds[i].events = POLLOUT;
+        pPollFds[i].revents = 0;
+    }
+
+    const int ret = poll(pPollFds, static_cast<nfds_t>(count), timeoutMs);
+    if (0 > ret) {
+        if (EINTR == errno) {
+            return 0;
+        }
+
+        errorCode = errno;
+        LOGE("Failed to poll connecting sockets: %d!!!\n", errno);
+        return -1;
+    }
+
+    return ret;
+}
+
+int IP_Endpoint::getConnectError(const SOCKET socketFd) {
+    int socketError = 0;
+    socklen_t optionLength = sizeof(socketError);
+    if (0 != getsockopt(socketFd, SOL_SOCKET, SO_ERROR, &socketError, &optionLength)) {
+        return errno;
+    }
+
+    return socketError;
+}
+
+void IP_Endpoint::closeSocket(const SOCKET socketFd) {
+    ::close(socketFd);
 }
 
 }  // namespace comm
@@ -7,85 +7,137 @@
 
 namespace comm {
 
-std::unique_ptr<IP_Endpoint> IP_Endpoint::createTcpClient(const std::string& serverAddr, const uint16_t& remotePort) {
+std::unique_ptr<IP_Endpoint> IP_Endpoint::createTcpClient(
+    const std::string& serverAddr, const uint16_t& remotePort,
+    const EndpointConfig& config) {
     std::unique_ptr<IP_Endpoint> tcpClient;
 
+    SOCKET socketFd;
+    struct sockaddr_in remoteSocketAddr;
+    int ret = startConnect(serverAddr, remotePort, socketFd, remoteSocketAddr);
+    if (0 > ret) {
+        return tcpClient;
+    }
+
+    // Connection in progress: completed (or failed) once the socket becomes writable
+    int errorCode = 0;
+    const auto deadline = monotonic_now() + std::chrono::milliseconds(CONNECT_TIMEOUT_MS);
+    while ((0 == ret) && (0 == errorCode)) {
+        const long remaining_ms = static_cast<long>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - monotonic_now()).count());
+        if (0L >= remaining_ms) {
+            errorCode = WSAETIMEDOUT;
+            break;
+        }
+
+        WSAPOLLFD pollFd = {socketFd, POLLOUT, 0};
+        if (0 < pollConnects(errorCode, &pollFd, 1UL, static_cast<int>(remaining_ms))) {
+            errorCode = getConnectError(socketFd);
+            ret = 1;
+        }
+    }
+
+    if (0 != errorCode) {
+        closeSocket(socketFd);
+        LOGE("Failed to connect to %s/%u: %d!!!\n", serverAddr.c_str(), remotePort, errorCode);
+        return tcpClient;
+    }
+
+    tcpClient.reset(new IP_Endpoint(socketFd, remoteSocketAddr, config));
+
+    LOGI("Connected to %s/%u.\n", serverAddr.c_str(), remotePort);
+
+    return tcpClient;
+}
+
+int IP_Endpoint::startConnect(
+    const std::string& serverAddr, const uint16_t& remotePort,
+    SOCKET& socketFd, struct sockaddr_in& remoteSocketAddr) {
     if (serverAddr.empty()) {
         LOGE("Server 's Address is invalid!!!\n");
-        return tcpClient;
+        return -1;
     }
 
     if (0 == remotePort) {
         LOGE("Server 's Port must be a positive value!\n");
-        return tcpClient;
+        return -1;
     }
 
+    remoteSocketAddr.sin_family = AF_INET;
+    unsigned long ipv4_addr = inet_addr(serverAddr.c_str());
+    if ((INADDR_NONE == ipv4_addr) || (INADDR_ANY == ipv4_addr)) {
+        LOGE("Invalid server address: `%s`!!!\n", serverAddr.c_str());
+        return -1;
+    }
+    remoteSocketAddr.sin_addr.s_addr = ipv4_addr;
+    remoteSocketAddr.sin_port = htons(remotePort);
+
     WSADATA wsaData;
     int ret = WSAStartup(MAKEWORD(2, 2), &wsaData);
     if (NO_ERROR != ret) {
         LOGE("WSAStartup() failed: %d!!!\n", ret);
-        return tcpClient;
+        return -1;
     }
 
-    SOCKET socketFd = socket(AF_INET, SOCK_STREAM, 0);
+    socketFd = socket(AF_INET, SOCK_STREAM, 0);
     if (INVALID_SOCKET == socketFd) {
         WSACleanup();
         LOGE("Could not create TCP socket: %d!!!\n", WSAGetLastError());
-        return tcpClient;
+        return -1;
     }
 
     if (0 > IP_Endpoint::configureSocket(socketFd)) {
-        closesocket(socketFd);
-        WSACleanup();
-        return tcpClient;
+        closeSocket(socketFd);
+        return -1;
     }
 
-    struct sockaddr_in remoteSocketAddr;
-    remoteSocketAddr.sin_family = AF_INET;
-    unsigned long ipv4_addr = inet_addr(serverAddr.c_str());
-    if ((INADDR_NONE == ipv4_addr) || (INADDR_ANY == ipv4_addr)) {
-        closesocket(socketFd);
-        WSACleanup();
-        LOGE("Invalid server address: `%s`!!!\n", serverAddr.c_str());
-        return tcpClient;
+    if (0 == connect(socketFd, (const struct sockaddr*)(&remoteSocketAddr), sizeof(remoteSocketAddr))) {
+        return 1;
     }
-    remoteSocketAddr.sin_addr.s_addr = ipv4_addr;
-    remoteSocketAddr.sin_port = htons(remotePort);
 
-    int errorCode = 0;
-    const auto deadline = monotonic_now() + std::chrono::seconds(RX_TIMEOUT_S);
-    do {
-        ret = connect(socketFd, (const struct sockaddr*)(&remoteSocketAddr), sizeof(remoteSocketAddr));
-        if (0 == ret) {
-            LOGI("Connected to %s/%u.", serverAddr.c_str(), remotePort);
-            break;
-        } else {
-            // Reference: https://learn.microsoft.com/en-us/windows/win32/api/winsock2/nf-winsock2-connect#return-value
-            errorCode = WSAGetLastError();
-            if (WSAEISCONN == errorCode) {
-                // Socket is already connected.
-                ret = 0;
-                break;
-            } else if ((WSAEWOULDBLOCK == errorCode) || (WSAEALREADY == errorCode) || (WSAEINVAL == errorCode)) {
-                sleep_for(CONNECT_RETRY_BREAK_US);
-            } else {
-                break;
-            }
-        }
-    } while (deadline > monotonic_now());
+    // Reference: https://learn.microsoft.com/en-us/windows/win32/api/winsock2/nf-winsock2-connect#return-value
+    const int errorCode = WSAGetLastError();
+    if (WSAEWOULDBLOCK == errorCode) {
+        return 0;
+    }
+
+    closeSocket(socketFd);
+    LOGE("Failed to connect to %s/%u: %d!!!\n", serverAddr.c_str(), remotePort, errorCode);
+    return -1;
+}
+
+int IP_Endpoint::pollConnects(int& errorCode, struct pollfd* const pPollFds, const size_t& count, const int& timeoutMs) {
+    errorCode = 0;
 
+    // Failed connections are reported by `POLLERR` / `POLLHUP` only
+    for (size_t i = 0; i < count; i++) {
+        pPollFds[i].events = POLLOUT;
+        pPollFds[i].revents = 0;
+    }
+
+    const int ret = WSAPoll(pPollFds, static_cast<ULONG>(count), static_cast<INT>(timeoutMs));
     if (SOCKET_ERROR == ret) {
-        closesocket(socketFd);
-        WSACleanup();
-        LOGE("Failed to connect to %s/%u: %d!!!\n", serverAddr.c_str(), remotePort, errorCode);
-        return tcpClient;
+        errorCode = WSAGetLastError();
+        LOGE("Failed to poll connecting sockets: %d!!!\n", errorCode);
+        return -1;
     }
 
-    tcpClient.reset(new IP_Endpoint(socketFd, remoteSocketAddr));
+    return ret;
+}
 
-    LOGI("Connected to %s/%u.\n", serverAddr.c_str(), remotePort);
+int IP_Endpoint::getConnectError(const SOCKET socketFd) {
+    int socketError = 0;
+    int optionLength = sizeof(socketError);
+    if (SOCKET_ERROR == getsockopt(socketFd, SOL_SOCKET, SO_ERROR, (char*)(&socketError), &optionLength)) {
+        return WSAGetLastError();
+    }
 
-    return tcpClient;
+    return socketError;
+}
+
+void IP_Endpoint::closeSocket(const SOCKET socketFd) {
+    closesocket(socketFd);
+    WSACleanup();
 }
 
 }  // namespace comm
@@ -0,0 +1,159 @@
+#include "TcpConnectionPool.hpp"
+
+#include "common.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace comm {
+
+TcpConnectionPool::~TcpConnectionPool() {
+    mExitFlag = true;
+    mRefillCondition.notify_all();
+
+    if (mpThread) {
+        mpThread->join();
+    }
+
+    mIdleClients.clear();
+
+    LOGI("Finalized.\n");
+}
+
+std::unique_ptr<TcpConnectionPool> TcpConnectionPool::create(
+    const std::string& serverAddr, const uint16_t& remotePort, const size_t& size,
+    const EndpointConfig& config, const ThreadConfig& threadConfig) {
+    if (serverAddr.empty() || (0 == remotePort) || (0UL == size)) {
+        LOGE("Invalid pool settings: `%s`/%u, %zu connections!!!\n", serverAddr.c_str(), remotePort, size);
+        return nullptr;
+    }
+
+    std::unique_ptr<TcpConnectionPool> pPool(new TcpConnectionPool(serverAddr, remotePort, size, config));
+
+    TcpConnectionPool* const pSelf = pPool.get();
+    ThreadConfig maintenanceThreadConfig = threadConfig;
+    if (maintenanceThreadConfig.name.empty()) {
+        maintenanceThreadConfig.name = "conn-pool";
+    }
+    pPool->mpThread = Thread::start(maintenanceThreadConfig, [pSelf]() { pSelf->run(); });
+    if (!pPool->mpThread) {
+        LOGE("Could not start the maintenance thread!!!\n");
+        return nullptr;
+    }
+
+    LOGI("Keeping %zu connections to %s/%u ...\n", size, serverAddr.c_str(), remotePort);
+
+    return pPool;
+}
+
+std::unique_ptr<P2P_Endpoint> TcpConnectionPool::acquire(const long timeout_ms) {
+    std::unique_ptr<P2P_Endpoint> pClient;
+    std::vector<std::unique_ptr<P2P_Endpoint>> pDeadClients;
+
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        const auto deadline = monotonic_now() + std::chrono::milliseconds(timeout_ms);
+        while (!pClient) {
+            // Connections may have been closed by the server meanwhile
+            while (!mIdleClients.empty() && !pClient) {
+                if (mIdleClients.front()->isAlive()) {
+                    pClient = std::move(mIdleClients.front());
+                } else {
+                    pDeadClients.push_back(std::move(mIdleClients.front()));
+                }
+                mIdleClients.pop_front();
+            }
+
+            if (pClient || (std::cv_status::timeout == mIdleCondition.wait_until(lock, deadline))) {
+                break;
+            }
+        }
+    }
+
+    mRefillCondition.notify_one();
+
+    return pClient;
+}
+
+void TcpConnectionPool::release(std::unique_ptr<P2P_Endpoint>&& pClient) {
+    if (!pClient || !pClient->isAlive()) {
+        pClient.reset();
+        return;
+    }
+
+    std::unique_ptr<P2P_Endpoint> pExtraClient;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mSize > mIdleClients.size()) {
+            mIdleClients.push_back(std::move(pClient));
+        } else {
+            pExtraClient = std::move(pClient);
+        }
+    }
+
+    mIdleCondition.notify_one();
+}
+
+void TcpConnectionPool::run() {
+    TcpConnector connector(mConfig);
+    auto retryTime = monotonic_now();
+
+    const ConnectHandler handler = [this, &retryTime](const size_t& requestId, std::unique_ptr<P2P_Endpoint>& pClient,
+                                                      const int& errorCode) {
+        if (!pClient) {
+            retryTime = monotonic_now() + std::chrono::milliseconds(RECONNECT_BREAK_MS);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mIdleClients.push_back(std::move(pClient));
+        }
+        mIdleCondition.notify_one();
+    };
+
+    std::vector<std::unique_ptr<P2P_Endpoint>> pDeadClients;
+    while (!mExitFlag) {
+        size_t missing = 0UL;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            for (auto it = mIdleClients.begin(); it != mIdleClients.end();) {
+                if ((*it)->isAlive()) {
+                    ++it;
+                } else {
+                    pDeadClients.push_back(std::move(*it));
+                    it = mIdleClients.erase(it);
+                }
+            }
+
+            const size_t available = mIdleClients.size() + connector.getNumberOfPendingConnections();
+            missing = (mSize > available) ? (mSize - available) : 0UL;
+            if ((0UL == missing) && (0UL == connector.getNumberOfPendingConnections())) {
+                // Full: wait until a connection is handed out
+                mRefillCondition.wait_for(lock, std::chrono::milliseconds(MAINTENANCE_PERIOD_MS));
+            }
+        }
+
+        // Destroyed without holding the lock
+        pDeadClients.clear();
+
+        if ((0UL < missing) && (retryTime <= monotonic_now())) {
+            for (size_t i = 0; i < missing; i++) {
+                if (0UL == connector.connect(mServerAddr, mRemotePort)) {
+                    retryTime = monotonic_now() + std::chrono::milliseconds(RECONNECT_BREAK_MS);
+                    break;
+                }
+            }
+        }
+
+        if (0UL < connector.getNumberOfPendingConnections()) {
+            int errorCode = 0;
+            connector.waitForConnections(errorCode, handler, MAINTENANCE_PERIOD_MS);
+        } else if (0UL < missing) {
+            // Waiting for the next retry
+            sleep_for(RECONNECT_BREAK_MS * US_PER_MS);
+        }
+    }
+}
+
+}  // namespace comm
@@ -0,0 +1,96 @@
+#include "TcpConnector.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace comm {
+
+#ifdef __WIN32__
+static constexpr int CONNECT_TIMEOUT_ERROR = WSAETIMEDOUT;
+#else   // __WIN32__
+static constexpr int CONNECT_TIMEOUT_ERROR = ETIMEDOUT;
+#endif  // __WIN32__
+
+TcpConnector::~TcpConnector() {
+    for (auto& request : mRequests) {
+        IP_Endpoint::closeSocket(request.socketFd);
+    }
+}
+
+size_t TcpConnector::connect(const std::string& serverAddr, const uint16_t& remotePort, const long timeout_ms) {
+    Request request;
+    const int ret = IP_Endpoint::startConnect(serverAddr, remotePort, request.socketFd, request.remoteSocketAddr);
+    if (0 > ret) {
+        return 0UL;
+    }
+
+    request.id = mNextRequestId++;
+    if (0UL == mNextRequestId) {
+        mNextRequestId = 1UL;
+    }
+    request.deadline = monotonic_now() + std::chrono::milliseconds(timeout_ms);
+    request.connected = (0 < ret);
+    mRequests.push_back(request);
+
+    return request.id;
+}
+
+size_t TcpConnector::waitForConnections(int& errorCode, const ConnectHandler& handler, const long timeout_ms) {
+    errorCode = 0;
+    if (mRequests.empty()) {
+        return 0UL;
+    }
+
+    // Do not wait beyond the first deadline, nor at all if a request is already connected
+    auto now = monotonic_now();
+    long wait_ms = timeout_ms;
+    for (auto& request : mRequests) {
+        const long remaining_ms = request.connected ? 0L : static_cast<long>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(request.deadline - now).count());
+        wait_ms = std::max(0L, std::min(wait_ms, remaining_ms));
+    }
+
+    mPollFds.resize(mRequests.size());
+    for (size_t i = 0; i < mRequests.size(); i++) {
+        mPollFds[i].fd = mRequests[i].socketFd;
+    }
+
+    if (0 > IP_Endpoint::pollConnects(errorCode, mPollFds.data(), mPollFds.size(), static_cast<int>(wait_ms))) {
+        return 0UL;
+    }
+
+    // Completed requests leave the list before handlers run: they may start new requests
+    std::vector<std::pair<Request, int>> completed;
+    now = monotonic_now();
+    size_t pending = 0UL;
+    for (size_t i = 0; i < mRequests.size(); i++) {
+        const Request& request = mRequests[i];
+        if (request.connected) {
+            completed.emplace_back(request, 0);
+        } else if (0 != mPollFds[i].revents) {
+            completed.emplace_back(request, IP_Endpoint::getConnectError(request.socketFd));
+        } else if (request.deadline <= now) {
+            completed.emplace_back(request, CONNECT_TIMEOUT_ERROR);
+        } else {
+            mRequests[pending++] = request;
+        }
+    }
+    mRequests.resize(pending);
+
+    for (auto& result : completed) {
+        const Request& request = result.first;
+        std::unique_ptr<P2P_Endpoint> pClient;
+        if (0 == result.second) {
+            pClient.reset(new IP_Endpoint(request.socketFd, request.remoteSocketAddr, mConfig));
+        } else {
+            IP_Endpoint::closeSocket(request.socketFd);
+            LOGW("Connection request %zu failed: %d!\n", request.id, result.second);
+        }
+
+        handler(request.id, pClient, result.second);
+    }
+
+    return completed.size();
+}
+
+}  // namespace comm
@@ -3,13 +3,14 @@
 #include "IP_Endpoint.hpp"
 #include "common.hpp"
 
-#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
 
 namespace comm {
 
 constexpr struct sockaddr_in TcpServer::DUMMY_SOCKADDR;
 
-std::unique_ptr<TcpServer> TcpServer::create(const uint16_t localPort) {
+std::unique_ptr<TcpServer> TcpServer::create(const uint16_t localPort, const EndpointConfig& config, const bool reusePort) {
     std::unique_ptr<TcpServer> tcpServer;
 
     if (0 == localPort) {
@@ -28,6 +29,15 @@ std::unique_ptr<TcpServer> TcpServer::create(const uint16_t localPort) {
         return tcpServer;
     }
 
+    if (reusePort) {
+        int enable = 1;
+        if (0 > setsockopt(socketFd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable))) {
+            ::close(socketFd);
+            LOGE("Failed to enable SO_REUSEPORT: %d!!!\n", errno);
+            return tcpServer;
+        }
+    }
+
     struct sockaddr_in socketAddr;
     socketAddr.sin_family = AF_INET;
     socketAddr.sin_addr.s_addr = INADDR_ANY;
@@ -46,7 +56,7 @@ std::unique_ptr<TcpServer> TcpServer::create(const uint16_t localPort) {
         return tcpServer;
     }
 
-    tcpServer.reset(new TcpServer(socketFd));
+    tcpServer.reset(new TcpServer(socketFd, config));
 
     LOGI("TCP Server is listenning at port %u ...\n", localPort);
 
@@ -54,54 +64,107 @@ std::unique_ptr<TcpServer> TcpServer::create(const uint16_t localPort) {
 }
 
 std::unique_ptr<P2P_Endpoint> TcpServer::waitForClient(int &errorCode, const long timeout_ms) {
-    std::unique_ptr<IP_Endpoint> clientEndpoint;
-    struct sockaddr_in remoteSocketAddr;
-    socklen_t remoteAddressSize = (socklen_t)sizeof(remoteSocketAddr);
+    std::unique_ptr<P2P_Endpoint> clientEndpoint;
 
     const auto deadline = monotonic_now() + std::chrono::milliseconds(timeout_ms);
-    int socketFd;
-    errorCode = 0;
     do {
-        socketFd = accept(
-            mLocalSocketFd,
-            (struct sockaddr *)(&remoteSocketAddr),
-            &remoteAddressSize);
-
-        if (0 < socketFd) {
-            break;
-        } else if (0 == socketFd) {
-            // Should not happen!!!
-            LOGW("`accept()` returned 0!!!\n");
+        clientEndpoint = tryAccept(errorCode, mConfig);
+        if (ACCEPT_RETRY == errorCode) {
+            errorCode = 0;
+            continue;
+        } else if (clientEndpoint || (0 != errorCode)) {
             return clientEndpoint;
-        } else if (EWOULDBLOCK == errno) {
-            sleep_for(ACCEPT_RETRY_BREAK_MS * US_PER_MS);
-        } else {
-            errorCode = errno;
-            LOGE("Encountered errors when executing `accept()`: %d!!!\n", errno);
+        }
+
+        const long remaining_ms = static_cast<long>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - monotonic_now()).count());
+        if (0 > waitForConnectionRequest(errorCode, (0L < remaining_ms) ? remaining_ms : 0L)) {
             return clientEndpoint;
         }
     } while (deadline > monotonic_now());
 
-    if (0 >= socketFd) {
+    do {
+        clientEndpoint = tryAccept(errorCode, mConfig);
+    } while (ACCEPT_RETRY == errorCode);
+
+    if (!clientEndpoint && (0 == errorCode)) {
         LOGI("No pending connection.");
-        return clientEndpoint;
     }
 
-    int flags = fcntl(socketFd, F_GETFL, 0);
-    if (0 > flags) {
-        ::close(socketFd);
-        LOGE("Failed to get socket flags: %d!!!\n", errno);
-        return clientEndpoint;
+    return clientEndpoint;
+}
+
+size_t TcpServer::waitForClients(int &errorCode, const ClientHandler &handler, const long timeout_ms) {
+    size_t count = 0UL;
+
+    if (0 >= waitForConnectionRequest(errorCode, timeout_ms)) {
+        return count;
+    }
+
+    // Drain the accept queue: one wakeup for a whole burst of connection requests
+    while (MAX_ACCEPTS_PER_WAIT > count) {
+        std::unique_ptr<P2P_Endpoint> clientEndpoint = tryAccept(errorCode, mConfig);
+        if (ACCEPT_RETRY == errorCode) {
+            // Dropped request, the following ones are still pending
+            errorCode = 0;
+            continue;
+        } else if (!clientEndpoint) {
+            break;
+        }
+
+        count++;
+        handler(clientEndpoint);
     }
 
-    if (0 > fcntl(socketFd, F_SETFL, (flags | O_NONBLOCK))) {
+    return count;
+}
+
+int TcpServer::waitForConnectionRequest(int &errorCode, const long timeout_ms) {
+    errorCode = 0;
+
+    struct pollfd pollFd = {mLocalSocketFd, POLLIN, 0};
+    const int ret = poll(&pollFd, 1, static_cast<int>(timeout_ms));
+    if (0 > ret) {
+        if (EINTR == errno) {
+            return 0;
+        }
+
         errorCode = errno;
-        ::close(socketFd);
-        LOGE("Failed to enable NON-BLOCKING mode: %d!!!\n", errno);
+        LOGE("Failed to poll the listening socket: %d!!!\n", errno);
+        return -1;
+    }
+
+    return (0 < ret) ? 1 : 0;
+}
+
+std::unique_ptr<P2P_Endpoint> TcpServer::tryAccept(int &errorCode, const EndpointConfig &config) {
+    std::unique_ptr<IP_Endpoint> clientEndpoint;
+    struct sockaddr_in remoteSocketAddr;
+    socklen_t remoteAddressSize = (socklen_t)sizeof(remoteSocketAddr);
+
+    errorCode = 0;
+    const int socketFd = accept4(
+        mLocalSocketFd,
+        (struct sockaddr *)(&remoteSocketAddr),
+        &remoteAddressSize,
+        SOCK_NONBLOCK);
+
+    if (0 == socketFd) {
+        // Should not happen!!!
+        LOGW("`accept()` returned 0!!!\n");
+        return clientEndpoint;
+    } else if (0 > socketFd) {
+        if ((ECONNABORTED == errno) || (EINTR == errno)) {
+            // Aborted connection requests are dropped from the queue, others may be pending
+            errorCode = ACCEPT_RETRY;
+        } else if ((EWOULDBLOCK != errno) && (EAGAIN != errno)) {
+            errorCode = errno;
+            LOGE("Encountered errors when executing `accept4()`: %d!!!\n", errno);
+        }
         return clientEndpoint;
     }
 
-    clientEndpoint.reset(new IP_Endpoint(socketFd, DUMMY_SOCKADDR));
+    clientEndpoint.reset(new IP_Endpoint(socketFd, DUMMY_SOCKADDR, config));
 
     return clientEndpoint;
 }
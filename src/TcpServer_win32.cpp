@@ -6,7 +6,7 @@ namespace comm {
 
 constexpr struct sockaddr_in TcpServer::DUMMY_SOCKADDR;
 
-std::unique_ptr<TcpServer> TcpServer::create(const uint16_t localPort) {
+std::unique_ptr<TcpServer> TcpServer::create(const uint16_t localPort, const EndpointConfig& config, const bool reusePort) {
     std::unique_ptr<TcpServer> tcpServer;
 
     if (0 == localPort) {
@@ -14,6 +14,12 @@ std::unique_ptr<TcpServer> TcpServer::create(const uint16_t localPort) {
         return tcpServer;
     }
 
+    if (reusePort) {
+        // SO_REUSEADDR does not spread connections over sockets on Windows
+        LOGE("SO_REUSEPORT is not supported!!!\n");
+        return tcpServer;
+    }
+
     WSADATA wsaData;
     int ret = WSAStartup(MAKEWORD(2, 2), &wsaData);
     if (NO_ERROR != ret) {
@@ -54,7 +60,7 @@ std::unique_ptr<TcpServer> TcpServer::create(const uint16_t localPort) {
         return tcpServer;
     }
 
-    tcpServer.reset(new TcpServer(socketFd));
+    tcpServer.reset(new TcpServer(socketFd, config));
 
     LOGI("TCP Server is listenning at port %u ...\n", localPort);
 
@@ -62,34 +68,94 @@ std::unique_ptr<TcpServer> TcpServer::create(const uint16_t localPort) {
 }
 
 std::unique_ptr<P2P_Endpoint> TcpServer::waitForClient(int &errorCode, const long timeout_ms) {
-    std::unique_ptr<IP_Endpoint> clientEndpoint;
-    struct sockaddr_in remoteSocketAddr;
-    int remoteAddressSize = (int)sizeof(remoteSocketAddr);
+    std::unique_ptr<P2P_Endpoint> clientEndpoint;
 
     const auto deadline = monotonic_now() + std::chrono::milliseconds(timeout_ms);
-    SOCKET socketFd;
-    errorCode = 0;
     do {
-        socketFd = accept(
-            mLocalSocketFd,
-            (struct sockaddr *)(&remoteSocketAddr),
-            &remoteAddressSize);
-
-        if (INVALID_SOCKET == socketFd) {
-            if (WSAEWOULDBLOCK == WSAGetLastError()) {
-                sleep_for(ACCEPT_RETRY_BREAK_MS * US_PER_MS);
-            } else {
-                errorCode = WSAGetLastError();
-                LOGE("Encountered errors when executing `accept()`: %d!!!\n", WSAGetLastError());
-                return clientEndpoint;
-            }
-        } else {
-            break;
+        clientEndpoint = tryAccept(errorCode, mConfig);
+        if (ACCEPT_RETRY == errorCode) {
+            errorCode = 0;
+            continue;
+        } else if (clientEndpoint || (0 != errorCode)) {
+            return clientEndpoint;
+        }
+
+        const long remaining_ms = static_cast<long>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - monotonic_now()).count());
+        if (0 > waitForConnectionRequest(errorCode, (0L < remaining_ms) ? remaining_ms : 0L)) {
+            return clientEndpoint;
         }
     } while (deadline > monotonic_now());
 
-    if (INVALID_SOCKET == socketFd) {
+    do {
+        clientEndpoint = tryAccept(errorCode, mConfig);
+    } while (ACCEPT_RETRY == errorCode);
+
+    if (!clientEndpoint && (0 == errorCode)) {
         LOGI("No pending connection.");
+    }
+
+    return clientEndpoint;
+}
+
+size_t TcpServer::waitForClients(int &errorCode, const ClientHandler &handler, const long timeout_ms) {
+    size_t count = 0UL;
+
+    if (0 >= waitForConnectionRequest(errorCode, timeout_ms)) {
+        return count;
+    }
+
+    // Drain the accept queue: one wakeup for a whole burst of connection requests
+    while (MAX_ACCEPTS_PER_WAIT > count) {
+        std::unique_ptr<P2P_Endpoint> clientEndpoint = tryAccept(errorCode, mConfig);
+        if (ACCEPT_RETRY == errorCode) {
+            // Dropped request, the following ones are still pending
+            errorCode = 0;
+            continue;
+        } else if (!clientEndpoint) {
+            break;
+        }
+
+        count++;
+        handler(clientEndpoint);
+    }
+
+    return count;
+}
+
+int TcpServer::waitForConnectionRequest(int &errorCode, const long timeout_ms) {
+    errorCode = 0;
+
+    WSAPOLLFD pollFd = {mLocalSocketFd, POLLRDNORM, 0};
+    const int ret = WSAPoll(&pollFd, 1, static_cast<INT>(timeout_ms));
+    if (SOCKET_ERROR == ret) {
+        errorCode = WSAGetLastError();
+        LOGE("Failed to poll the listening socket: %d!!!\n", errorCode);
+        return -1;
+    }
+
+    return (0 < ret) ? 1 : 0;
+}
+
+std::unique_ptr<P2P_Endpoint> TcpServer::tryAccept(int &errorCode, const EndpointConfig &config) {
+    std::unique_ptr<IP_Endpoint> clientEndpoint;
+    struct sockaddr_in remoteSocketAddr;
+    int remoteAddressSize = (int)sizeof(remoteSocketAddr);
+
+    errorCode = 0;
+    const SOCKET socketFd = accept(
+        mLocalSocketFd,
+        (struct sockaddr *)(&remoteSocketAddr),
+        &remoteAddressSize);
+
+    if (INVALID_SOCKET == socketFd) {
+        if ((WSAECONNRESET == WSAGetLastError()) || (WSAEINTR == WSAGetLastError())) {
+            // Reset connection requests are dropped from the queue, others may be pending
+            errorCode = ACCEPT_RETRY;
+        } else if (WSAEWOULDBLOCK != WSAGetLastError()) {
+            errorCode = WSAGetLastError();
+            LOGE("Encountered errors when executing `accept()`: %d!!!\n", WSAGetLastError());
+        }
         return clientEndpoint;
     }
 
@@ -101,7 +167,7 @@ std::unique_ptr<P2P_Endpoint> TcpServer::waitForClient(int &errorCode, const lon
         return clientEndpoint;
     }
 
-    clientEndpoint.reset(new IP_Endpoint(socketFd, DUMMY_SOCKADDR));
+    clientEndpoint.reset(new IP_Endpoint(socketFd, DUMMY_SOCKADDR, config));
 
     return clientEndpoint;
 }
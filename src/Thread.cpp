@@ -0,0 +1,174 @@
+#include "Thread.hpp"
+
+#include "common.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <memory>
+#include <pthread.h>
+#include <sched.h>
+
+namespace comm {
+
+/**
+ * @brief Everything a new thread needs, owned by the thread once it is started.
+ */
+struct ThreadContext {
+    std::string name;
+    std::function<void()> function;
+};  // struct ThreadContext
+
+static void* run_thread(void* pArg) {
+    std::unique_ptr<ThreadContext> pContext(static_cast<ThreadContext*>(pArg));
+
+    // The name can only be given to a running thread
+    if (!pContext->name.empty()) {
+        const std::string name = pContext->name.substr(0, MAX_THREAD_NAME_LENGTH);
+        const int ret = pthread_setname_np(pthread_self(), name.c_str());
+        if (0 != ret) {
+            LOGW("Failed to set thread name `%s`: %d!\n", name.c_str(), ret);
+        }
+    }
+
+    pContext->function();
+
+    return nullptr;
+}
+
+static int create_thread(
+    const ThreadConfig& config, const bool realtime, const bool pinned, ThreadContext* const pContext, pthread_t& thread) {
+    pthread_attr_t attr;
+    int ret = pthread_attr_init(&attr);
+    if (0 != ret) {
+        return ret;
+    }
+
+    if (0UL < config.stackSize) {
+        const size_t minStackSize = static_cast<size_t>(PTHREAD_STACK_MIN);
+        const size_t stackSize = (minStackSize > config.stackSize) ? minStackSize : config.stackSize;
+        ret = pthread_attr_setstacksize(&attr, stackSize);
+        if (0 != ret) {
+            LOGW("Invalid stack size %zu: %d!\n", config.stackSize, ret);
+        }
+    }
+
+    if (pinned) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (const int& cpu : config.cpus) {
+            if ((0 <= cpu) && (CPU_SETSIZE > cpu)) {
+                CPU_SET(cpu, &cpuSet);
+            } else {
+                LOGW("Invalid CPU %d!\n", cpu);
+            }
+        }
+        pthread_attr_setaffinity_np(&attr, sizeof(cpuSet), &cpuSet);
+    }
+
+    if (realtime) {
+        const int minPriority = sched_get_priority_min(SCHED_FIFO);
+        const int maxPriority = sched_get_priority_max(SCHED_FIFO);
+        struct sched_param param;
+        param.sched_priority = (minPriority > config.fifoPriority) ? minPriority : config.fifoPriority;
+        param.sched_priority = (maxPriority < param.sched_priority) ? maxPriority : param.sched_priority;
+
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &param);
+    }
+
+    ret = pthread_create(&thread, &attr, run_thread, pContext);
+    pthread_attr_destroy(&attr);
+
+    return ret;
+}
+
+Thread::~Thread() {
+    join();
+}
+
+std::unique_ptr<Thread> Thread::start(const ThreadConfig& config, const std::function<void()>& function) {
+    std::unique_ptr<Thread> pThread(new Thread());
+    std::unique_ptr<ThreadContext> pContext(new ThreadContext());
+    pContext->name = config.name;
+    pContext->function = function;
+
+    bool realtime = (0 < config.fifoPriority);
+    bool pinned = !config.cpus.empty();
+    int ret = create_thread(config, realtime, pinned, pContext.get(), pThread->mThread);
+    if ((EPERM == ret) && realtime) {
+        LOGW("Not permitted to use SCHED_FIFO, fall back to the default policy!\n");
+        realtime = false;
+        ret = create_thread(config, realtime, pinned, pContext.get(), pThread->mThread);
+    }
+
+    if ((EINVAL == ret) && pinned) {
+        // E.g. none of the CPUs is online
+        LOGW("Invalid CPU affinity, the thread may run on any CPU!\n");
+        pinned = false;
+        ret = create_thread(config, realtime, pinned, pContext.get(), pThread->mThread);
+    }
+
+    if (0 != ret) {
+        LOGE("Failed to start thread: %d!!!\n", ret);
+        return nullptr;
+    }
+
+    // Owned by the thread from now on
+    pContext.release();
+    pThread->mJoinable = true;
+
+    return pThread;
+}
+
+void Thread::join() {
+    if (!mJoinable) {
+        return;
+    }
+    mJoinable = false;
+
+    if (pthread_equal(pthread_self(), mThread)) {
+        pthread_detach(mThread);
+        return;
+    }
+
+    const int ret = pthread_join(mThread, nullptr);
+    if (0 != ret) {
+        LOGE("Failed to join thread: %d!!!\n", ret);
+    }
+}
+
+ThreadConfig Thread::getCurrentSettings() {
+    ThreadConfig settings;
+    const pthread_t self = pthread_self();
+
+    char name[MAX_THREAD_NAME_LENGTH + 1] = {0};
+    if (0 == pthread_getname_np(self, name, sizeof(name))) {
+        settings.name = name;
+    }
+
+    cpu_set_t cpuSet;
+    if (0 == pthread_getaffinity_np(self, sizeof(cpuSet), &cpuSet)) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &cpuSet)) {
+                settings.cpus.push_back(cpu);
+            }
+        }
+    }
+
+    int policy = SCHED_OTHER;
+    struct sched_param param;
+    if ((0 == pthread_getschedparam(self, &policy, &param)) && (SCHED_FIFO == policy)) {
+        settings.fifoPriority = param.sched_priority;
+    }
+
+    pthread_attr_t attr;
+    if (0 == pthread_getattr_np(self, &attr)) {
+        pthread_attr_getstacksize(&attr, &settings.stackSize);
+        pthread_attr_destroy(&attr);
+    }
+
+    return settings;
+}
+
+}  // namespace comm
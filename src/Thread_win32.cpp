@@ -0,0 +1,68 @@
+#include "Thread.hpp"
+
+#include "common.hpp"
+
+#include <thread>
+#include <windows.h>
+
+namespace comm {
+
+// Settings applied by the calling thread (they cannot be read back on this platform)
+static thread_local ThreadConfig tSettings;
+
+Thread::~Thread() {
+    join();
+}
+
+std::unique_ptr<Thread> Thread::start(const ThreadConfig& config, const std::function<void()>& function) {
+    // Names, stack sizes & real-time policies are not supported: affinity & priority are applied by the thread itself
+    if (!config.name.empty() || (0UL < config.stackSize)) {
+        LOGW("Thread names & stack sizes are not supported!\n");
+    }
+
+    std::unique_ptr<Thread> pThread(new Thread());
+    pThread->mThread = std::thread([config, function]() {
+        tSettings = ThreadConfig();
+
+        if (!config.cpus.empty()) {
+            DWORD_PTR mask = 0;
+            for (const int& cpu : config.cpus) {
+                if ((0 <= cpu) && (static_cast<int>(sizeof(DWORD_PTR) * 8) > cpu)) {
+                    mask |= (static_cast<DWORD_PTR>(1) << cpu);
+                }
+            }
+
+            if ((0 != mask) && (0 != SetThreadAffinityMask(GetCurrentThread(), mask))) {
+                tSettings.cpus = config.cpus;
+            } else {
+                LOGW("Invalid CPU affinity, the thread may run on any CPU!\n");
+            }
+        }
+
+        if ((0 < config.fifoPriority) && SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+            tSettings.fifoPriority = config.fifoPriority;
+        }
+
+        function();
+    });
+
+    return pThread;
+}
+
+void Thread::join() {
+    if (!mThread.joinable()) {
+        return;
+    }
+
+    if (std::this_thread::get_id() == mThread.get_id()) {
+        mThread.detach();
+    } else {
+        mThread.join();
+    }
+}
+
+ThreadConfig Thread::getCurrentSettings() {
+    return tSettings;
+}
+
+}  // namespace comm
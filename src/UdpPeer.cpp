@@ -9,7 +9,9 @@
 
 namespace comm {
 
-std::unique_ptr<IP_Endpoint> IP_Endpoint::createUdpPeer(const uint16_t& localPort, const std::string& peerAddress, const uint16_t& peerPort) {
+std::unique_ptr<IP_Endpoint> IP_Endpoint::createUdpPeer(
+    const uint16_t& localPort, const std::string& peerAddress, const uint16_t& peerPort,
+    const EndpointConfig& config) {
     std::unique_ptr<IP_Endpoint> udpPeer;
 
     if ((0 == localPort) && (0 == peerPort)) {
@@ -56,7 +58,7 @@ std::unique_ptr<IP_Endpoint> IP_Endpoint::createUdpPeer(const uint16_t& localPor
     remoteSocketAddr.sin_addr.s_addr = ipv4_addr;
     remoteSocketAddr.sin_port = htons(peerPort);
 
-    udpPeer.reset(new IP_Endpoint(socketFd, remoteSocketAddr));
+    udpPeer.reset(new IP_Endpoint(socketFd, remoteSocketAddr, config));
 
     LOGI("Created new UdpPeer (local port: %u) <=> `%s`/%u.\n", localPort, peerAddress.c_str(), peerPort);
 
@@ -0,0 +1,167 @@
+#include "Reactor.hpp"
+#include "TcpConnectionPool.hpp"
+#include "TcpConnector.hpp"
+#include "TcpServer.hpp"
+#include "common.hpp"
+
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+
+// A TcpConnector connects many clients in parallel (a request to a closed port must fail), then a pool keeps warm
+// connections: it is refilled once connections are handed out, and dead connections (closed by the server) are replaced.
+
+static constexpr size_t NUMBER_OF_CONNECTIONS = 16UL;
+static constexpr size_t POOL_SIZE = 4UL;
+static constexpr long TIMEOUT_US = 5000000L;  // 5s
+
+/**
+ * @brief Accept clients until `condition` holds or the timeout expires.
+ */
+static bool wait_until(comm::TcpServer& server, std::vector<std::unique_ptr<comm::P2P_Endpoint>>& pAccepted,
+                       const std::function<bool()>& condition) {
+    int errorCode = 0;
+    const auto t0 = monotonic_now();
+    while (!condition() && (TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+        server.waitForClients(errorCode, pAccepted, 10L);
+    }
+
+    return condition();
+}
+
+static bool test_connector(const uint16_t& port, const comm::EndpointConfig& config) {
+    comm::TcpConnector connector(config);
+
+    std::set<size_t> requestIds;
+    for (size_t i = 0; i < NUMBER_OF_CONNECTIONS; i++) {
+        requestIds.insert(connector.connect("127.0.0.1", port));
+    }
+
+    // Nobody listens there
+    const size_t refusedId = connector.connect("127.0.0.1", static_cast<uint16_t>(port + 1U));
+    if ((NUMBER_OF_CONNECTIONS != requestIds.size()) || (0UL < requestIds.count(0UL)) || (0UL == refusedId) ||
+        (NUMBER_OF_CONNECTIONS + 1UL != connector.getNumberOfPendingConnections())) {
+        LOGE("Could not start connection requests!!!\n");
+        return false;
+    }
+
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pClients;
+    int refusedError = 0;
+    size_t completed = 0UL;
+    int errorCode = 0;
+    const auto t0 = monotonic_now();
+    while ((NUMBER_OF_CONNECTIONS + 1UL > completed) && (TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+        completed += connector.waitForConnections(
+            errorCode,
+            [&](const size_t& requestId, std::unique_ptr<comm::P2P_Endpoint>& pClient, const int& error) {
+                if (refusedId == requestId) {
+                    refusedError = error;
+                } else if (pClient && (0 == error) && (0UL < requestIds.erase(requestId))) {
+                    pClients.push_back(std::move(pClient));
+                }
+            },
+            100L);
+    }
+
+    if ((NUMBER_OF_CONNECTIONS != pClients.size()) || (0 == refusedError) || (0UL < connector.getNumberOfPendingConnections())) {
+        LOGE("%zu/%zu connected, refused request: %d!!!\n", pClients.size(), NUMBER_OF_CONNECTIONS, refusedError);
+        return false;
+    }
+
+    return true;
+}
+
+static bool test_pool(comm::TcpServer& server, const uint16_t& port, const comm::EndpointConfig& config) {
+    std::unique_ptr<comm::TcpConnectionPool> pPool = comm::TcpConnectionPool::create("127.0.0.1", port, POOL_SIZE, config);
+    if (!pPool) {
+        LOGE("Could not create connection pool!!!\n");
+        return false;
+    }
+
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pAccepted;
+    const auto isFull = [&pPool]() { return POOL_SIZE == pPool->getNumberOfIdleConnections(); };
+    if (!wait_until(server, pAccepted, isFull)) {
+        LOGE("Warm-up: %zu/%zu idle connections!!!\n", pPool->getNumberOfIdleConnections(), POOL_SIZE);
+        return false;
+    }
+
+    // Handed out connections are replaced
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pClients;
+    for (size_t i = 0; i < POOL_SIZE; i++) {
+        std::unique_ptr<comm::P2P_Endpoint> pClient = pPool->acquire();
+        if (!pClient || !pClient->isAlive()) {
+            LOGE("Could not acquire connection %zu!!!\n", i);
+            return false;
+        }
+        pClients.push_back(std::move(pClient));
+    }
+
+    if (!wait_until(server, pAccepted, isFull) || (2UL * POOL_SIZE != pAccepted.size())) {
+        LOGE("Refill: %zu/%zu idle connections, %zu accepted!!!\n", pPool->getNumberOfIdleConnections(), POOL_SIZE,
+             pAccepted.size());
+        return false;
+    }
+
+    // Full pool: released connections are dropped
+    pPool->release(std::move(pClients.back()));
+    pClients.pop_back();
+    if (POOL_SIZE != pPool->getNumberOfIdleConnections()) {
+        LOGE("Released connection was kept by a full pool!!!\n");
+        return false;
+    }
+
+    // Connections closed by the server are replaced
+    pAccepted.clear();
+    const auto isRefilled = [&pAccepted, &isFull]() { return (POOL_SIZE <= pAccepted.size()) && isFull(); };
+    if (!wait_until(server, pAccepted, isRefilled) || (POOL_SIZE != pAccepted.size())) {
+        LOGE("Replacement: %zu/%zu idle connections, %zu accepted!!!\n", pPool->getNumberOfIdleConnections(), POOL_SIZE,
+             pAccepted.size());
+        return false;
+    }
+
+    std::unique_ptr<comm::P2P_Endpoint> pClient = pPool->acquire();
+    if (!pClient || !pClient->isAlive()) {
+        LOGE("Could not acquire a new connection once the server closed the old ones!!!\n");
+        return false;
+    }
+
+    pPool->release(std::move(pClient));
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (2 > argc) {
+        LOGE("Usage: %s <Local Port>\n", argv[0]);
+        return 1;
+    }
+
+    const uint16_t port = static_cast<uint16_t>(atoi(argv[1]));
+
+    comm::EndpointConfig config;
+    config.pReactor = comm::Reactor::create(1UL);
+
+    std::unique_ptr<comm::TcpServer> pServer = comm::TcpServer::create(port, config);
+    if (!pServer) {
+        LOGE("Could not create TCP Server which listens at port %u!!!\n", port);
+        return 1;
+    }
+
+    bool result = test_connector(port, config);
+    LOGI("TcpConnector -> %s\n", result ? "Passed" : "Failed");
+
+    // Requests of the connector are pending in the accept queue
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pAccepted;
+    wait_until(*pServer, pAccepted, [&pAccepted]() { return NUMBER_OF_CONNECTIONS <= pAccepted.size(); });
+    pAccepted.clear();
+
+    const bool poolResult = test_pool(*pServer, port, config);
+    LOGI("TcpConnectionPool -> %s\n", poolResult ? "Passed" : "Failed");
+    result &= poolResult;
+
+    LOGI("-> %s\n", result ? "Passed" : "Failed");
+
+    return result ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+#include "AsyncEndpoint.hpp"
+#include "AsyncTcpServer.hpp"
+#include "EventLoop.hpp"
+#include "Packet.hpp"
+#include "Reactor.hpp"
+#include "common.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// One loop thread drives many endpoints (served by a single reactor I/O thread) with coroutines:
+// UdpPeer pairs play ping-pong, TCP clients talk to echo coroutines of accepted connections.
+
+static constexpr size_t DEFAULT_NUMBER_OF_PAIRS = 32UL;
+static constexpr size_t NUMBER_OF_TCP_CLIENTS = 4UL;
+static constexpr size_t NUMBER_OF_ROUNDS = 100UL;
+static constexpr size_t PAYLOAD_SIZE = 16UL;
+static constexpr long TEST_TIMEOUT_US = 20000000L;  // 20s
+
+struct Progress {
+    comm::EventLoop* pLoop = nullptr;
+    size_t remaining = 0UL;  // Coroutines still running
+    size_t failures = 0UL;
+
+    void done(const bool& passed) {
+        if (!passed) {
+            failures++;
+        }
+
+        if (0UL == --remaining) {
+            pLoop->stop();
+        }
+    }
+};  // struct Progress
+
+static void fill_payload(uint8_t* const pPayload, const size_t& index, const size_t& round) {
+    for (size_t i = 0; i < PAYLOAD_SIZE; i++) {
+        pPayload[i] = static_cast<uint8_t>(index + round + i);
+    }
+}
+
+static comm::Task ping(comm::AsyncEndpoint* const pEndpoint, const size_t index, Progress* const pProgress) {
+    uint8_t payload[PAYLOAD_SIZE];
+    for (size_t round = 0; round < NUMBER_OF_ROUNDS; round++) {
+        fill_payload(payload, index, round);
+        if (!co_await pEndpoint->send(comm::Packet::create(payload, sizeof(payload)))) {
+            LOGE("[%zu] Could not send packet %zu!!!\n", index, round);
+            pProgress->done(false);
+            co_return;
+        }
+
+        std::unique_ptr<comm::Packet> pPacket = co_await pEndpoint->recv();
+        if ((!pPacket) || (PAYLOAD_SIZE != pPacket->getPayloadSize()) ||
+            (0 != memcmp(payload, pPacket->getPayload(), PAYLOAD_SIZE))) {
+            LOGE("[%zu] Reply %zu is missing or corrupted!!!\n", index, round);
+            pProgress->done(false);
+            co_return;
+        }
+    }
+
+    pProgress->done(true);
+}
+
+static comm::Task echo(comm::AsyncEndpoint* const pEndpoint, const size_t index, Progress* const pProgress) {
+    for (size_t round = 0; round < NUMBER_OF_ROUNDS; round++) {
+        std::unique_ptr<comm::Packet> pPacket = co_await pEndpoint->recv();
+        if ((!pPacket) || !co_await pEndpoint->send(std::move(pPacket))) {
+            LOGE("[%zu] Could not echo packet %zu!!!\n", index, round);
+            pProgress->done(false);
+            co_return;
+        }
+    }
+
+    pProgress->done(true);
+}
+
+static comm::Task serve(
+    comm::EventLoop* const pLoop, comm::AsyncTcpServer* const pServer,
+    std::vector<std::unique_ptr<comm::AsyncEndpoint>>* const pClients, Progress* const pProgress) {
+    for (size_t i = 0; i < NUMBER_OF_TCP_CLIENTS; i++) {
+        std::unique_ptr<comm::AsyncEndpoint> pClient = co_await pServer->accept();
+        if (!pClient) {
+            LOGE("Could not accept client %zu!!!\n", i);
+            pProgress->done(false);
+            co_return;
+        }
+
+        pLoop->spawn(echo(pClient.get(), i, pProgress));
+        pClients->push_back(std::move(pClient));
+    }
+
+    pProgress->done(true);
+}
+
+int main(int argc, char** argv) {
+    if (2 > argc) {
+        LOGE("Usage: %s <Local Port> [Number of UdpPeer Pairs]\n", argv[0]);
+        return 1;
+    }
+
+    uint16_t port = static_cast<uint16_t>(atoi(argv[1]));
+    const size_t numberOfPairs = (2 < argc) ? static_cast<size_t>(atol(argv[2])) : DEFAULT_NUMBER_OF_PAIRS;
+
+    std::unique_ptr<comm::EventLoop> pLoop = comm::EventLoop::create();
+    if (!pLoop) {
+        return 1;
+    }
+
+    comm::EndpointConfig config;
+    config.pReactor = comm::Reactor::create(1UL);
+
+    Progress progress;
+    progress.pLoop = pLoop.get();
+
+    // UdpPeer pairs
+    std::vector<std::unique_ptr<comm::AsyncEndpoint>> pEndpoints;
+    for (size_t i = 0; i < numberOfPairs; i++) {
+        const uint16_t portA = port++;
+        const uint16_t portB = port++;
+        std::unique_ptr<comm::AsyncEndpoint> pPinger = comm::AsyncEndpoint::createUdpPeer(*pLoop, portA, "127.0.0.1", portB, config);
+        std::unique_ptr<comm::AsyncEndpoint> pEchoer = comm::AsyncEndpoint::createUdpPeer(*pLoop, portB, "127.0.0.1", portA, config);
+        if ((!pPinger) || (!pEchoer)) {
+            LOGE("Could not create UdpPeer pair %zu!!!\n", i);
+            return 1;
+        }
+
+        pLoop->spawn(ping(pPinger.get(), i, &progress));
+        pLoop->spawn(echo(pEchoer.get(), i, &progress));
+        progress.remaining += 2UL;
+
+        pEndpoints.push_back(std::move(pPinger));
+        pEndpoints.push_back(std::move(pEchoer));
+    }
+
+    // TCP Server & clients
+    const uint16_t serverPort = port++;
+    std::unique_ptr<comm::AsyncTcpServer> pServer = comm::AsyncTcpServer::create(*pLoop, serverPort, config);
+    if (!pServer) {
+        LOGE("Could not create TCP Server which listens at port %u!!!\n", serverPort);
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<comm::AsyncEndpoint>> pAcceptedClients;
+    pLoop->spawn(serve(pLoop.get(), pServer.get(), &pAcceptedClients, &progress));
+    progress.remaining += 1UL + NUMBER_OF_TCP_CLIENTS;  // Acceptor & echo coroutines
+
+    for (size_t i = 0; i < NUMBER_OF_TCP_CLIENTS; i++) {
+        std::unique_ptr<comm::AsyncEndpoint> pClient = comm::AsyncEndpoint::createTcpClient(*pLoop, "127.0.0.1", serverPort, config);
+        if (!pClient) {
+            LOGE("Could not connect TCP client %zu!!!\n", i);
+            return 1;
+        }
+
+        pLoop->spawn(ping(pClient.get(), numberOfPairs + i, &progress));
+        progress.remaining++;
+
+        pEndpoints.push_back(std::move(pClient));
+    }
+
+    bool timedOut = false;
+    pLoop->callAfter(TEST_TIMEOUT_US, [&pLoop, &timedOut]() {
+        timedOut = true;
+        pLoop->stop();
+    });
+
+    const auto t0 = monotonic_now();
+    pLoop->run();
+    const int64_t elapsedUs = get_elapsed_realtime_us(t0);
+
+    const bool result = (!timedOut) && (0UL == progress.failures);
+    LOGI("%zu endpoints, %zu coroutines still running, %zu failed, %lld us.\n", pEndpoints.size() + pAcceptedClients.size(),
+         progress.remaining, progress.failures, static_cast<long long>(elapsedUs));
+    LOGI("-> %s\n", result ? "Passed" : "Failed");
+
+    return result ? 0 : 1;
+}
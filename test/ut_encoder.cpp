@@ -1,8 +1,10 @@
 #include "Encoder.hpp"
 #include "Packet.hpp"
+#include "SlabPool.hpp"
 #include "test_vectors.hpp"
 #include "util.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <deque>
 
@@ -59,13 +61,208 @@ bool test(const std::unique_ptr<uint8_t[]>& pdata, const size_t& size, const siz
     return result;
 }
 
-int main() {
+bool test_stream(const size_t& max_chunk_size) {
+    bool result = true;
+
+    comm::Decoder decoder;
+
+    // Encoding: all test vectors back-to-back, separated by some garbage
+    std::deque<uint8_t> stream;
+    std::unique_ptr<uint8_t[]> pencoded_data;
+    size_t encoded_size = 0ULL;
     for (size_t i = 0; i < vectors.size(); i++) {
         std::unique_ptr<uint8_t[]> pdata(new uint8_t[vectors_sizes[i]]);
         memcpy(pdata.get(), vectors[i], vectors_sizes[i]);
-        LOGI("Test case %02zu:\n", i);
-        LOGI("-> %s\n\n", test(pdata, vectors_sizes[i]) ? "Passed" : "Failed");
+        if (!comm::encode(pdata, vectors_sizes[i], static_cast<uint16_t>(i), pencoded_data, encoded_size)) {
+            return false;
+        }
+
+        stream.insert(stream.end(), pencoded_data.get(), pencoded_data.get() + encoded_size);
+        if (0 == (i & 1)) {
+            stream.push_back(0x00);
+            stream.push_back(0x0F);
+        }
+    }
+
+    // Decoding
+    std::unique_ptr<uint8_t[]> ptmp(new uint8_t[max_chunk_size]);
+    size_t chunk_size;
+    while (!stream.empty()) {
+        chunk_size = (max_chunk_size < stream.size()) ? max_chunk_size : stream.size();
+        for (size_t i = 0; i < chunk_size; i++) {
+            ptmp[i] = stream.front();
+            stream.pop_front();
+        }
+        decoder.feed(ptmp, chunk_size);
+    }
+
+    std::deque<std::unique_ptr<comm::Packet>> pdecoded_packets;
+    decoder.dequeue(pdecoded_packets, false);
+    result &= (vectors.size() == pdecoded_packets.size());
+    for (size_t i = 0; result && (i < pdecoded_packets.size()); i++) {
+        result &= vectors_sizes[i] == pdecoded_packets[i]->getPayloadSize();
+        if (result) {
+            result &= ncompare(pdecoded_packets[i]->getPayload(), vectors[i], vectors_sizes[i]);
+        }
+    }
+
+    LOGI(" -> Decoded %zu/%zu packets\n", pdecoded_packets.size(), vectors.size());
+
+    return result;
+}
+
+bool test_zero_copy() {
+    bool result = true;
+
+    comm::Decoder decoder;
+    std::shared_ptr<dstruct::SlabPool> pPool = dstruct::SlabPool::create(vectors.size() * comm::MAX_FRAME_SIZE);
+    std::shared_ptr<uint8_t> pSlab = pPool->acquire();
+    const uint8_t* const pSlabAddress = pSlab.get();
+
+    // Encoding: all test vectors back-to-back in one slab
+    std::unique_ptr<uint8_t[]> pencoded_data;
+    size_t encoded_size = 0ULL;
+    size_t offset = 0ULL;
+    for (size_t i = 0; i < vectors.size(); i++) {
+        if (!comm::encode(vectors[i], vectors_sizes[i], static_cast<uint16_t>(i), pencoded_data, encoded_size)) {
+            return false;
+        }
+
+        memcpy(pSlab.get() + offset, pencoded_data.get(), encoded_size);
+        offset += encoded_size;
+    }
+
+    // Decoding: the 2nd half is split in 2 chunks, the packet across the boundary has to be copied
+    decoder.feed(pSlab.get(), offset / 2, pSlab);
+    decoder.feed(pSlab.get() + offset / 2, offset - offset / 2, pSlab);
+
+    std::deque<std::unique_ptr<comm::Packet>> pdecoded_packets;
+    decoder.dequeue(pdecoded_packets, false);
+    result &= (vectors.size() == pdecoded_packets.size());
+
+    size_t number_of_views = 0;
+    for (size_t i = 0; result && (i < pdecoded_packets.size()); i++) {
+        result &= vectors_sizes[i] == pdecoded_packets[i]->getPayloadSize();
+        if (result) {
+            result &= ncompare(pdecoded_packets[i]->getPayload(), vectors[i], vectors_sizes[i]);
+        }
+
+        if (pdecoded_packets[i]->isView()) {
+            number_of_views++;
+        }
+    }
+
+    LOGI(" -> Decoded %zu/%zu packets (%zu views)\n", pdecoded_packets.size(), vectors.size(), number_of_views);
+    result &= ((vectors.size() - 1) == number_of_views);
+
+    // The slab must not be recycled as long as a packet refers to it
+    pSlab.reset();
+    pdecoded_packets.pop_front();
+    std::shared_ptr<uint8_t> pOtherSlab = pPool->acquire();
+    result &= (pSlabAddress != pOtherSlab.get());
+
+    pdecoded_packets.clear();
+    pSlab = pPool->acquire();
+    result &= (pSlabAddress == pSlab.get());
+    LOGI(" -> Slab was%s recycled\n", (pSlabAddress == pSlab.get()) ? "" : " not");
+
+    return result;
+}
+
+bool check_packets(const std::deque<std::unique_ptr<comm::Packet>>& pdecoded_packets) {
+    bool result = (vectors.size() == pdecoded_packets.size());
+    for (size_t i = 0; result && (i < pdecoded_packets.size()); i++) {
+        result &= vectors_sizes[i] == pdecoded_packets[i]->getPayloadSize();
+        if (result) {
+            result &= ncompare(pdecoded_packets[i]->getPayload(), vectors[i], vectors_sizes[i]);
+        }
+    }
+
+    return result;
+}
+
+bool test_handlers() {
+    bool result = true;
+
+    // Encoding: all test vectors back-to-back
+    std::deque<uint8_t> stream;
+    std::unique_ptr<uint8_t[]> pencoded_data;
+    size_t encoded_size = 0ULL;
+    for (size_t i = 0; i < vectors.size(); i++) {
+        if (!comm::encode(vectors[i], vectors_sizes[i], static_cast<uint16_t>(i), pencoded_data, encoded_size)) {
+            return false;
+        }
+
+        stream.insert(stream.end(), pencoded_data.get(), pencoded_data.get() + encoded_size);
+    }
+
+    std::unique_ptr<uint8_t[]> pstream(new uint8_t[stream.size()]);
+    std::copy(stream.begin(), stream.end(), pstream.get());
+    const size_t half_size = stream.size() / 2;
+
+    // Packet handler: packets are taken over in order, nothing is queued
+    std::deque<std::unique_ptr<comm::Packet>> phandled_packets;
+    comm::Decoder decoder;
+    decoder.setHandlers([&phandled_packets](std::unique_ptr<comm::Packet>& ppacket) { phandled_packets.push_back(std::move(ppacket)); },
+                        nullptr);
+    decoder.feed(pstream.get(), half_size);
+    decoder.feed(pstream.get() + half_size, stream.size() - half_size);
+
+    std::deque<std::unique_ptr<comm::Packet>> pqueued_packets;
+    result &= check_packets(phandled_packets) && !decoder.dequeue(pqueued_packets, false);
+    LOGI(" -> Packet handler: %zu/%zu packets, %zu queued\n", phandled_packets.size(), vectors.size(), pqueued_packets.size());
+
+    // Batch handler: called once per feed which completed any packet
+    phandled_packets.clear();
+    size_t number_of_batches = 0;
+    comm::Decoder batch_decoder;
+    batch_decoder.setHandlers(nullptr, [&phandled_packets, &number_of_batches](std::deque<std::unique_ptr<comm::Packet>>& ppackets) {
+        number_of_batches++;
+        for (auto& ppacket : ppackets) {
+            phandled_packets.push_back(std::move(ppacket));
+        }
+    });
+    batch_decoder.feed(pstream.get(), half_size);
+    batch_decoder.feed(pstream.get() + half_size, stream.size() - half_size);
+
+    result &= check_packets(phandled_packets) && (2 == number_of_batches) && !batch_decoder.dequeue(pqueued_packets, false);
+    LOGI(" -> Batch handler: %zu/%zu packets in %zu batches, %zu queued\n", phandled_packets.size(), vectors.size(),
+         number_of_batches, pqueued_packets.size());
+
+    return result;
+}
+
+int main() {
+    bool result = true;
+    bool passed;
+
+    const size_t chunk_sizes[] = {1, 2, 3, 5, 7, 8, 9, 128, comm::MAX_FRAME_SIZE};
+
+    for (const size_t& chunk_size : chunk_sizes) {
+        for (size_t i = 0; i < vectors.size(); i++) {
+            std::unique_ptr<uint8_t[]> pdata(new uint8_t[vectors_sizes[i]]);
+            memcpy(pdata.get(), vectors[i], vectors_sizes[i]);
+            LOGI("Test case %02zu (chunk size: %zu):\n", i, chunk_size);
+            passed = test(pdata, vectors_sizes[i], chunk_size);
+            LOGI("-> %s\n\n", passed ? "Passed" : "Failed");
+            result &= passed;
+        }
+
+        LOGI("Test case stream (chunk size: %zu):\n", chunk_size);
+        passed = test_stream(chunk_size);
+        LOGI("-> %s\n\n", passed ? "Passed" : "Failed");
+        result &= passed;
     }
 
-    return 0;
+    LOGI("Test case zero-copy:\n");
+    passed = test_zero_copy();
+    LOGI("-> %s\n\n", passed ? "Passed" : "Failed");
+    result &= passed;
+
+    LOGI("Test case handlers:\n");
+    passed = test_handlers();
+    LOGI("-> %s\n\n", passed ? "Passed" : "Failed");
+    result &= passed;
+
+    return result ? 0 : 1;
 }
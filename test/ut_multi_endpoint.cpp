@@ -0,0 +1,121 @@
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+#include "TcpServer.hpp"
+#include "common.hpp"
+#include "test_vectors.hpp"
+#include "util.hpp"
+
+#include <cstring>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+static constexpr long COLLECT_TIMEOUT_MS = 10000L;
+
+static void send_vectors(const std::unique_ptr<comm::P2P_Endpoint>& pEndpoint) {
+    for (size_t i = 0; i < vectors.size(); i++) {
+        pEndpoint->send(comm::Packet::create(vectors[i], vectors_sizes[i]));
+    }
+}
+
+static bool collect_and_check(const std::unique_ptr<comm::P2P_Endpoint>& pEndpoint) {
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+    const auto deadline = monotonic_now() + std::chrono::milliseconds(COLLECT_TIMEOUT_MS);
+    while ((vectors.size() > pPackets.size()) && (deadline > monotonic_now())) {
+        pEndpoint->recvAll(pPackets);
+    }
+
+    return test(pPackets);
+}
+
+int main(int argc, char** argv) {
+    if (2 > argc) {
+        LOGE("Usage: %s <Local Port> [Number of Endpoints] [Zero-copy Rx (0|1)] [SPSC Queues (0|1)] [Reactor Threads (0: dedicated threads)] [io_uring (0|1)] [Direct Send (0|1)]\n", argv[0]);
+        return 1;
+    }
+
+    const uint16_t port = static_cast<uint16_t>(atoi(argv[1]));
+    const size_t numberOfEndpoints = (2 < argc) ? static_cast<size_t>(atoi(argv[2])) : 16UL;
+
+    comm::EndpointConfig config;
+    config.zeroCopyRx = (3 < argc) && (0 != atoi(argv[3]));
+    if ((4 < argc) && (0 != atoi(argv[4]))) {
+        config.txQueueType = dstruct::E_SPSC_QUEUE;
+        config.rxQueueType = dstruct::E_SPSC_QUEUE;
+    }
+
+    if ((5 < argc) && (0 < atoi(argv[5]))) {
+        config.pReactor = comm::Reactor::create(static_cast<size_t>(atoi(argv[5])));
+    }
+
+    if ((6 < argc) && (0 != atoi(argv[6]))) {
+        config.ioBackend = comm::E_IO_URING;
+    }
+
+    config.directSend = (7 < argc) && (0 != atoi(argv[7]));
+
+    std::unique_ptr<comm::TcpServer> pTcpServer = comm::TcpServer::create(port, config);
+    if (!pTcpServer) {
+        LOGE("Could not create TCP Server which listens at port %u!!!\n", port);
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pClients;
+    std::thread connector([&pClients, &port, &numberOfEndpoints, &config]() {
+        for (size_t i = 0; i < numberOfEndpoints; i++) {
+            pClients.push_back(comm::IP_Endpoint::createTcpClient("127.0.0.1", port, config));
+        }
+    });
+
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pServerEndpoints;
+    int errorCode = 0;
+    for (size_t i = 0; i < numberOfEndpoints; i++) {
+        std::unique_ptr<comm::P2P_Endpoint> pEndpoint = pTcpServer->waitForClient(errorCode, 5000);
+        if (!pEndpoint) {
+            LOGE("Failed to accept client %zu: %d!!!\n", i, errorCode);
+            break;
+        }
+        pServerEndpoints.push_back(std::move(pEndpoint));
+    }
+
+    connector.join();
+
+    bool result = (numberOfEndpoints == pServerEndpoints.size());
+    for (auto& pClient : pClients) {
+        result &= (nullptr != pClient);
+    }
+
+    if (!result) {
+        LOGE("Could not establish %zu connections!!!\n", numberOfEndpoints);
+        return 1;
+    }
+
+    LOGI("Established %zu connections.\n", numberOfEndpoints);
+
+    // All endpoints transmit & decode concurrently in both directions
+    for (size_t i = 0; i < numberOfEndpoints; i++) {
+        send_vectors(pClients[i]);
+        send_vectors(pServerEndpoints[i]);
+    }
+
+    for (size_t i = 0; i < numberOfEndpoints; i++) {
+        result &= collect_and_check(pServerEndpoints[i]);
+        result &= collect_and_check(pClients[i]);
+    }
+
+    const comm::TxStats txStats = pClients[0]->getTxStats();
+    LOGI("Client 0 wrote %llu packets (%llu bytes) in %llu batches.\n",
+         static_cast<unsigned long long>(txStats.packets),
+         static_cast<unsigned long long>(txStats.bytes),
+         static_cast<unsigned long long>(txStats.batches));
+
+    const comm::IoStats ioStats = pClients[0]->getIoStats();
+    LOGI("Client 0 (backend: %d) issued %llu Rx & %llu Tx system calls.\n", pClients[0]->getIoBackend(),
+         static_cast<unsigned long long>(ioStats.rxSyscalls),
+         static_cast<unsigned long long>(ioStats.txSyscalls));
+
+    LOGI("-> %s\n", result ? "Passed" : "Failed");
+
+    return result ? 0 : 1;
+}
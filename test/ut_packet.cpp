@@ -0,0 +1,179 @@
+#include "Packet.hpp"
+#include "PacketPool.hpp"
+#include "common.hpp"
+#include "test_vectors.hpp"
+#include "util.hpp"
+
+#include <cstring>
+#include <deque>
+#include <thread>
+
+static constexpr size_t NUMBER_OF_PACKETS = 1000UL;
+
+bool test_content() {
+    bool result = true;
+
+    for (size_t i = 0; i < vectors.size(); i++) {
+        std::unique_ptr<comm::Packet> pPacket = comm::Packet::create(vectors[i], vectors_sizes[i]);
+        result &= (nullptr != pPacket) && (vectors_sizes[i] == pPacket->getPayloadSize());
+        if (result) {
+            result &= ncompare(pPacket->getPayload(), vectors[i], vectors_sizes[i]);
+        }
+
+        // Move
+        comm::Packet packet(std::move(*pPacket));
+        result &= (nullptr == pPacket->getPayload()) && (0 == pPacket->getPayloadSize());
+        result &= ncompare(packet.getPayload(), vectors[i], vectors_sizes[i]);
+    }
+
+    // Oversized payloads must be rejected
+    std::unique_ptr<uint8_t[]> pData(new uint8_t[comm::MAX_PAYLOAD_SIZE + 1]);
+    result &= (nullptr == comm::Packet::create(pData, comm::MAX_PAYLOAD_SIZE + 1));
+
+    return result;
+}
+
+bool test_small_payloads() {
+    bool result = true;
+
+    const size_t sizes[] = {0UL, 1UL, 6UL, comm::Packet::SMALL_PAYLOAD_SIZE - 1, comm::Packet::SMALL_PAYLOAD_SIZE, comm::Packet::SMALL_PAYLOAD_SIZE + 1};
+    for (const size_t& size : sizes) {
+        const comm::PoolStats stats0 = comm::PacketPool::getStats();
+        std::unique_ptr<comm::Packet> pPacket = comm::Packet::create(vectors[0], size);
+        const comm::PoolStats stats1 = comm::PacketPool::getStats();
+
+        // Small payloads are stored inline: a single allocation (the packet itself)
+        const uint64_t allocations = (stats1.hits + stats1.misses) - (stats0.hits + stats0.misses);
+        result &= (((comm::Packet::SMALL_PAYLOAD_SIZE >= size) ? 1ULL : 2ULL) == allocations);
+        result &= (nullptr != pPacket) && (size == pPacket->getPayloadSize()) && ncompare(pPacket->getPayload(), vectors[0], size);
+
+        // Move construction & assignment must keep the payload
+        comm::Packet packet(std::move(*pPacket));
+        pPacket.reset();
+        result &= (size == packet.getPayloadSize()) && ncompare(packet.getPayload(), vectors[0], size);
+
+        std::unique_ptr<comm::Packet> pOther = comm::Packet::create(vectors[1], vectors_sizes[1]);
+        *pOther = std::move(packet);
+        result &= (size == pOther->getPayloadSize()) && ncompare(pOther->getPayload(), vectors[0], size);
+
+        LOGI(" -> %zu bytes: %llu allocation(s)\n", size, static_cast<unsigned long long>(allocations));
+    }
+
+    return result;
+}
+
+bool test_adoption() {
+    bool result = true;
+
+    for (size_t i = 0; i < vectors.size(); i++) {
+        // Heap buffer
+        std::unique_ptr<uint8_t[]> pData(new uint8_t[vectors_sizes[i]]);
+        memcpy(pData.get(), vectors[i], vectors_sizes[i]);
+        const uint8_t* const pRaw = pData.get();
+
+        std::unique_ptr<comm::Packet> pPacket = comm::Packet::create(std::move(pData), vectors_sizes[i]);
+        result &= (nullptr != pPacket) && (nullptr == pData) && (pRaw == pPacket->getPayload());
+        result &= ncompare(pPacket->getPayload(), vectors[i], vectors_sizes[i]);
+
+        // Pooled buffer
+        comm::PooledBuffer pBuffer = comm::PacketPool::allocateBuffer(vectors_sizes[i]);
+        memcpy(pBuffer.get(), vectors[i], vectors_sizes[i]);
+        const uint8_t* const pPooled = pBuffer.get();
+
+        pPacket = comm::Packet::create(std::move(pBuffer), vectors_sizes[i]);
+        result &= (nullptr != pPacket) && (nullptr == pBuffer) && (pPooled == pPacket->getPayload());
+
+        // Move must keep the adopted payload
+        comm::Packet packet(std::move(*pPacket));
+        pPacket.reset();
+        result &= (pPooled == packet.getPayload()) && ncompare(packet.getPayload(), vectors[i], vectors_sizes[i]);
+    }
+
+    // Payload larger than the buffer must be rejected (buffer is kept by the caller)
+    comm::PooledBuffer pBuffer = comm::PacketPool::allocateBuffer(16UL);
+    result &= (nullptr == comm::Packet::create(std::move(pBuffer), 17UL)) && (nullptr != pBuffer);
+
+    return result;
+}
+
+bool test_recycling() {
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+
+    // Warm up
+    for (size_t i = 0; i < NUMBER_OF_PACKETS; i++) {
+        pPackets.push_back(comm::Packet::create(vectors[i % vectors.size()], vectors_sizes[i % vectors.size()]));
+    }
+    pPackets.clear();
+
+    const comm::PoolStats stats0 = comm::PacketPool::getStats();
+    for (size_t i = 0; i < NUMBER_OF_PACKETS; i++) {
+        pPackets.push_back(comm::Packet::create(vectors[i % vectors.size()], vectors_sizes[i % vectors.size()]));
+    }
+    pPackets.clear();
+    const comm::PoolStats stats1 = comm::PacketPool::getStats();
+
+    LOGI(" -> Hits: %llu, misses: %llu\n",
+         static_cast<unsigned long long>(stats1.hits - stats0.hits),
+         static_cast<unsigned long long>(stats1.misses - stats0.misses));
+
+    // Packets & payloads must be served by recycled blocks
+    return ((2 * NUMBER_OF_PACKETS) == (stats1.hits - stats0.hits)) && (stats1.misses == stats0.misses);
+}
+
+bool test_cross_thread() {
+    bool result = true;
+
+    // Packets are created by a producer thread & destroyed by the consumer (e.g. Rx thread -> application)
+    for (int round = 0; round < 10; round++) {
+        std::deque<std::unique_ptr<comm::Packet>> pPackets;
+        std::thread producer([&pPackets]() {
+            for (size_t i = 0; i < NUMBER_OF_PACKETS; i++) {
+                pPackets.push_back(comm::Packet::create(vectors[i % vectors.size()], vectors_sizes[i % vectors.size()]));
+            }
+        });
+        producer.join();
+
+        for (size_t i = 0; i < pPackets.size(); i++) {
+            result &= ncompare(pPackets[i]->getPayload(), vectors[i % vectors.size()], vectors_sizes[i % vectors.size()]);
+        }
+    }
+
+    const comm::PoolStats stats = comm::PacketPool::getStats();
+    LOGI(" -> Hits: %llu, misses: %llu\n",
+         static_cast<unsigned long long>(stats.hits),
+         static_cast<unsigned long long>(stats.misses));
+
+    return result;
+}
+
+int main() {
+    bool result = true;
+    bool passed;
+
+    LOGI("Test case content:\n");
+    passed = test_content();
+    LOGI("-> %s\n\n", passed ? "Passed" : "Failed");
+    result &= passed;
+
+    LOGI("Test case small payloads:\n");
+    passed = test_small_payloads();
+    LOGI("-> %s\n\n", passed ? "Passed" : "Failed");
+    result &= passed;
+
+    LOGI("Test case adoption:\n");
+    passed = test_adoption();
+    LOGI("-> %s\n\n", passed ? "Passed" : "Failed");
+    result &= passed;
+
+    LOGI("Test case recycling:\n");
+    passed = test_recycling();
+    LOGI("-> %s\n\n", passed ? "Passed" : "Failed");
+    result &= passed;
+
+    LOGI("Test case cross-thread:\n");
+    passed = test_cross_thread();
+    LOGI("-> %s\n\n", passed ? "Passed" : "Failed");
+    result &= passed;
+
+    return result ? 0 : 1;
+}
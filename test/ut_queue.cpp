@@ -0,0 +1,128 @@
+#include "Queue.hpp"
+#include "SpscQueue.hpp"
+#include "SyncQueue.hpp"
+#include "common.hpp"
+
+#include <deque>
+#include <memory>
+#include <thread>
+
+static constexpr size_t CAP_LIMIT = 100UL;
+static constexpr size_t NUMBER_OF_ITEMS = 200000UL;
+
+bool test_order_and_limit(const dstruct::QUEUE_TYPE& type) {
+    bool result = true;
+    std::unique_ptr<dstruct::Queue<size_t>> pQueue = dstruct::Queue<size_t>::create(type, 10, CAP_LIMIT);
+
+    for (int round = 0; round < 3; round++) {
+        for (size_t i = 0; i < CAP_LIMIT; i++) {
+            result &= pQueue->enqueue(std::unique_ptr<size_t>(new size_t(i)));
+        }
+
+        // Full: the item must be kept by the caller
+        std::unique_ptr<size_t> pItem(new size_t(CAP_LIMIT));
+        result &= !pQueue->enqueue(pItem) && (nullptr != pItem);
+
+        std::deque<std::unique_ptr<size_t>> items;
+        result &= pQueue->dequeue(items, false) && (CAP_LIMIT == items.size());
+        for (size_t i = 0; (i < items.size()) && result; i++) {
+            result &= (i == *items[i]);
+        }
+
+        // Empty
+        items.clear();
+        const auto t0 = monotonic_now();
+        result &= !pQueue->dequeue(items, false) && !pQueue->dequeue(items, true) && items.empty();
+        result &= (5000L <= get_elapsed_realtime_us(t0));  // Waited for the timeout
+    }
+
+    return result;
+}
+
+bool test_producer_consumer(const dstruct::QUEUE_TYPE& type) {
+    bool result = true;
+    std::unique_ptr<dstruct::Queue<size_t>> pQueue = dstruct::Queue<size_t>::create(type, 10, CAP_LIMIT);
+
+    std::thread producer([&pQueue]() {
+        for (size_t i = 0; i < NUMBER_OF_ITEMS;) {
+            std::unique_ptr<size_t> pItem(new size_t(i));
+            if (pQueue->enqueue(pItem)) {
+                i++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t expected = 0UL;
+    std::deque<std::unique_ptr<size_t>> items;
+    const auto t0 = monotonic_now();
+    while ((NUMBER_OF_ITEMS > expected) && (10000000L > get_elapsed_realtime_us(t0))) {
+        pQueue->dequeue(items);
+        while (!items.empty()) {
+            result &= (expected == *items.front());
+            items.pop_front();
+            expected++;
+        }
+    }
+
+    producer.join();
+
+    LOGI(" -> %zu items\n", expected);
+    return result && (NUMBER_OF_ITEMS == expected);
+}
+
+bool test_shutdown(const dstruct::QUEUE_TYPE& type) {
+    bool result = true;
+    std::unique_ptr<dstruct::Queue<size_t>> pQueue = dstruct::Queue<size_t>::create(type, 1000, CAP_LIMIT);
+
+    // A consumer waiting on an empty queue is released at once, & does not wait afterwards
+    int64_t waitUs = 0;
+    std::thread consumer([&pQueue, &waitUs]() {
+        std::deque<std::unique_ptr<size_t>> items;
+        const auto t0 = monotonic_now();
+        pQueue->dequeue(items, true);
+        pQueue->dequeue(items, true);
+        waitUs = get_elapsed_realtime_us(t0);
+    });
+
+    sleep_for(10000L);
+    pQueue->shutdown();
+    consumer.join();
+    result &= (500000L > waitUs);
+
+    // Queued items are still delivered
+    std::deque<std::unique_ptr<size_t>> items;
+    result &= pQueue->enqueue(std::unique_ptr<size_t>(new size_t(1UL)));
+    result &= pQueue->dequeue(items, true) && (1UL == items.size());
+
+    LOGI(" -> waited %lld us\n", static_cast<long long>(waitUs));
+    return result;
+}
+
+int main() {
+    bool result = true;
+    bool passed;
+
+    const dstruct::QUEUE_TYPE types[] = {dstruct::E_SYNC_QUEUE, dstruct::E_SPSC_QUEUE};
+    const char* const names[] = {"SyncQueue", "SpscQueue"};
+
+    for (size_t i = 0; i < 2; i++) {
+        LOGI("Test case order & limit (%s):\n", names[i]);
+        passed = test_order_and_limit(types[i]);
+        LOGI("-> %s\n\n", passed ? "Passed" : "Failed");
+        result &= passed;
+
+        LOGI("Test case producer & consumer (%s):\n", names[i]);
+        passed = test_producer_consumer(types[i]);
+        LOGI("-> %s\n\n", passed ? "Passed" : "Failed");
+        result &= passed;
+
+        LOGI("Test case shutdown (%s):\n", names[i]);
+        passed = test_shutdown(types[i]);
+        LOGI("-> %s\n\n", passed ? "Passed" : "Failed");
+        result &= passed;
+    }
+
+    return result ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+#include "Reactor.hpp"
+#include "ShardedTcpServer.hpp"
+#include "common.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Clients connect to an echo server sharded with SO_REUSEPORT: every client must get its packets back in order,
+// connections must be spread over several shards, broadcasts must reach every client (Transaction IDs of each client
+// go on after its echoes), and shards must clean up clients once they disconnect.
+
+static constexpr size_t NUMBER_OF_SHARDS = 4UL;
+static constexpr size_t NUMBER_OF_CLIENTS = 32UL;
+static constexpr size_t NUMBER_OF_ROUNDS = 20UL;
+static constexpr size_t PAYLOAD_SIZE = 16UL;
+static constexpr size_t BROADCAST_PAYLOAD_SIZE = 512UL;  // Shared by all clients (larger than `Packet::SMALL_PAYLOAD_SIZE`)
+static constexpr long TIMEOUT_US = 5000000L;  // 5s
+
+static void fill_payload(uint8_t* const pPayload, const size_t& index, const size_t& round, const size_t& size = PAYLOAD_SIZE) {
+    for (size_t i = 0; i < size; i++) {
+        pPayload[i] = static_cast<uint8_t>(index + round + i);
+    }
+}
+
+static bool check_echoes(const size_t& index, comm::P2P_Endpoint* const pClient) {
+    uint8_t payload[PAYLOAD_SIZE];
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+    const auto t0 = monotonic_now();
+    while ((NUMBER_OF_ROUNDS > pPackets.size()) && (TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+        pClient->recvAll(pPackets, false);
+        sleep_for(1000L);
+    }
+
+    if (NUMBER_OF_ROUNDS != pPackets.size()) {
+        LOGE("[%zu] %zu/%zu echoes received!!!\n", index, pPackets.size(), NUMBER_OF_ROUNDS);
+        return false;
+    }
+
+    for (size_t round = 0; round < NUMBER_OF_ROUNDS; round++) {
+        fill_payload(payload, index, round);
+        if ((PAYLOAD_SIZE != pPackets[round]->getPayloadSize()) || (0 != memcmp(payload, pPackets[round]->getPayload(), PAYLOAD_SIZE))) {
+            LOGE("[%zu] Echo %zu is corrupted!!!\n", index, round);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool check_broadcasts(const size_t& index, comm::P2P_Endpoint* const pClient) {
+    uint8_t payload[BROADCAST_PAYLOAD_SIZE];
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+    const auto t0 = monotonic_now();
+    while ((2UL > pPackets.size()) && (TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+        pClient->recvAll(pPackets, false);
+        sleep_for(1000L);
+    }
+
+    if (2UL != pPackets.size()) {
+        LOGE("[%zu] %zu/2 broadcasts received!!!\n", index, pPackets.size());
+        return false;
+    }
+
+    fill_payload(payload, 0UL, 0UL, BROADCAST_PAYLOAD_SIZE);
+    if ((BROADCAST_PAYLOAD_SIZE != pPackets[0]->getPayloadSize()) || (0 != memcmp(payload, pPackets[0]->getPayload(), BROADCAST_PAYLOAD_SIZE)) ||
+        (PAYLOAD_SIZE != pPackets[1]->getPayloadSize()) || (0 != memcmp(payload, pPackets[1]->getPayload(), PAYLOAD_SIZE))) {
+        LOGE("[%zu] Broadcasts are corrupted!!!\n", index);
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (2 > argc) {
+        LOGE("Usage: %s <Local Port>\n", argv[0]);
+        return 1;
+    }
+
+    const uint16_t port = static_cast<uint16_t>(atoi(argv[1]));
+
+    std::unique_ptr<comm::ShardedTcpServer> pServer = comm::ShardedTcpServer::create(
+        port, NUMBER_OF_SHARDS, [](comm::P2P_Endpoint& client, std::unique_ptr<comm::Packet>& pPacket) { client.send(pPacket); });
+    if (!pServer) {
+        LOGE("Could not create sharded TCP Server which listens at port %u!!!\n", port);
+        return 1;
+    }
+
+    comm::EndpointConfig config;
+    config.pReactor = comm::Reactor::create(1UL);
+
+    std::vector<std::unique_ptr<comm::P2P_Endpoint>> pClients;
+    for (size_t i = 0; i < NUMBER_OF_CLIENTS; i++) {
+        std::unique_ptr<comm::P2P_Endpoint> pClient = comm::IP_Endpoint::createTcpClient("127.0.0.1", port, config);
+        if (!pClient) {
+            LOGE("Could not connect client %zu!!!\n", i);
+            return 1;
+        }
+        pClients.push_back(std::move(pClient));
+    }
+
+    uint8_t payload[PAYLOAD_SIZE];
+    for (size_t round = 0; round < NUMBER_OF_ROUNDS; round++) {
+        for (size_t i = 0; i < NUMBER_OF_CLIENTS; i++) {
+            fill_payload(payload, i, round);
+            pClients[i]->send(comm::Packet::create(payload, sizeof(payload)));
+        }
+    }
+
+    bool result = true;
+    for (size_t i = 0; i < NUMBER_OF_CLIENTS; i++) {
+        result &= check_echoes(i, pClients[i].get());
+    }
+
+    // Large & small payloads
+    uint8_t broadcastPayload[BROADCAST_PAYLOAD_SIZE];
+    fill_payload(broadcastPayload, 0UL, 0UL, BROADCAST_PAYLOAD_SIZE);
+    const size_t largeCount = pServer->broadcast(comm::Packet::create(broadcastPayload, BROADCAST_PAYLOAD_SIZE));
+    const size_t smallCount = pServer->broadcast(comm::Packet::create(broadcastPayload, PAYLOAD_SIZE));
+    if ((NUMBER_OF_CLIENTS != largeCount) || (NUMBER_OF_CLIENTS != smallCount)) {
+        LOGE("Broadcasts were taken by %zu & %zu clients!!!\n", largeCount, smallCount);
+        result = false;
+    }
+
+    for (size_t i = 0; i < NUMBER_OF_CLIENTS; i++) {
+        result &= check_broadcasts(i, pClients[i].get());
+    }
+
+    size_t busyShards = 0UL;
+    for (size_t i = 0; i < pServer->getNumberOfShards(); i++) {
+        const size_t count = pServer->getNumberOfClients(i);
+        LOGI("Shard %zu: %zu clients\n", i, count);
+        if (0UL < count) {
+            busyShards++;
+        }
+    }
+
+    if ((NUMBER_OF_CLIENTS != pServer->getNumberOfClients()) || (2UL > busyShards)) {
+        LOGE("%zu clients on %zu shards!!!\n", pServer->getNumberOfClients(), busyShards);
+        result = false;
+    }
+
+    // Disconnected clients are destroyed by their shards
+    pClients.clear();
+    const auto t0 = monotonic_now();
+    while ((0UL < pServer->getNumberOfClients()) && (TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+        sleep_for(10000L);
+    }
+
+    if (0UL < pServer->getNumberOfClients()) {
+        LOGE("%zu clients are still owned by shards!!!\n", pServer->getNumberOfClients());
+        result = false;
+    }
+
+    LOGI("-> %s\n", result ? "Passed" : "Failed");
+
+    return result ? 0 : 1;
+}
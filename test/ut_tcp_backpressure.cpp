@@ -0,0 +1,209 @@
+#include "Encoder.hpp"
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+#include "Reactor.hpp"
+#include "common.hpp"
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// A TcpClient writes much more than socket buffers can hold while the server (a raw socket) does not read:
+// short writes must neither drop nor reorder bytes. The server then decodes the whole stream.
+// Then the client is destroyed while the server still does not read: it must not hang in the Tx path.
+
+static constexpr size_t NUMBER_OF_PACKETS = 4000UL;
+static constexpr size_t PAYLOAD_SIZE = 1000UL;
+static constexpr int SERVER_BUFFER_SIZE = 4096;
+static constexpr long STALL_US = 500000L;          // 500ms
+static constexpr long TEST_TIMEOUT_US = 30000000L;  // 30s
+static constexpr long TEARDOWN_LIMIT_US = 2000000L;  // 2s
+
+static void fill_payload(uint8_t* const pPayload, const size_t& index) {
+    for (size_t i = 0; i < PAYLOAD_SIZE; i++) {
+        pPayload[i] = static_cast<uint8_t>(index + i);
+    }
+}
+
+static SOCKET create_listener(const uint16_t& port) {
+    SOCKET socketFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (0 > socketFd) {
+        return -1;
+    }
+
+    // Inherited by accepted sockets: the client is throttled early
+    int enable = 1;
+    int bufferSize = SERVER_BUFFER_SIZE;
+    setsockopt(socketFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    setsockopt(socketFd, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if ((0 > bind(socketFd, (const struct sockaddr*)(&address), sizeof(address))) || (0 > listen(socketFd, 1))) {
+        ::close(socketFd);
+        return -1;
+    }
+
+    return socketFd;
+}
+
+bool test_backpressure(const uint16_t& port, const comm::EndpointConfig& config) {
+    SOCKET listenerFd = create_listener(port);
+    if (0 > listenerFd) {
+        LOGE("Could not listen at port %u!!!\n", port);
+        return false;
+    }
+
+    std::unique_ptr<comm::P2P_Endpoint> pClient = comm::IP_Endpoint::createTcpClient("127.0.0.1", port, config);
+    SOCKET serverFd = accept(listenerFd, NULL, NULL);
+    ::close(listenerFd);
+    if ((!pClient) || (0 > serverFd)) {
+        LOGE("Could not establish connection!!!\n");
+        if (0 <= serverFd) {
+            ::close(serverFd);
+        }
+        return false;
+    }
+
+    // Nothing is read from the server socket until all packets have been taken by the client (or a stall period)
+    uint8_t payload[PAYLOAD_SIZE];
+    size_t sent = 0UL;
+    const auto t0 = monotonic_now();
+    while ((NUMBER_OF_PACKETS > sent) && (STALL_US > get_elapsed_realtime_us(t0))) {
+        fill_payload(payload, sent);
+        std::unique_ptr<comm::Packet> pPacket = comm::Packet::create(payload, sizeof(payload));
+        if (pClient->send(pPacket)) {
+            sent++;
+        } else {
+            // Tx queue is full
+            sleep_for(1000L);
+        }
+    }
+
+    bool result = true;
+    comm::Decoder decoder;
+    std::deque<std::unique_ptr<comm::Packet>> pPackets;
+    std::unique_ptr<uint8_t[]> pBuffer(new uint8_t[65536]);
+    size_t received = 0UL;
+    while (result && (NUMBER_OF_PACKETS > received) && (TEST_TIMEOUT_US > get_elapsed_realtime_us(t0))) {
+        // Keep sending remaining packets while reading
+        while (NUMBER_OF_PACKETS > sent) {
+            fill_payload(payload, sent);
+            std::unique_ptr<comm::Packet> pPacket = comm::Packet::create(payload, sizeof(payload));
+            if (!pClient->send(pPacket)) {
+                break;
+            }
+            sent++;
+        }
+
+        struct pollfd pollFd = {serverFd, POLLIN, 0};
+        if (0 >= poll(&pollFd, 1, 100)) {
+            continue;
+        }
+
+        const ssize_t byteCount = recv(serverFd, pBuffer.get(), 65536, 0);
+        if (0 >= byteCount) {
+            LOGE("Connection was closed!!!\n");
+            result = false;
+            break;
+        }
+
+        decoder.feed(pBuffer.get(), byteCount);
+        decoder.dequeue(pPackets, false);
+        for (auto& pPacket : pPackets) {
+            fill_payload(payload, received);
+            if ((PAYLOAD_SIZE != pPacket->getPayloadSize()) || (0 != memcmp(payload, pPacket->getPayload(), PAYLOAD_SIZE))) {
+                LOGE("Packet %zu was corrupted!!!\n", received);
+                result = false;
+                break;
+            }
+            received++;
+        }
+        pPackets.clear();
+    }
+
+    ::close(serverFd);
+
+    const comm::TxStats txStats = pClient->getTxStats();
+    const comm::IoStats ioStats = pClient->getIoStats();
+    LOGI("Received %zu/%zu packets, client wrote %llu batches with %llu system calls.\n", received, NUMBER_OF_PACKETS,
+         static_cast<unsigned long long>(txStats.batches), static_cast<unsigned long long>(ioStats.txSyscalls));
+
+    return result && (NUMBER_OF_PACKETS == received);
+}
+
+bool test_teardown(const uint16_t& port, const comm::EndpointConfig& config) {
+    SOCKET listenerFd = create_listener(port);
+    if (0 > listenerFd) {
+        LOGE("Could not listen at port %u!!!\n", port);
+        return false;
+    }
+
+    std::unique_ptr<comm::P2P_Endpoint> pClient = comm::IP_Endpoint::createTcpClient("127.0.0.1", port, config);
+    SOCKET serverFd = accept(listenerFd, NULL, NULL);
+    ::close(listenerFd);
+    if ((!pClient) || (0 > serverFd)) {
+        LOGE("Could not establish connection!!!\n");
+        if (0 <= serverFd) {
+            ::close(serverFd);
+        }
+        return false;
+    }
+
+    uint8_t payload[PAYLOAD_SIZE];
+    const auto t0 = monotonic_now();
+    for (size_t i = 0; (i < NUMBER_OF_PACKETS) && (STALL_US > get_elapsed_realtime_us(t0)); i++) {
+        fill_payload(payload, i);
+        std::unique_ptr<comm::Packet> pPacket = comm::Packet::create(payload, sizeof(payload));
+        if (!pClient->send(pPacket)) {
+            sleep_for(1000L);
+        }
+    }
+
+    const auto t1 = monotonic_now();
+    pClient.reset();
+    const long teardownUs = get_elapsed_realtime_us(t1);
+    ::close(serverFd);
+
+    LOGI("Client was destroyed in %ld us.\n", teardownUs);
+
+    return TEARDOWN_LIMIT_US > teardownUs;
+}
+
+int main(int argc, char** argv) {
+    if (2 > argc) {
+        LOGE("Usage: %s <Local Port>\n", argv[0]);
+        return 1;
+    }
+
+    const uint16_t port = static_cast<uint16_t>(atoi(argv[1]));
+
+    comm::EndpointConfig config;
+    bool result = test_backpressure(port, config) && test_teardown(static_cast<uint16_t>(port + 1), config);
+    LOGI("Dedicated threads -> %s\n", result ? "Passed" : "Failed");
+
+    config.ioBackend = comm::E_IO_URING;
+    const bool uringResult = test_backpressure(static_cast<uint16_t>(port + 2), config) &&
+                             test_teardown(static_cast<uint16_t>(port + 3), config);
+    LOGI("io_uring -> %s\n", uringResult ? "Passed" : "Failed");
+
+    config.ioBackend = comm::E_IO_SOCKET;
+    config.pReactor = comm::Reactor::create(1UL);
+    const bool reactorResult = test_backpressure(static_cast<uint16_t>(port + 4), config) &&
+                               test_teardown(static_cast<uint16_t>(port + 5), config);
+    LOGI("Reactor -> %s\n", reactorResult ? "Passed" : "Failed");
+
+    result &= uringResult;
+    result &= reactorResult;
+    LOGI("-> %s\n", result ? "Passed" : "Failed");
+
+    return result ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+#include "IP_Endpoint.hpp"
+#include "Packet.hpp"
+#include "Thread.hpp"
+#include "common.hpp"
+
+#include <cstring>
+#include <deque>
+#include <memory>
+
+// Rx & Tx threads of a UdpPeer are started with names, affinity, stack size & SCHED_FIFO priority:
+// effective settings must match (SCHED_FIFO is only checked if permitted) & packets must still flow.
+
+static constexpr size_t STACK_SIZE = 256UL * 1024UL;  // 256KB
+static constexpr int FIFO_PRIORITY = 10;
+
+static bool check(const char* pLabel, const comm::ThreadConfig& expected, const comm::ThreadConfig& actual) {
+    LOGI("%s: name `%s`, %zu CPU(s) (first: %d), SCHED_FIFO priority %d, stack size %zu\n", pLabel, actual.name.c_str(),
+         actual.cpus.size(), actual.cpus.empty() ? -1 : actual.cpus[0], actual.fifoPriority, actual.stackSize);
+
+    bool result = (expected.name == actual.name) && (expected.cpus == actual.cpus) && (expected.stackSize <= actual.stackSize);
+    if (0 == expected.fifoPriority) {
+        result &= (0 == actual.fifoPriority);
+    } else if (0 == actual.fifoPriority) {
+        LOGW("SCHED_FIFO was not applied (not permitted?)!\n");
+    } else {
+        result &= (expected.fifoPriority == actual.fifoPriority);
+    }
+
+    return result;
+}
+
+int main(int argc, char** argv) {
+    if (2 > argc) {
+        LOGE("Usage: %s <Local Port>\n", argv[0]);
+        return 1;
+    }
+
+    const uint16_t port = static_cast<uint16_t>(atoi(argv[1]));
+
+    comm::EndpointConfig config;
+    config.rxThread.name = "comm-rx";
+    config.rxThread.cpus.push_back(0);
+    config.rxThread.fifoPriority = FIFO_PRIORITY;
+    config.rxThread.stackSize = STACK_SIZE;
+    config.txThread.name = "comm-tx-with-a-long-name";  // Truncated
+    config.txThread.cpus.push_back(0);
+    config.txThread.stackSize = STACK_SIZE;
+
+    std::unique_ptr<comm::P2P_Endpoint> pPeerA = comm::IP_Endpoint::createUdpPeer(port, "127.0.0.1", static_cast<uint16_t>(port + 1), config);
+    std::unique_ptr<comm::P2P_Endpoint> pPeerB = comm::IP_Endpoint::createUdpPeer(static_cast<uint16_t>(port + 1), "127.0.0.1", port);
+    if ((!pPeerA) || (!pPeerB)) {
+        LOGE("Could not create UdpPeers!!!\n");
+        return 1;
+    }
+
+    sleep_for(100000L);
+
+    comm::ThreadConfig expectedTx = config.txThread;
+    expectedTx.name = expectedTx.name.substr(0, comm::MAX_THREAD_NAME_LENGTH);
+
+    bool result = check("Rx thread", config.rxThread, pPeerA->getRxThreadSettings());
+    result &= check("Tx thread", expectedTx, pPeerA->getTxThreadSettings());
+
+    // Both directions still work
+    const uint8_t payload[] = {0x01, 0x02, 0x03, 0x04};
+    pPeerA->send(comm::Packet::create(payload, sizeof(payload)));
+    pPeerB->send(comm::Packet::create(payload, sizeof(payload)));
+
+    std::deque<std::unique_ptr<comm::Packet>> pPacketsA;
+    std::deque<std::unique_ptr<comm::Packet>> pPacketsB;
+    const auto t0 = monotonic_now();
+    while ((pPacketsA.empty() || pPacketsB.empty()) && (1000000L > get_elapsed_realtime_us(t0))) {
+        pPeerA->recvAll(pPacketsA, false);
+        pPeerB->recvAll(pPacketsB, false);
+        sleep_for(1000L);
+    }
+
+    if (pPacketsA.empty() || pPacketsB.empty()) {
+        LOGE("Packets were lost!!!\n");
+        result = false;
+    }
+
+    LOGI("-> %s\n", result ? "Passed" : "Failed");
+
+    return result ? 0 : 1;
+}
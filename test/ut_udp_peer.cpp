@@ -11,12 +11,18 @@
 
 int main(int argc, char** argv) {
     if (4 > argc) {
-        LOGE("Usage: %s <Local Port> <Peer Address> <Peer Port>\n", argv[0]);
+        LOGE("Usage: %s <Local Port> <Peer Address> <Peer Port> [UDP Batch Size] [UDP Segmentation Offload (0|1)]\n", argv[0]);
         return 1;
     }
 
+    comm::EndpointConfig config;
+    if (4 < argc) {
+        config.udpBatchSize = static_cast<size_t>(atoi(argv[4]));
+    }
+    config.udpSegmentOffload = (5 < argc) && (0 != atoi(argv[5]));
+
     std::unique_ptr<comm::P2P_Endpoint> pEndpoint = comm::IP_Endpoint::createUdpPeer(
-        static_cast<uint16_t>(atoi(argv[1])), std::string(argv[2]), static_cast<uint16_t>(atoi(argv[3])));
+        static_cast<uint16_t>(atoi(argv[1])), std::string(argv[2]), static_cast<uint16_t>(atoi(argv[3])), config);
 
     if (!pEndpoint) {
         LOGE("Could not create an Udp Peer which listens at port %s!!!\n", argv[1]);
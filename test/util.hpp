@@ -27,7 +27,7 @@ inline bool ncompare(
 }
 
 inline bool ncompare(
-    const std::unique_ptr<uint8_t[]>& arr0,
+    const uint8_t* const& arr0,
     const uint8_t* const& arr1,
     const size_t& size) {
     for (size_t i = 0; i < size; i++) {
@@ -39,6 +39,20 @@ inline bool ncompare(
     return true;
 }
 
+inline bool ncompare(
+    const std::unique_ptr<uint8_t[]>& arr0,
+    const uint8_t* const& arr1,
+    const size_t& size) {
+    return ncompare(arr0.get(), arr1, size);
+}
+
+inline bool ncompare(
+    const uint8_t* const& arr0,
+    const std::unique_ptr<uint8_t[]>& arr1,
+    const size_t& size) {
+    return ncompare(arr0, arr1.get(), size);
+}
+
 inline bool test(const std::deque<std::unique_ptr<comm::Packet>>& pRxPackets) {
     const size_t EXPECTED_NUMBER_OF_PACKETS = vectors.size();
     const size_t NUMBER_OF_RX_PACKETS = pRxPackets.size();
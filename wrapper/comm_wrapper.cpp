@@ -2,6 +2,7 @@
 
 #include "IP_Endpoint.hpp"
 #include "Packet.hpp"
+#include "PacketPool.hpp"
 #include "TcpServer.hpp"
 
 #include <cinttypes>
@@ -109,6 +110,64 @@ bool comm_p2p_endpoint_send(const uint8_t* const p_buffer, const size_t& buffer_
     return p_endpoint->send(comm::Packet::create(p_buffer, buffer_size));
 }
 
+/**
+ * @brief Take over a buffer from `comm_p2p_endpoint_alloc_buffer()` & reset it.
+ * The block is returned to the pool with the size it was allocated with, whatever the size of the payload.
+ */
+static comm::PooledBuffer adopt_buffer(comm_buffer& buffer) {
+    comm::PooledBuffer p_payload;
+    if ((nullptr != buffer.p_data) && ((0 == buffer.capacity) || (comm::MAX_PAYLOAD_SIZE < buffer.capacity))) {
+        // Its size class is unknown: leaked rather than corrupting the pool
+        LOGE("Invalid buffer capacity: %zu!!!\n", buffer.capacity);
+    } else if (nullptr != buffer.p_data) {
+        p_payload = comm::PooledBuffer(buffer.p_data, comm::PoolDeleter(buffer.capacity));
+    }
+
+    buffer.p_data = nullptr;
+    buffer.capacity = 0;
+
+    return p_payload;
+}
+
+bool comm_p2p_endpoint_alloc_buffer(const size_t& capacity, comm_buffer& buffer) {
+    buffer.p_data = nullptr;
+    buffer.capacity = 0;
+
+    if ((0 == capacity) || (comm::MAX_PAYLOAD_SIZE < capacity)) {
+        LOGE("Invalid buffer capacity: %zu!!!\n", capacity);
+        return false;
+    }
+
+    buffer.p_data = comm::PacketPool::allocateBuffer(capacity).release();
+    buffer.capacity = capacity;
+
+    return true;
+}
+
+bool comm_p2p_endpoint_send_buffer(comm_buffer& buffer, const size_t& payload_size) {
+    comm::PooledBuffer p_payload = adopt_buffer(buffer);
+    if (!p_payload) {
+        return false;
+    }
+
+    if ((0 == payload_size) || (p_payload.get_deleter().getSize() < payload_size)) {
+        LOGE("Invalid payload size: %zu (capacity: %zu)!!!\n", payload_size, p_payload.get_deleter().getSize());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(endpoint_mutex);
+    if (nullptr == p_endpoint) {
+        LOGE("Endpoint has not been initialized!!!\n");
+        return false;
+    }
+
+    return p_endpoint->send(comm::Packet::create(std::move(p_payload), payload_size));
+}
+
+void comm_p2p_endpoint_free_buffer(comm_buffer& buffer) {
+    adopt_buffer(buffer);
+}
+
 size_t comm_p2p_endpoint_recv_packet(uint8_t* const p_buffer, const size_t& buffer_size, int64_t& timestamp_us) {
     std::lock_guard<std::mutex> lock(rx_queue_mutex);
     if (p_rx_packets.empty()) {
@@ -123,7 +182,7 @@ size_t comm_p2p_endpoint_recv_packet(uint8_t* const p_buffer, const size_t& buff
         if (buffer_size < rx_count) {
             LOGE("Buffer size (%zu) is too small (expected: %zu)!!!\n", buffer_size, rx_count);
         } else {
-            memcpy(p_buffer, p_rx_packets.front()->getPayload().get(), rx_count);
+            memcpy(p_buffer, p_rx_packets.front()->getPayload(), rx_count);
             timestamp_us = p_rx_packets.front()->getTimestampUs();
             p_rx_packets.pop_front();
             return rx_count;
@@ -167,7 +226,7 @@ size_t comm_p2p_endpoint_recv_packets(
         p_packet = std::move(p_rx_packets.front());
         p_rx_packets.pop_front();
 
-        memcpy((buffer + buffer_index), p_packet->getPayload().get(), packet_size);
+        memcpy((buffer + buffer_index), p_packet->getPayload(), packet_size);
         p_timestamps[packet_index] = p_packet->getTimestampUs();
         LOGD("Packet %zu (%zu bytes) at %" PRId64 " (us) -> Buffer index: %zu.\n",
              packet_index, packet_size, p_packet->getTimestampUs(), buffer_index);
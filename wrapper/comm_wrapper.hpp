@@ -17,6 +17,18 @@ bool comm_tcp_server_wait_for_client(int& error_code, const long timeout_ms);
 bool comm_endpoint_ready();
 
 bool comm_p2p_endpoint_send(const uint8_t* const p_buffer, const size_t& buffer_size);
+
+// Zero-copy Tx: fill a buffer from `comm_p2p_endpoint_alloc_buffer()` (up to its capacity), then hand it over to
+// `comm_p2p_endpoint_send_buffer()` (which always takes the ownership, with the number of bytes to send) or give it back
+// with `comm_p2p_endpoint_free_buffer()`. Both reset the buffer. `p_data` & `capacity` must not be modified by the caller.
+struct comm_buffer {
+    uint8_t* p_data;
+    size_t capacity;  // Allocated size
+};
+
+bool comm_p2p_endpoint_alloc_buffer(const size_t& capacity, comm_buffer& buffer);
+bool comm_p2p_endpoint_send_buffer(comm_buffer& buffer, const size_t& payload_size);
+void comm_p2p_endpoint_free_buffer(comm_buffer& buffer);
 size_t comm_p2p_endpoint_recv_packet(uint8_t* const p_buffer, const size_t& buffer_size, int64_t& timestamp_us);
 size_t comm_p2p_endpoint_recv_packets(
     uint8_t* const p_buffer, const size_t& buffer_size,
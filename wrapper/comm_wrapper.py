@@ -116,6 +116,56 @@ def comm_p2p_endpoint_send(buffer):
     else:
         return wrapper.comm_p2p_endpoint_send(bytes(buffer), ctypes.byref(cbuffer_size))
 
+# struct comm_buffer { uint8_t * p_data; size_t capacity; };
+class CommBuffer(ctypes.Structure):
+    _fields_ = [('p_data', ctypes.POINTER(ctypes.c_uint8)), ('capacity', ctypes.c_size_t)]
+
+# bool comm_p2p_endpoint_alloc_buffer(const size_t& capacity, comm_buffer& buffer);
+def comm_p2p_endpoint_alloc_buffer(capacity):
+    global wrapper
+    if (not wrapper):
+        print('Shared library must be loaded in advance!')
+        return None
+
+    if (not capacity) or (type(capacity) is not int) or (0 >= capacity):
+        print('1st argument, Buffer Capacity, must be a positive integer!')
+        return None
+
+    wrapper.comm_p2p_endpoint_alloc_buffer.restype = ctypes.c_bool
+    ccapacity = ctypes.c_size_t(capacity)
+    buffer = CommBuffer()
+    if (not wrapper.comm_p2p_endpoint_alloc_buffer(ctypes.byref(ccapacity), ctypes.byref(buffer))):
+        return None
+
+    return buffer
+
+# bool comm_p2p_endpoint_send_buffer(comm_buffer& buffer, const size_t& payload_size);
+def comm_p2p_endpoint_send_buffer(buffer, payload_size):
+    global wrapper
+    if (not wrapper):
+        print('Shared library must be loaded in advance!')
+        return False
+
+    if (type(buffer) is not CommBuffer):
+        print('1st argument, Tx Buffer, must be an instance of `CommBuffer`!')
+        return False
+
+    if (not payload_size) or (type(payload_size) is not int) or (0 >= payload_size):
+        print('2nd argument, Payload Size, must be a positive integer!')
+        return False
+
+    wrapper.comm_p2p_endpoint_send_buffer.restype = ctypes.c_bool
+    cpayload_size = ctypes.c_size_t(payload_size)
+    return wrapper.comm_p2p_endpoint_send_buffer(ctypes.byref(buffer), ctypes.byref(cpayload_size))
+
+# void comm_p2p_endpoint_free_buffer(comm_buffer& buffer);
+def comm_p2p_endpoint_free_buffer(buffer):
+    global wrapper
+    if (not wrapper) or (type(buffer) is not CommBuffer):
+        return
+
+    wrapper.comm_p2p_endpoint_free_buffer(ctypes.byref(buffer))
+
 PACKET_KEY_DATA      = 'data'
 PACKET_KEY_TIMESTAMP = 'timestamp_us'
 C_RX_BUFFER_SIZE = ctypes.c_size_t(4096)